@@ -862,6 +862,10 @@ extern "C"
         SlangCompileRequest* request,
         ISlangBlob** outBlob);
 
+    /** Serialize reflection into the binary format described in `slang-reflection-binary.h`.
+     */
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob);
+
     SLANG_API unsigned spReflection_GetParameterCount(SlangReflection* reflection);
     SLANG_API SlangReflectionParameter* spReflection_GetParameterByIndex(
         SlangReflection* reflection,
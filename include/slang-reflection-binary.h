@@ -0,0 +1,290 @@
+#ifndef SLANG_REFLECTION_BINARY_H
+#define SLANG_REFLECTION_BINARY_H
+
+#include "slang.h"
+
+#include <stdint.h>
+#include <string.h>
+
+namespace slang
+{
+
+/*! \brief A compact binary serialization of program reflection.
+
+\details Produced by `ShaderReflection::toBinary` or `slangc -reflection-binary <path>`.
+
+The layout is designed to be memory mapped and queried in place. Every table is a flat array of
+fixed size records made of 32-bit fields, and every reference is a 32-bit offset from the start of
+the data (or an index into the type layout table). So reading it requires no parsing or
+allocation - `BinaryReflectionView` just validates the header and resolves offsets.
+
+Type layouts are shared: a type layout used by many parameters or fields is stored once, and
+referred to by its index in `BinaryReflectionProgram::typeLayouts`.
+
+The data must be at least 4 byte aligned. */
+
+/// Offset of a null terminated UTF-8 string within the string table. 0 is the empty string.
+typedef uint32_t BinaryReflectionString;
+
+/// A contiguous run of `count` records of type `T`, starting at `offset` from the start of the data
+template<typename T>
+struct BinaryReflectionArray
+{
+    uint32_t offset;
+    uint32_t count;
+};
+
+enum : uint32_t
+{
+    kBinaryReflectionMagic = 0x42524c53, ///< "SLRB" in little endian
+    kBinaryReflectionVersion = 1,
+
+    /// Used for an index or count that doesn't apply or is not known
+    kBinaryReflectionInvalidIndex = 0xffffffff,
+    /// Used for an unbounded count or size (SLANG_UNBOUNDED_SIZE)
+    kBinaryReflectionUnbounded = 0xffffffff,
+};
+
+/// The resources a variable is bound to for one parameter category
+struct BinaryReflectionBinding
+{
+    uint32_t category; ///< SlangParameterCategory
+    uint32_t space;
+    /// The byte offset for `SLANG_PARAMETER_CATEGORY_UNIFORM`, otherwise the register/binding index
+    uint32_t index;
+    /// The size in bytes for `SLANG_PARAMETER_CATEGORY_UNIFORM`, otherwise the number of
+    /// registers/bindings (may be kBinaryReflectionUnbounded)
+    uint32_t count;
+};
+
+struct BinaryReflectionVarLayout
+{
+    BinaryReflectionString name;
+    uint32_t typeLayoutIndex; ///< Index into the type layout table, or kBinaryReflectionInvalidIndex
+    BinaryReflectionString semanticName;
+    uint32_t semanticIndex;
+    uint32_t stage; ///< SlangStage
+    uint32_t imageFormat; ///< SlangImageFormat
+    BinaryReflectionArray<BinaryReflectionBinding> bindings;
+};
+
+struct BinaryReflectionBindingRange
+{
+    uint32_t bindingType; ///< slang::BindingType
+    uint32_t bindingCount; ///< May be kBinaryReflectionUnbounded
+    uint32_t leafTypeLayoutIndex;
+    uint32_t descriptorSetIndex;
+    uint32_t firstDescriptorRangeIndex;
+    uint32_t descriptorRangeCount;
+};
+
+struct BinaryReflectionDescriptorRange
+{
+    uint32_t indexOffset;
+    uint32_t descriptorCount; ///< May be kBinaryReflectionUnbounded
+    uint32_t bindingType; ///< slang::BindingType
+    uint32_t category; ///< SlangParameterCategory
+};
+
+struct BinaryReflectionDescriptorSet
+{
+    uint32_t spaceOffset;
+    BinaryReflectionArray<BinaryReflectionDescriptorRange> descriptorRanges;
+};
+
+/// The size of a type for one parameter category
+struct BinaryReflectionSize
+{
+    uint32_t category; ///< SlangParameterCategory
+    uint32_t size; ///< May be kBinaryReflectionUnbounded
+    uint32_t alignment;
+    uint32_t stride;
+};
+
+struct BinaryReflectionTypeLayout
+{
+    uint32_t kind; ///< slang::TypeReflection::Kind
+    BinaryReflectionString name;
+    uint32_t scalarType; ///< slang::TypeReflection::ScalarType
+    /// Element count for arrays and vectors (may be kBinaryReflectionUnbounded)
+    uint32_t elementCount;
+    uint32_t rowCount;
+    uint32_t columnCount;
+    uint32_t resourceShape; ///< SlangResourceShape
+    uint32_t resourceAccess; ///< SlangResourceAccess
+    /// The element type of arrays, parameter groups and structured buffers, otherwise
+    /// kBinaryReflectionInvalidIndex
+    uint32_t elementTypeLayoutIndex;
+    BinaryReflectionArray<BinaryReflectionSize> sizes;
+    BinaryReflectionArray<BinaryReflectionVarLayout> fields;
+    BinaryReflectionArray<BinaryReflectionBindingRange> bindingRanges;
+    BinaryReflectionArray<BinaryReflectionDescriptorSet> descriptorSets;
+};
+
+struct BinaryReflectionEntryPoint
+{
+    BinaryReflectionString name;
+    BinaryReflectionString nameOverride;
+    uint32_t stage; ///< SlangStage
+    uint32_t threadGroupSize[3];
+    BinaryReflectionArray<BinaryReflectionVarLayout> parameters;
+    /// The layout of the result. `typeLayoutIndex` is kBinaryReflectionInvalidIndex if there is none
+    BinaryReflectionVarLayout result;
+};
+
+struct BinaryReflectionProgram
+{
+    BinaryReflectionArray<BinaryReflectionVarLayout> parameters;
+    BinaryReflectionArray<BinaryReflectionEntryPoint> entryPoints;
+    BinaryReflectionArray<BinaryReflectionTypeLayout> typeLayouts;
+    uint32_t globalConstantBufferBinding;
+    uint32_t globalConstantBufferSize;
+};
+
+/// Always at the start of the data
+struct BinaryReflectionHeader
+{
+    uint32_t magic; ///< kBinaryReflectionMagic
+    uint32_t version; ///< kBinaryReflectionVersion
+    uint32_t dataSize; ///< The total size of the data, including this header
+    uint32_t stringTableOffset; ///< The string table always ends with a 0 byte
+    uint32_t stringTableSize;
+    BinaryReflectionProgram program;
+};
+
+/// A read-only view of binary reflection data, which is queried in place.
+class BinaryReflectionView
+{
+public:
+    /// Set up the view on `data`, which must remain valid for the lifetime of the view.
+    /// Only the header is checked. Accessors bounds check what they return.
+    SlangResult init(const void* data, size_t size)
+    {
+        m_data = nullptr;
+        m_size = 0;
+
+        if (!data || size < sizeof(BinaryReflectionHeader) || (uintptr_t(data) & 3) != 0)
+            return SLANG_E_INVALID_ARG;
+
+        const auto header = (const BinaryReflectionHeader*)data;
+        if (header->magic != kBinaryReflectionMagic)
+            return SLANG_FAIL;
+        if (header->version != kBinaryReflectionVersion)
+            return SLANG_E_NOT_IMPLEMENTED;
+        if (header->dataSize > size || header->stringTableSize == 0 ||
+            header->stringTableOffset > header->dataSize ||
+            header->stringTableSize > header->dataSize - header->stringTableOffset)
+            return SLANG_FAIL;
+
+        const auto bytes = (const uint8_t*)data;
+        if (bytes[header->stringTableOffset + header->stringTableSize - 1] != 0)
+            return SLANG_FAIL;
+
+        m_data = bytes;
+        m_size = header->dataSize;
+        return SLANG_OK;
+    }
+
+    bool isValid() const { return m_data != nullptr; }
+
+    const BinaryReflectionHeader& getHeader() const
+    {
+        return *(const BinaryReflectionHeader*)m_data;
+    }
+    const BinaryReflectionProgram& getProgram() const { return getHeader().program; }
+
+    /// Get a string. Returns an empty string for an out of range offset.
+    const char* getString(BinaryReflectionString str) const
+    {
+        const auto& header = getHeader();
+        if (str >= header.stringTableSize)
+            str = 0;
+        return (const char*)(m_data + header.stringTableOffset + str);
+    }
+
+    /// Get the records of `array`. Returns nullptr if empty or out of range.
+    template<typename T>
+    const T* getElements(const BinaryReflectionArray<T>& array) const
+    {
+        if (array.count == 0 || array.offset > m_size ||
+            array.count > (m_size - array.offset) / sizeof(T))
+            return nullptr;
+        return (const T*)(m_data + array.offset);
+    }
+
+    /// Get the number of records in `array`, which is 0 if it is out of range.
+    template<typename T>
+    uint32_t getCount(const BinaryReflectionArray<T>& array) const
+    {
+        return getElements(array) ? array.count : 0;
+    }
+
+    template<typename T>
+    const T* getElement(const BinaryReflectionArray<T>& array, uint32_t index) const
+    {
+        const T* elements = getElements(array);
+        return (elements && index < array.count) ? elements + index : nullptr;
+    }
+
+    /// Get a type layout by index. Returns nullptr for kBinaryReflectionInvalidIndex.
+    const BinaryReflectionTypeLayout* getTypeLayout(uint32_t index) const
+    {
+        return getElement(getProgram().typeLayouts, index);
+    }
+
+    /// Find a global parameter by name, or return nullptr
+    const BinaryReflectionVarLayout* findParameter(const char* name) const
+    {
+        return _findByName(getProgram().parameters, name);
+    }
+
+    /// Find an entry point by name, or return nullptr
+    const BinaryReflectionEntryPoint* findEntryPoint(const char* name) const
+    {
+        return _findByName(getProgram().entryPoints, name);
+    }
+
+    /// Find a field of a struct type layout by name, or return nullptr
+    const BinaryReflectionVarLayout* findField(
+        const BinaryReflectionTypeLayout* typeLayout,
+        const char* name) const
+    {
+        return typeLayout ? _findByName(typeLayout->fields, name) : nullptr;
+    }
+
+    /// Find the binding of `varLayout` for `category`, or return nullptr
+    const BinaryReflectionBinding* findBinding(
+        const BinaryReflectionVarLayout* varLayout,
+        SlangParameterCategory category) const
+    {
+        if (!varLayout)
+            return nullptr;
+        const auto bindings = getElements(varLayout->bindings);
+        for (uint32_t i = 0; bindings && i < varLayout->bindings.count; ++i)
+        {
+            if (bindings[i].category == uint32_t(category))
+                return bindings + i;
+        }
+        return nullptr;
+    }
+
+protected:
+    template<typename T>
+    const T* _findByName(const BinaryReflectionArray<T>& array, const char* name) const
+    {
+        const T* elements = getElements(array);
+        for (uint32_t i = 0; elements && i < array.count; ++i)
+        {
+            if (strcmp(getString(elements[i].name), name) == 0)
+                return elements + i;
+        }
+        return nullptr;
+    }
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace slang
+
+#endif
@@ -1021,6 +1021,21 @@ typedef uint32_t SlangSizeT;
 
         SkipDownstreamLinking, // bool, experimental
         DumpModule,
+
+        ReportPerfBenchmarkAllThreads,   // bool
+        EmitReflectionBinary,            // string
+        EmbedTargetIR,                   // bool
+        MinCutCheckpointPolicy,          // bool
+        CompactEmittedSource,            // bool
+        ReportEmittedSourceStats,        // bool
+        ReportIRInstCounts,              // bool
+        ReportPerfBenchmarkHotFunctions, // int
+        ReduceRegisterPressure,          // bool
+        ReportRegisterPressure,          // bool
+        VectorizeScalarOps,              // bool
+        HeuristicUnrollAndInline,        // bool
+        ProfileFeedbackFile,             // string
+        WorkingDirectory,                // string
         CountOf,
     };
 
@@ -3400,6 +3415,13 @@ struct ShaderReflection
     {
         return spReflection_ToJson((SlangReflection*)this, nullptr, outBlob);
     }
+
+    /// Serialize into the compact binary format described in `slang-reflection-binary.h`, which
+    /// can be queried in place with `slang::BinaryReflectionView`.
+    SlangResult toBinary(ISlangBlob** outBlob)
+    {
+        return spReflection_ToBinary((SlangReflection*)this, outBlob);
+    }
 };
 
 
@@ -7,6 +7,30 @@
 #include <intrin.h>
 #endif
 
+// Select the SIMD implementation used for common vector and matrix types (see
+// slang-cpp-types-simd.h). Intrinsic headers are included here, as they must be outside of any
+// namespace. Define SLANG_PRELUDE_DISABLE_SIMD to only use the generic implementations.
+#define SLANG_PRELUDE_SIMD_NONE 0
+#define SLANG_PRELUDE_SIMD_VECTOR_EXT 1
+#define SLANG_PRELUDE_SIMD_SSE 2
+#define SLANG_PRELUDE_SIMD_NEON 3
+
+#ifndef SLANG_PRELUDE_SIMD
+#if defined(SLANG_PRELUDE_DISABLE_SIMD)
+#define SLANG_PRELUDE_SIMD SLANG_PRELUDE_SIMD_NONE
+#elif defined(__GNUC__) || defined(__clang__)
+#define SLANG_PRELUDE_SIMD SLANG_PRELUDE_SIMD_VECTOR_EXT
+#elif defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SLANG_PRELUDE_SIMD SLANG_PRELUDE_SIMD_SSE
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm_neon.h>
+#define SLANG_PRELUDE_SIMD SLANG_PRELUDE_SIMD_NEON
+#else
+#define SLANG_PRELUDE_SIMD SLANG_PRELUDE_SIMD_NONE
+#endif
+#endif
+
 #ifndef SLANG_FORCE_INLINE
 #define SLANG_FORCE_INLINE inline
 #endif
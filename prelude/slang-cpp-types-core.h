@@ -608,7 +608,7 @@ struct Matrix
         Matrix<T, R, C> result;                                 \
         for (int i = 0; i < R; i++)                             \
             for (int j = 0; j < C; j++)                         \
-                result[i].rows[i][j] = op thisVal.rows[i][j];   \
+                result.rows[i][j] = op thisVal.rows[i][j];      \
         return result;                                          \
     }
 
@@ -703,6 +703,74 @@ SLANG_FLOAT_MATRIX_MOD(double)
 #undef SLANG_MATRIX_INT_NEG_OP
 #undef SLANG_FLOAT_MATRIX_MOD
 
+// Generic implementations of intrinsics, that have SIMD versions for some shapes in
+// slang-cpp-types-simd.h.
+
+template<typename T, int N>
+SLANG_FORCE_INLINE T _slang_dot(const Vector<T, N>& x, const Vector<T, N>& y)
+{
+    T result = T(0);
+    for (int i = 0; i < N; i++)
+        result += x[i] * y[i];
+    return result;
+}
+
+template<typename T>
+SLANG_FORCE_INLINE Vector<T, 3> _slang_cross(const Vector<T, 3>& left, const Vector<T, 3>& right)
+{
+    return Vector<T, 3>(
+        left.y * right.z - left.z * right.y,
+        left.z * right.x - left.x * right.z,
+        left.x * right.y - left.y * right.x);
+}
+
+template<typename T, int N, int M>
+SLANG_FORCE_INLINE Vector<T, M> _slang_mul(const Vector<T, N>& left, const Matrix<T, N, M>& right)
+{
+    Vector<T, M> result;
+    for (int j = 0; j < M; ++j)
+    {
+        T sum = T(0);
+        for (int i = 0; i < N; ++i)
+            sum += left[i] * right.rows[i][j];
+        result[j] = sum;
+    }
+    return result;
+}
+
+template<typename T, int N, int M>
+SLANG_FORCE_INLINE Vector<T, N> _slang_mul(const Matrix<T, N, M>& left, const Vector<T, M>& right)
+{
+    Vector<T, N> result;
+    for (int i = 0; i < N; ++i)
+    {
+        T sum = T(0);
+        for (int j = 0; j < M; ++j)
+            sum += left.rows[i][j] * right[j];
+        result[i] = sum;
+    }
+    return result;
+}
+
+template<typename T, int R, int N, int C>
+SLANG_FORCE_INLINE Matrix<T, R, C> _slang_mul(
+    const Matrix<T, R, N>& left,
+    const Matrix<T, N, C>& right)
+{
+    Matrix<T, R, C> result;
+    for (int r = 0; r < R; ++r)
+        for (int c = 0; c < C; ++c)
+        {
+            T sum = T(0);
+            for (int i = 0; i < N; ++i)
+                sum += left.rows[r][i] * right.rows[i][c];
+            result.rows[r][c] = sum;
+        }
+    return result;
+}
+
+#include "slang-cpp-types-simd.h"
+
 template<typename TResult, typename TInput>
 TResult slang_bit_cast(TInput val)
 {
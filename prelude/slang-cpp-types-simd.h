@@ -0,0 +1,433 @@
+#ifndef SLANG_PRELUDE_CPP_TYPES_SIMD_H
+#define SLANG_PRELUDE_CPP_TYPES_SIMD_H
+
+// SIMD implementations for the most commonly used Vector/Matrix shapes (float4, float3 cross,
+// int4, uint4 and float4x4). The implementation is selected at compile time by
+// SLANG_PRELUDE_SIMD (see slang-cpp-scalar-intrinsics.h):
+//
+// * SLANG_PRELUDE_SIMD_VECTOR_EXT - GCC/Clang (including slang-llvm) vector extensions. The
+//   compiler lowers these to SSE, AVX or NEON depending on what is enabled for the target.
+// * SLANG_PRELUDE_SIMD_SSE - SSE2 intrinsics, for Visual Studio on x86/x64.
+// * SLANG_PRELUDE_SIMD_NEON - NEON intrinsics, for Visual Studio on ARM64.
+//
+// If SLANG_PRELUDE_SIMD is SLANG_PRELUDE_SIMD_NONE only the generic implementations are used.
+//
+// The SIMD versions perform the same floating point operations in the same order as the generic
+// versions, so results are identical.
+//
+// NOTE! Vector<T, N> has the alignment of T, so all loads and stores are unaligned.
+
+#if SLANG_PRELUDE_SIMD != SLANG_PRELUDE_SIMD_NONE
+
+#if SLANG_PRELUDE_SIMD == SLANG_PRELUDE_SIMD_VECTOR_EXT
+
+typedef float SlangSimdF4 __attribute__((vector_size(16)));
+typedef uint32_t SlangSimdU4 __attribute__((vector_size(16)));
+
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_load(const Vector<float, 4>& v)
+{
+    SlangSimdF4 r;
+    __builtin_memcpy(&r, &v, sizeof(r));
+    return r;
+}
+SLANG_FORCE_INLINE Vector<float, 4> _slang_simd_store(SlangSimdF4 v)
+{
+    Vector<float, 4> r;
+    __builtin_memcpy(&r, &v, sizeof(r));
+    return r;
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_set(float x, float y, float z, float w)
+{
+    SlangSimdF4 r = {x, y, z, w};
+    return r;
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_splat(float f)
+{
+    SlangSimdF4 r = {f, f, f, f};
+    return r;
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_add(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return a + b;
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_sub(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return a - b;
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_mul(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return a * b;
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_div(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return a / b;
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_neg(SlangSimdF4 a)
+{
+    return -a;
+}
+
+template<typename T>
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_load(const Vector<T, 4>& v)
+{
+    SlangSimdU4 r;
+    __builtin_memcpy(&r, &v, sizeof(r));
+    return r;
+}
+template<typename T>
+SLANG_FORCE_INLINE Vector<T, 4> _slang_simd_store(SlangSimdU4 v)
+{
+    Vector<T, 4> r;
+    __builtin_memcpy(&r, &v, sizeof(r));
+    return r;
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_add(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return a + b;
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_sub(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return a - b;
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_mul(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return a * b;
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_and(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return a & b;
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_or(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return a | b;
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_xor(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return a ^ b;
+}
+
+#define SLANG_PRELUDE_SIMD_HAS_U4_MUL 1
+
+#elif SLANG_PRELUDE_SIMD == SLANG_PRELUDE_SIMD_SSE
+
+typedef __m128 SlangSimdF4;
+typedef __m128i SlangSimdU4;
+
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_load(const Vector<float, 4>& v)
+{
+    return _mm_loadu_ps(&v.x);
+}
+SLANG_FORCE_INLINE Vector<float, 4> _slang_simd_store(SlangSimdF4 v)
+{
+    Vector<float, 4> r;
+    _mm_storeu_ps(&r.x, v);
+    return r;
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_set(float x, float y, float z, float w)
+{
+    return _mm_setr_ps(x, y, z, w);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_splat(float f)
+{
+    return _mm_set1_ps(f);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_add(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return _mm_add_ps(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_sub(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_mul(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_div(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return _mm_div_ps(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_neg(SlangSimdF4 a)
+{
+    // Flip the sign bit, so -0 is produced for 0 as with scalar negation
+    return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+}
+
+template<typename T>
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_load(const Vector<T, 4>& v)
+{
+    return _mm_loadu_si128((const __m128i*)&v);
+}
+template<typename T>
+SLANG_FORCE_INLINE Vector<T, 4> _slang_simd_store(SlangSimdU4 v)
+{
+    Vector<T, 4> r;
+    _mm_storeu_si128((__m128i*)&r, v);
+    return r;
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_add(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return _mm_add_epi32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_sub(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return _mm_sub_epi32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_and(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return _mm_and_si128(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_or(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return _mm_or_si128(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_xor(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return _mm_xor_si128(a, b);
+}
+
+// A 32 bit lane multiply requires SSE4.1, so isn't available with SSE2.
+#define SLANG_PRELUDE_SIMD_HAS_U4_MUL 0
+
+#elif SLANG_PRELUDE_SIMD == SLANG_PRELUDE_SIMD_NEON
+
+typedef float32x4_t SlangSimdF4;
+typedef uint32x4_t SlangSimdU4;
+
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_load(const Vector<float, 4>& v)
+{
+    return vld1q_f32(&v.x);
+}
+SLANG_FORCE_INLINE Vector<float, 4> _slang_simd_store(SlangSimdF4 v)
+{
+    Vector<float, 4> r;
+    vst1q_f32(&r.x, v);
+    return r;
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_set(float x, float y, float z, float w)
+{
+    const float values[4] = {x, y, z, w};
+    return vld1q_f32(values);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_splat(float f)
+{
+    return vdupq_n_f32(f);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_add(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return vaddq_f32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_sub(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return vsubq_f32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_mul(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return vmulq_f32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_div(SlangSimdF4 a, SlangSimdF4 b)
+{
+    return vdivq_f32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_neg(SlangSimdF4 a)
+{
+    return vnegq_f32(a);
+}
+
+template<typename T>
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_load(const Vector<T, 4>& v)
+{
+    return vld1q_u32((const uint32_t*)&v);
+}
+template<typename T>
+SLANG_FORCE_INLINE Vector<T, 4> _slang_simd_store(SlangSimdU4 v)
+{
+    Vector<T, 4> r;
+    vst1q_u32((uint32_t*)&r, v);
+    return r;
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_add(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return vaddq_u32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_sub(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return vsubq_u32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_mul(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return vmulq_u32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_and(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return vandq_u32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_or(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return vorrq_u32(a, b);
+}
+SLANG_FORCE_INLINE SlangSimdU4 _slang_simd_xor(SlangSimdU4 a, SlangSimdU4 b)
+{
+    return veorq_u32(a, b);
+}
+
+#define SLANG_PRELUDE_SIMD_HAS_U4_MUL 1
+
+#endif
+
+// float4
+
+#define SLANG_SIMD_FLOAT4_BINARY_OP(op, func)                                               \
+    SLANG_FORCE_INLINE Vector<float, 4> operator op(                                        \
+        const Vector<float, 4>& thisVal,                                                    \
+        const Vector<float, 4>& other)                                                      \
+    {                                                                                       \
+        return _slang_simd_store(func(_slang_simd_load(thisVal), _slang_simd_load(other))); \
+    }
+
+SLANG_SIMD_FLOAT4_BINARY_OP(+, _slang_simd_add)
+SLANG_SIMD_FLOAT4_BINARY_OP(-, _slang_simd_sub)
+SLANG_SIMD_FLOAT4_BINARY_OP(*, _slang_simd_mul)
+SLANG_SIMD_FLOAT4_BINARY_OP(/, _slang_simd_div)
+#undef SLANG_SIMD_FLOAT4_BINARY_OP
+
+SLANG_FORCE_INLINE Vector<float, 4> operator-(const Vector<float, 4>& thisVal)
+{
+    return _slang_simd_store(_slang_simd_neg(_slang_simd_load(thisVal)));
+}
+
+SLANG_FORCE_INLINE float _slang_dot(const Vector<float, 4>& x, const Vector<float, 4>& y)
+{
+    const Vector<float, 4> p =
+        _slang_simd_store(_slang_simd_mul(_slang_simd_load(x), _slang_simd_load(y)));
+    // Sum in the same order as the generic version
+    float result = 0.0f;
+    result += p.x;
+    result += p.y;
+    result += p.z;
+    result += p.w;
+    return result;
+}
+
+// float3
+
+SLANG_FORCE_INLINE Vector<float, 3> _slang_cross(
+    const Vector<float, 3>& left,
+    const Vector<float, 3>& right)
+{
+    const SlangSimdF4 a = _slang_simd_mul(
+        _slang_simd_set(left.y, left.z, left.x, 0.0f),
+        _slang_simd_set(right.z, right.x, right.y, 0.0f));
+    const SlangSimdF4 b = _slang_simd_mul(
+        _slang_simd_set(left.z, left.x, left.y, 0.0f),
+        _slang_simd_set(right.y, right.z, right.x, 0.0f));
+    const Vector<float, 4> r = _slang_simd_store(_slang_simd_sub(a, b));
+    return Vector<float, 3>(r.x, r.y, r.z);
+}
+
+// int4 and uint4
+//
+// Lanes are treated as unsigned, as the results of these operations are bitwise identical for
+// signed and unsigned integers (and wrap, rather than being undefined, on overflow).
+
+#define SLANG_SIMD_INT4_BINARY_OP(T, op, func)                                                 \
+    SLANG_FORCE_INLINE Vector<T, 4> operator op(                                               \
+        const Vector<T, 4>& thisVal,                                                           \
+        const Vector<T, 4>& other)                                                             \
+    {                                                                                          \
+        return _slang_simd_store<T>(func(_slang_simd_load(thisVal), _slang_simd_load(other))); \
+    }
+
+#if SLANG_PRELUDE_SIMD_HAS_U4_MUL
+#define SLANG_SIMD_INT4_MUL_OP(T) SLANG_SIMD_INT4_BINARY_OP(T, *, _slang_simd_mul)
+#else
+#define SLANG_SIMD_INT4_MUL_OP(T)
+#endif
+
+#define SLANG_SIMD_INT4_OPS(T)                       \
+    SLANG_SIMD_INT4_BINARY_OP(T, +, _slang_simd_add) \
+    SLANG_SIMD_INT4_BINARY_OP(T, -, _slang_simd_sub) \
+    SLANG_SIMD_INT4_BINARY_OP(T, &, _slang_simd_and) \
+    SLANG_SIMD_INT4_BINARY_OP(T, |, _slang_simd_or)  \
+    SLANG_SIMD_INT4_BINARY_OP(T, ^, _slang_simd_xor) \
+    SLANG_SIMD_INT4_MUL_OP(T)
+
+SLANG_SIMD_INT4_OPS(int32_t)
+SLANG_SIMD_INT4_OPS(uint32_t)
+#undef SLANG_SIMD_INT4_OPS
+#undef SLANG_SIMD_INT4_MUL_OP
+#undef SLANG_SIMD_INT4_BINARY_OP
+
+// float4x4
+
+#define SLANG_SIMD_FLOAT4X4_BINARY_OP(op)                      \
+    SLANG_FORCE_INLINE Matrix<float, 4, 4> operator op(        \
+        const Matrix<float, 4, 4>& thisVal,                    \
+        const Matrix<float, 4, 4>& other)                      \
+    {                                                          \
+        Matrix<float, 4, 4> result;                            \
+        for (int i = 0; i < 4; i++)                            \
+            result.rows[i] = thisVal.rows[i] op other.rows[i]; \
+        return result;                                         \
+    }
+
+SLANG_SIMD_FLOAT4X4_BINARY_OP(+)
+SLANG_SIMD_FLOAT4X4_BINARY_OP(-)
+SLANG_SIMD_FLOAT4X4_BINARY_OP(*)
+SLANG_SIMD_FLOAT4X4_BINARY_OP(/)
+#undef SLANG_SIMD_FLOAT4X4_BINARY_OP
+
+SLANG_FORCE_INLINE Matrix<float, 4, 4> operator-(const Matrix<float, 4, 4>& thisVal)
+{
+    Matrix<float, 4, 4> result;
+    for (int i = 0; i < 4; i++)
+        result.rows[i] = -thisVal.rows[i];
+    return result;
+}
+
+// Returns the sum of the rows of right, each scaled by the matching element of left.
+// This is the row vector left multiplied by the matrix right.
+SLANG_FORCE_INLINE SlangSimdF4 _slang_simd_mul_row(
+    const Vector<float, 4>& left,
+    const Matrix<float, 4, 4>& right)
+{
+    SlangSimdF4 sum = _slang_simd_splat(0.0f);
+    for (int i = 0; i < 4; i++)
+    {
+        sum = _slang_simd_add(
+            sum,
+            _slang_simd_mul(_slang_simd_splat(left[i]), _slang_simd_load(right.rows[i])));
+    }
+    return sum;
+}
+
+SLANG_FORCE_INLINE Vector<float, 4> _slang_mul(
+    const Vector<float, 4>& left,
+    const Matrix<float, 4, 4>& right)
+{
+    return _slang_simd_store(_slang_simd_mul_row(left, right));
+}
+
+SLANG_FORCE_INLINE Vector<float, 4> _slang_mul(
+    const Matrix<float, 4, 4>& left,
+    const Vector<float, 4>& right)
+{
+    Vector<float, 4> result;
+    for (int i = 0; i < 4; i++)
+        result[i] = _slang_dot(left.rows[i], right);
+    return result;
+}
+
+SLANG_FORCE_INLINE Matrix<float, 4, 4> _slang_mul(
+    const Matrix<float, 4, 4>& left,
+    const Matrix<float, 4, 4>& right)
+{
+    Matrix<float, 4, 4> result;
+    for (int r = 0; r < 4; r++)
+        result.rows[r] = _slang_simd_store(_slang_simd_mul_row(left.rows[r], right));
+    return result;
+}
+
+#endif // SLANG_PRELUDE_SIMD != SLANG_PRELUDE_SIMD_NONE
+
+#endif
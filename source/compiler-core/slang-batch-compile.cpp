@@ -0,0 +1,274 @@
+// slang-batch-compile.cpp
+#include "slang-batch-compile.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-rtti-info.h"
+#include "../core/slang-std-writers.h"
+#include "../core/slang-writer.h"
+#include "slang-json-lexer.h"
+#include "slang-json-native.h"
+#include "slang-json-parser.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+struct BatchJobDesc
+{
+    List<String> args; ///< The command line, not including the executable
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct BatchManifest
+{
+    List<BatchJobDesc> jobs;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBatchJobDescRtti()
+{
+    BatchJobDesc obj;
+    StructRttiBuilder builder(&obj, "BatchJobDesc", nullptr);
+    builder.addField("args", &obj.args);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BatchJobDesc::g_rttiInfo = _makeBatchJobDescRtti();
+
+static const StructRttiInfo _makeBatchManifestRtti()
+{
+    BatchManifest obj;
+    StructRttiBuilder builder(&obj, "BatchManifest", nullptr);
+    builder.addField("jobs", &obj.jobs);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BatchManifest::g_rttiInfo = _makeBatchManifestRtti();
+
+struct BatchJob
+{
+    List<const char*> args; ///< Including the executable, as passed to the InnerMainFunc
+
+    StringBuilder stdOut;
+    StringBuilder stdError;
+    SlangResult result = SLANG_OK;
+    bool isProfiling = false; ///< If set, no other job may run at the same time
+    bool isDone = false;      ///< Guarded by BatchRunner::m_mutex
+};
+
+struct BatchRunner
+{
+    void runWorker();
+
+    BatchCompile::CreateSessionFunc m_createSession = nullptr;
+    BatchCompile::InnerMainFunc m_func = nullptr;
+
+    List<BatchJob> m_jobs;
+    std::atomic<Index> m_nextJobIndex{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobDone;
+
+    /// Held exclusively whilst running a profiling job, and shared whilst running any other
+    std::shared_mutex m_profilingMutex;
+};
+
+} // namespace
+
+static SlangResult _readManifest(
+    const String& path,
+    StdWriters* stdWriters,
+    BatchManifest& outManifest)
+{
+    WriterHelper stdError(stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
+
+    String contents;
+    if (SLANG_FAILED(File::readAllText(path, contents)))
+    {
+        stdError.print("error: unable to read batch manifest '%s'\n", path.getBuffer());
+        return SLANG_E_NOT_FOUND;
+    }
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, &JSONLexer::calcLexemeLocation);
+    sink.writer = stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR);
+
+    RefPtr<JSONContainer> container = new JSONContainer(&sourceManager);
+
+    SourceFile* sourceFile =
+        sourceManager.createSourceFileWithString(PathInfo::makePath(path), contents);
+    SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+    JSONLexer lexer;
+    lexer.init(sourceView, &sink);
+
+    JSONBuilder builder(container);
+
+    JSONParser parser;
+    SLANG_RETURN_ON_FAIL(parser.parse(&lexer, sourceView, &builder, &sink));
+
+    auto typeMap = JSONNativeUtil::getTypeFuncsMap();
+    JSONToNativeConverter converter(container, &typeMap, &sink);
+    if (SLANG_FAILED(converter.convert(builder.getRootValue(), &outManifest)))
+    {
+        stdError.print("error: invalid batch manifest '%s'\n", path.getBuffer());
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+void BatchRunner::runWorker()
+{
+    // Only created once this worker has a job to do
+    ComPtr<slang::IGlobalSession> session;
+    SlangResult sessionResult = SLANG_OK;
+
+    const Index jobCount = m_jobs.getCount();
+    for (;;)
+    {
+        const Index jobIndex = m_nextJobIndex.fetch_add(1);
+        if (jobIndex >= jobCount)
+        {
+            break;
+        }
+
+        auto& job = m_jobs[jobIndex];
+
+        if (!session && SLANG_SUCCEEDED(sessionResult))
+        {
+            sessionResult = m_createSession(session);
+        }
+
+        if (session)
+        {
+            // Make writer/s act as if they are the console.
+            RefPtr<StringWriter> stdOutWriter(new StringWriter(&job.stdOut, WriterFlag::IsConsole));
+            RefPtr<StringWriter> stdErrorWriter(
+                new StringWriter(&job.stdError, WriterFlag::IsConsole));
+
+            StdWriters stdWriters;
+            stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+            stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+            stdWriters.setWriter(SLANG_WRITER_CHANNEL_DIAGNOSTIC, stdErrorWriter);
+
+            if (job.isProfiling)
+            {
+                std::unique_lock<std::shared_mutex> lock(m_profilingMutex);
+                job.result =
+                    m_func(&stdWriters, session, int(job.args.getCount()), job.args.begin());
+            }
+            else
+            {
+                std::shared_lock<std::shared_mutex> lock(m_profilingMutex);
+                job.result =
+                    m_func(&stdWriters, session, int(job.args.getCount()), job.args.begin());
+            }
+        }
+        else
+        {
+            job.stdError << "error: unable to create a global session\n";
+            job.result = sessionResult;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            job.isDone = true;
+        }
+        m_jobDone.notify_all();
+    }
+}
+
+/* static */ bool BatchCompile::isProfilingOption(const UnownedStringSlice& arg)
+{
+    return arg.startsWith(toSlice("-report-perf-benchmark")) ||
+           arg == toSlice("-report-downstream-time");
+}
+
+/* static */ SlangResult BatchCompile::run(
+    const String& manifestPath,
+    Index threadCount,
+    CreateSessionFunc createSession,
+    InnerMainFunc func,
+    const char* exePath,
+    StdWriters* stdWriters)
+{
+    BatchManifest manifest;
+    SLANG_RETURN_ON_FAIL(_readManifest(manifestPath, stdWriters, manifest));
+
+    BatchRunner runner;
+    runner.m_createSession = createSession;
+    runner.m_func = func;
+
+    const Index jobCount = manifest.jobs.getCount();
+    runner.m_jobs.setCount(jobCount);
+    for (Index i = 0; i < jobCount; ++i)
+    {
+        auto& job = runner.m_jobs[i];
+        job.args.add(exePath);
+        for (const auto& arg : manifest.jobs[i].args)
+        {
+            job.args.add(arg.getBuffer());
+            job.isProfiling = job.isProfiling || isProfilingOption(arg.getUnownedSlice());
+        }
+    }
+
+    if (threadCount <= 0)
+    {
+        threadCount = Math::Max(Index(std::thread::hardware_concurrency()), Index(1));
+    }
+    threadCount = Math::Min(threadCount, jobCount);
+
+    List<std::thread> threads;
+    threads.setCount(threadCount);
+    for (auto& thread : threads)
+    {
+        thread = std::thread(&BatchRunner::runWorker, &runner);
+    }
+
+    // Output each job as soon as it and all the jobs before it are done
+    WriterHelper stdOut(stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT));
+    WriterHelper stdError(stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
+
+    SlangResult res = SLANG_OK;
+    for (auto& job : runner.m_jobs)
+    {
+        {
+            std::unique_lock<std::mutex> lock(runner.m_mutex);
+            runner.m_jobDone.wait(lock, [&]() { return job.isDone; });
+        }
+
+        if (job.stdError.getLength())
+        {
+            stdError.write(job.stdError.getBuffer(), job.stdError.getLength());
+            stdError.flush();
+        }
+        if (job.stdOut.getLength())
+        {
+            stdOut.write(job.stdOut.getBuffer(), job.stdOut.getLength());
+            stdOut.flush();
+        }
+
+        if (SLANG_FAILED(job.result) && SLANG_SUCCEEDED(res))
+        {
+            res = job.result;
+        }
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return res;
+}
+
+} // namespace Slang
@@ -0,0 +1,60 @@
+// slang-batch-compile.h
+#ifndef SLANG_BATCH_COMPILE_H
+#define SLANG_BATCH_COMPILE_H
+
+#include "../core/slang-test-tool-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+namespace Slang
+{
+
+/* Runs many independent slangc compilations from a single invocation, spread over worker threads.
+
+The jobs are listed in a JSON manifest, each with the command line it would have been given
+(not including the executable), for example
+
+```
+{
+    "jobs": [
+        { "args": ["a.slang", "-target", "spirv", "-o", "a.spv"] },
+        { "args": ["b.slang", "-entry", "main", "-stage", "compute", "-o", "b.dxil"] }
+    ]
+}
+```
+
+A global session is not thread safe, so each worker creates its own and reuses it for every job
+it runs. Each job gets its own compile request (and so its own session/linkage).
+
+Output of each job is captured, and written to the output StdWriters in manifest order, so
+the output doesn't depend on the number of workers or how the jobs were scheduled.
+
+The compiler's profiling results are only meaningful if nothing else is compiling at the same
+time, so a job with a profiling option (`-report-perf-benchmark...` or `-report-downstream-time`)
+is only run whilst no other job is running. */
+struct BatchCompile
+{
+    typedef TestToolUtil::InnerMainFunc InnerMainFunc;
+    typedef SlangResult (*CreateSessionFunc)(ComPtr<slang::IGlobalSession>& outSession);
+
+    /// Run the jobs in the manifest at `manifestPath` on `threadCount` workers. If `threadCount`
+    /// is 0 the number of hardware threads is used.
+    /// `func` performs a compilation using a session made with `createSession`, and must only
+    /// write to the StdWriters it is passed. `exePath` is passed to it as argv[0].
+    /// The output of the jobs, and any errors reading the manifest, are written to `stdWriters`.
+    /// Returns the result of the first job (in manifest order) that failed, or SLANG_OK.
+    static SlangResult run(
+        const String& manifestPath,
+        Index threadCount,
+        CreateSessionFunc createSession,
+        InnerMainFunc func,
+        const char* exePath,
+        StdWriters* stdWriters);
+
+    /// True if `arg` is an option whose results are skewed by concurrent compilations
+    static bool isProfilingOption(const UnownedStringSlice& arg);
+};
+
+} // namespace Slang
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+#define SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+
+#include "../core/slang-rtti-info.h"
+#include "slang-json-value.h"
+
+/* The JSON-RPC protocol between `slangc` and a resident `slangc -daemon` process.
+
+The client forwards its command line and working directory with a `compile` call, and the daemon
+replies with a CompileResult holding everything the compilation wrote to stdout and stderr, as well
+as the code slangc would have returned. */
+namespace CompileServerProtocol
+{
+
+using namespace Slang;
+
+struct CompileArgs
+{
+    String workingDirectory; ///< The working directory of the client
+    List<String> args;       ///< The command line arguments, not including the executable
+
+    static const UnownedStringSlice g_methodName;
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct CompileResult
+{
+    String stdOut;
+    String stdError;
+    int32_t result = SLANG_OK;
+    int32_t returnCode = 0; ///< As returned if invoked as command line
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+/// Makes the daemon exit
+struct QuitArgs
+{
+    static const UnownedStringSlice g_methodName;
+};
+
+} // namespace CompileServerProtocol
+
+#endif // SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
@@ -294,19 +294,22 @@ SlangResult JSONRPCConnection::tryReadMessage()
     auto content = m_connection->getContent();
     UnownedStringSlice slice((const char*)content.begin(), content.getCount());
 
+    const SlangResult res = readMessage(slice);
+
+    // Consume that content/packet
+    m_connection->consumeContent();
+    return res;
+}
+
+SlangResult JSONRPCConnection::readMessage(const UnownedStringSlice& content)
+{
     clearBuffers();
 
+    if (SLANG_FAILED(JSONRPCUtil::parseJSON(content, &m_container, &m_diagnosticSink, m_jsonRoot)))
     {
-        const SlangResult res =
-            JSONRPCUtil::parseJSON(slice, &m_container, &m_diagnosticSink, m_jsonRoot);
-
-        // Consume that content/packet
-        m_connection->consumeContent();
-        if (SLANG_FAILED(res))
-        {
-            // if we can't parse JSON, we return with id of 'null' as per the standard
-            return sendError(JSONRPC::ErrorCode::ParseError, JSONValue::makeNull());
-        }
+        m_jsonRoot.reset();
+        // if we can't parse JSON, we return with id of 'null' as per the standard
+        return sendError(JSONRPC::ErrorCode::ParseError, JSONValue::makeNull());
     }
 
     return SLANG_OK;
@@ -153,6 +153,10 @@ public:
     /// Try to read a message. Will return if message is not available.
     SlangResult tryReadMessage();
 
+    /// Parse content (the content of a packet) as the current message. For when packets are read
+    /// from the underlying connection elsewhere, such as on another thread.
+    SlangResult readMessage(const UnownedStringSlice& content);
+
     /// Will block for message/result up to time
     SlangResult waitForResult(Int timeOutInMs = -1);
 
@@ -6,6 +6,7 @@
 //
 
 #include "core/slang-char-encode.h"
+#include "core/slang-performance-profiler.h"
 #include "core/slang-string-escape-util.h"
 #include "slang-core-diagnostics.h"
 #include "slang-name.h"
@@ -1678,8 +1679,11 @@ static TokenType _lexTokenImpl(Lexer* lexer)
     }
 }
 
+SLANG_PROFILE_HOT_SITE(lexToken);
+
 Token Lexer::lexToken()
 {
+    SLANG_PROFILE_HOT(lexToken);
     for (;;)
     {
         Token token;
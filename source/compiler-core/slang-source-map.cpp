@@ -1,5 +1,7 @@
 #include "slang-source-map.h"
 
+#include "../core/slang-char-encode.h"
+
 namespace Slang
 {
 
@@ -250,4 +252,56 @@ Index SourceMap::findEntry(Index lineIndex, Index colIndex) const
     return m_lineStarts[lineIndex] + bestIndex;
 }
 
+void GeneratedLocationTracker::advance(const UnownedStringSlice& text)
+{
+    const char* cur = text.begin();
+    const char* end = text.end();
+    if (cur == end)
+        return;
+
+    // If the previous text ended part way through a CR/LF pair, the line break has already been
+    // counted, so skip the rest of it
+    if (m_pendingLineBreak && (m_pendingLineBreak ^ *cur) == ('\r' ^ '\n'))
+    {
+        cur++;
+    }
+    m_pendingLineBreak = 0;
+
+    const char* start = cur;
+    while (cur < end)
+    {
+        // Look for the end of the line
+        while (cur < end && *cur != '\n' && *cur != '\r')
+        {
+            cur++;
+        }
+
+        // If we are not at the total end then we must have hit a \n or \r
+        if (cur < end)
+        {
+            const auto c = *cur++;
+
+            // Next line
+            ++m_lineIndex;
+            m_columnIndex = 0;
+
+            // Check the next char to see if it's part of a CR/LF combination. If the text ends
+            // here, the other half may start the next text.
+            if (cur < end)
+            {
+                cur += ((c ^ *cur) == ('\r' ^ '\n'));
+            }
+            else
+            {
+                m_pendingLineBreak = c;
+            }
+
+            start = cur;
+        }
+    }
+
+    // Offset the column index in codepoints by the bytes on this line (which may not be complete)
+    m_columnIndex += UTF8Util::calcCodePointCount(UnownedStringSlice(start, end));
+}
+
 } // namespace Slang
@@ -136,6 +136,29 @@ SLANG_FORCE_INLINE ConstArrayView<SourceMap::Entry> SourceMap::getEntriesForLine
     return ConstArrayView<SourceMap::Entry>(entries + start, end - start);
 }
 
+/// Tracks the line and column at the end of generated text that is produced in pieces, such as
+/// the chunks a `SourceWriter` builds its output in. A CR/LF pair split between two pieces is
+/// counted as a single line break.
+class GeneratedLocationTracker
+{
+public:
+    /// Advance past `text`, which directly follows the text seen so far
+    void advance(const UnownedStringSlice& text);
+
+    /// Get the zero indexed line at the end of the text seen so far
+    Index getLineIndex() const { return m_lineIndex; }
+    /// Get the zero indexed column, in code points, at the end of the text seen so far
+    Index getColumnIndex() const { return m_columnIndex; }
+
+protected:
+    Index m_lineIndex = 0;
+    Index m_columnIndex = 0;
+
+    // If the text seen so far ends with a line break character, that character, as it might be
+    // the first half of a CR/LF pair. Otherwise 0.
+    char m_pendingLineBreak = 0;
+};
+
 } // namespace Slang
 
 #endif // SLANG_COMPILER_CORE_SOURCE_MAP_H
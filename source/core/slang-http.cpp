@@ -10,6 +10,61 @@ static const UnownedStringSlice g_headerEnd = UnownedStringSlice::fromLiteral("\
 static const UnownedStringSlice g_contentLength = UnownedStringSlice::fromLiteral("Content-Length");
 static const UnownedStringSlice g_contentType = UnownedStringSlice::fromLiteral("Content-Type");
 
+namespace
+{ // anonymous
+
+// Handles binary backoff like sleeping mechanism.
+struct SleepState
+{
+    /// Wait for the stream to have something to read. If the stream can't be waited on, sleeps,
+    /// backing off the longer nothing arrives.
+    SlangResult waitForReadable(Stream* stream, Int timeOutInMs)
+    {
+        const SlangResult res = stream->waitForReadable(timeOutInMs);
+        if (res == SLANG_E_NOT_IMPLEMENTED)
+        {
+            sleep();
+            return SLANG_OK;
+        }
+        // Timing out isn't an error, the caller decides what to do
+        return (res == SLANG_E_TIME_OUT) ? SLANG_OK : res;
+    }
+
+    void sleep()
+    {
+        Process::sleepCurrentThread(m_intervalInMs);
+        _update();
+    }
+    void reset()
+    {
+        m_intervalInMs = 0;
+        m_count = 0;
+    }
+    void _update()
+    {
+        const Int maxIntervalInMs = 32;
+        const Int initialCountThreshold = 4;
+
+        ++m_count;
+
+        const Int countThreshold = (m_intervalInMs == 0) ? initialCountThreshold : 1;
+
+        // If we hit the count change the interval
+        if (m_count >= countThreshold)
+        {
+            m_intervalInMs =
+                (m_intervalInMs == 0) ? 1 : Math::Min(m_intervalInMs * 2, maxIntervalInMs);
+            // Reset the count
+            m_count = 0;
+        }
+    }
+
+    Int m_intervalInMs = 0;
+    Int m_count = 0;
+};
+
+} // namespace
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! HTTPHeader !!!!!!!!!!!!!!!!!!!!!!! */
 
 void HTTPHeader::reset()
@@ -29,11 +84,16 @@ void HTTPHeader::reset()
 {
     // https://microsoft.github.io/language-server-protocol/specifications/specification-current/
 
+    SleepState sleepState;
+    Index searchStart = 0;
+
     while (true)
     {
+        const size_t prevCount = stream->getCount();
+
         SLANG_RETURN_ON_FAIL(stream->update());
 
-        const Index index = findHeaderEnd(stream);
+        const Index index = findHeaderEnd(stream, searchStart);
         if (index >= 0)
         {
             outEndIndex = index;
@@ -45,19 +105,37 @@ void HTTPHeader::reset()
             return SLANG_FAIL;
         }
 
-        Process::sleepCurrentThread(0);
+        if (stream->getCount() != prevCount)
+        {
+            sleepState.reset();
+        }
+        SLANG_RETURN_ON_FAIL(sleepState.waitForReadable(stream, -1));
     }
 }
 
-/* static */ Index HTTPHeader::findHeaderEnd(BufferedReadStream* stream)
+/* static */ Index HTTPHeader::findHeaderEnd(BufferedReadStream* stream, Index& ioSearchStart)
 {
-    // This could be more efficient - it just searches until there are enough bytes to have
-    // termination
     auto bytes = stream->getView();
     UnownedStringSlice input((const char*)bytes.begin(), (const char*)bytes.end());
 
-    const Index index = input.indexOf(g_headerEnd);
-    return (index >= 0) ? (index + g_headerEnd.getLength()) : index;
+    const Index start = Math::Min(ioSearchStart, input.getLength());
+    const Index index = input.tail(start).indexOf(g_headerEnd);
+    if (index >= 0)
+    {
+        ioSearchStart = 0;
+        return start + index + g_headerEnd.getLength();
+    }
+
+    // The termination may be split across the end of what has been read so far, so the next
+    // search has to start far enough back to find it.
+    ioSearchStart = Math::Max(Index(0), input.getLength() - (g_headerEnd.getLength() - 1));
+    return -1;
+}
+
+/* static */ Index HTTPHeader::findHeaderEnd(BufferedReadStream* stream)
+{
+    Index searchStart = 0;
+    return findHeaderEnd(stream, searchStart);
 }
 
 /* static */ SlangResult HTTPHeader::parse(const UnownedStringSlice& inSlice, HTTPHeader& out)
@@ -213,7 +291,7 @@ SlangResult HTTPPacketConnection::_handleHeader()
 {
     SLANG_ASSERT(m_readState == ReadState::Header);
 
-    const Index index = HTTPHeader::findHeaderEnd(m_readStream);
+    const Index index = HTTPHeader::findHeaderEnd(m_readStream, m_headerSearchStart);
     if (index < 0)
     {
         // Don't have the full header yet
@@ -298,57 +376,17 @@ SlangResult HTTPPacketConnection::update()
 }
 
 
-namespace
-{ // anonymous
-
-// Handles binary backoff like sleeping mechanism.
-struct SleepState
-{
-    void sleep()
-    {
-        Process::sleepCurrentThread(m_intervalInMs);
-        _update();
-    }
-    void reset()
-    {
-        m_intervalInMs = 0;
-        m_count = 0;
-    }
-    void _update()
-    {
-        const Int maxIntervalInMs = 32;
-        const Int initialCountThreshold = 4;
-
-        ++m_count;
-
-        const Int countThreshold = (m_intervalInMs == 0) ? initialCountThreshold : 1;
-
-        // If we hit the count change the interval
-        if (m_count >= countThreshold)
-        {
-            m_intervalInMs =
-                (m_intervalInMs == 0) ? 1 : Math::Min(m_intervalInMs * 2, maxIntervalInMs);
-            // Reset the count
-            m_count = 0;
-        }
-    }
-
-    Int m_intervalInMs = 0;
-    Int m_count = 0;
-};
-
-} // namespace
-
 SlangResult HTTPPacketConnection::waitForResult(Int timeOutInMs)
 {
     m_readResult = SLANG_OK;
 
     int64_t startTick = 0;
     int64_t timeOutInTicks = -1;
+    const int64_t ticksPerMs = Math::Max(int64_t(Process::getClockFrequency() / 1000), int64_t(1));
 
     if (timeOutInMs >= 0)
     {
-        timeOutInTicks = timeOutInMs * (Process::getClockFrequency() / 1000);
+        timeOutInTicks = timeOutInMs * ticksPerMs;
         startTick = Process::getClockTick();
     }
 
@@ -365,15 +403,24 @@ SlangResult HTTPPacketConnection::waitForResult(Int timeOutInMs)
             break;
         }
 
-        // We timed out
-        if (timeOutInTicks >= 0 && int64_t(Process::getClockTick()) - startTick >= timeOutInTicks)
+        Int remainingInMs = -1;
+        if (timeOutInTicks >= 0)
         {
-            break;
+            const int64_t remainingTicks =
+                timeOutInTicks - (int64_t(Process::getClockTick()) - startTick);
+            // We timed out
+            if (remainingTicks <= 0)
+            {
+                break;
+            }
+            remainingInMs = Int((remainingTicks + ticksPerMs - 1) / ticksPerMs);
         }
 
         if (prevCount == m_readStream->getCount())
         {
-            sleepState.sleep();
+            // Nothing new arrived, so block until there is something to read rather than spin
+            SLANG_RETURN_ON_FAIL(
+                _updateReadResult(sleepState.waitForReadable(m_readStream, remainingInMs)));
         }
         else
         {
@@ -45,6 +45,10 @@ struct HTTPHeader
     /// Returns the index of the end of the header (index of first byte *after* the header), or < if
     /// doesn't have an end
     static Index findHeaderEnd(BufferedReadStream* stream);
+    /// As above, but only searches from ioSearchStart. If the end isn't found ioSearchStart is
+    /// updated so a later search (after more has been read) doesn't rescan the same bytes. It is
+    /// reset to 0 when the end is found.
+    static Index findHeaderEnd(BufferedReadStream* stream, Index& ioSearchStart);
 
     /// Parse the slice (holding a header) into out.
     /// Will allocate the slice on the array and store in m_header.
@@ -85,7 +89,9 @@ Index HTTPHeader::indexOfKey(const UnownedStringSlice& slice) const
 /// become 'Done'. For this to work without blocking it relies on the stream backing the
 /// BufferedReadStream to be non blocking.
 ///
-/// If it is only necessary to respond on complete packets 'waitForContent' can be used.
+/// If it is only necessary to respond on complete packets 'waitForResult' can be used. It blocks
+/// in Stream::waitForReadable while no data is arriving, so an idle connection doesn't use CPU.
+/// Streams that can't be waited on fall back to sleeping with a backoff.
 /// If this returns and ReadState is Done, then getHeader holds the current header, and getContent
 /// holds the content of the 'packet'.
 ///
@@ -172,6 +178,8 @@ protected:
     HTTPHeader m_readHeader;
 
     ReadState m_readState;
+    /// Where to resume searching for the end of the header in the read stream
+    Index m_headerSearchStart = 0;
 
     RefPtr<BufferedReadStream> m_readStream;
     RefPtr<Stream> m_writeStream;
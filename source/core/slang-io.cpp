@@ -744,6 +744,13 @@ String Path::getCurrentPath()
     return path;
 }
 
+SlangResult Path::setCurrentPath(const String& path)
+{
+    std::error_code ec;
+    std::filesystem::current_path(std::filesystem::path(path.getBuffer()), ec);
+    return ec ? SLANG_FAIL : SLANG_OK;
+}
+
 String Path::getRelativePath(String base, String path)
 {
     std::filesystem::path p1(base.getBuffer());
@@ -228,6 +228,11 @@ public:
     /// @return The path in platform native format. Returns empty string if failed.
     static String getCurrentPath();
 
+    /// Sets the current working directory
+    /// @param path The directory to make current
+    /// @return SLANG_OK on success
+    static SlangResult setCurrentPath(const String& path);
+
     /// Returns the executable path
     /// @return The path in platform native format. Returns empty string if failed.
     static String getExecutablePath();
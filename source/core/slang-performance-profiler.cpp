@@ -1,81 +1,697 @@
 #include "slang-performance-profiler.h"
 
+#include "slang-byte-encode-util.h"
 #include "slang-dictionary.h"
 
+#include <atomic>
+#include <mutex>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
 namespace Slang
 {
+
+// The latency of each invocation is recorded in a log-linear histogram. Durations less than
+// `2 * kSubBucketCount` nanoseconds have a bucket each, after which each power of 2 range is split
+// into `kSubBucketCount` buckets. The bucket for a duration is therefore at most 25% wide.
+static const int kSubBucketBits = 2;
+static const uint64_t kSubBucketCount = uint64_t(1) << kSubBucketBits;
+static const Index kBucketCount = Index((64 - kSubBucketBits + 1) * kSubBucketCount);
+
+static int _calcMsb64(uint64_t v)
+{
+    const uint32_t hi = uint32_t(v >> 32);
+    return hi ? 32 + ByteEncodeUtil::calcMsb32(hi) : ByteEncodeUtil::calcMsb32(uint32_t(v));
+}
+
+static Index _getBucketIndex(uint64_t nanoseconds)
+{
+    if (nanoseconds < 2 * kSubBucketCount)
+        return Index(nanoseconds);
+
+    const int msb = _calcMsb64(nanoseconds);
+    const uint64_t subBucket = (nanoseconds >> (msb - kSubBucketBits)) & (kSubBucketCount - 1);
+    return Index((msb - kSubBucketBits + 1) * kSubBucketCount + subBucket);
+}
+
+/// Get the duration in the middle of the range covered by bucket `index`
+static uint64_t _getBucketMidpoint(Index index)
+{
+    if (uint64_t(index) < 2 * kSubBucketCount)
+        return uint64_t(index);
+
+    const int msb = int(uint64_t(index) / kSubBucketCount) + kSubBucketBits - 1;
+    const uint64_t subBucket = uint64_t(index) % kSubBucketCount;
+    const int shift = msb - kSubBucketBits;
+    const uint64_t lower = (kSubBucketCount + subBucket) << shift;
+    return lower + ((uint64_t(1) << shift) >> 1);
+}
+
+/// Read the CPU's timestamp counter. Where there isn't one that can be read cheaply, a monotonic
+/// clock in nanoseconds is read instead.
+static inline uint64_t _readTimestamp()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count());
+#endif
+}
+
+/// A timestamp and the time it was taken
+struct TimestampCalibration
+{
+    uint64_t timestamp = _readTimestamp();
+    std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+};
+
+/// Get the point timestamps are calibrated from. It is taken the first time hot sites are
+/// enabled, so that processes that never use them don't pay for it.
+static const TimestampCalibration& _getTimestampCalibration()
+{
+    static const TimestampCalibration calibration;
+    return calibration;
+}
+
+/// Get the length of a timestamp tick in nanoseconds, measured over the time since calibration
+static double _calcNanosecondsPerTick()
+{
+    const TimestampCalibration& calibration = _getTimestampCalibration();
+
+    // Make sure enough time has passed for the measurement to be accurate. This only waits if
+    // results are read within a millisecond of hot sites first being enabled.
+    uint64_t timestamp = 0;
+    std::chrono::nanoseconds elapsed;
+    do
+    {
+        timestamp = _readTimestamp();
+        elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - calibration.time);
+    } while (elapsed < std::chrono::milliseconds(1));
+
+    const uint64_t ticks = timestamp - calibration.timestamp;
+    return ticks ? double(elapsed.count()) / double(ticks) : 1.0;
+}
+
+/// Converts hot site timestamp ticks to nanoseconds, only measuring the tick length if there is
+/// a timed hot site invocation to convert
+struct TimestampTickLength
+{
+    double getNanosecondsPerTick()
+    {
+        if (m_nanosecondsPerTick == 0.0)
+            m_nanosecondsPerTick = _calcNanosecondsPerTick();
+        return m_nanosecondsPerTick;
+    }
+
+    double m_nanosecondsPerTick = 0.0;
+};
+
+// Hot sites are registered during static initialization, so their names are held in storage that
+// needs no construction.
+static const uint32_t kMaxHotSiteCount = 256;
+static const char* g_hotSiteNames[kMaxHotSiteCount];
+static std::atomic<uint32_t> g_hotSiteCount{0};
+
+/* static */ std::atomic<uint32_t> PerformanceProfiler::s_hotSiteEnabledCount{0};
+
+// The counters of a site are only written by the thread that owns the profiler, but can be read
+// (and cleared) from any thread. They are atomics so that this is well defined, but since each
+// has a single writer the accesses can be relaxed.
+struct PerformanceProfileSite
+{
+    const char* funcName = nullptr;
+    std::atomic<uint64_t> invocationCount{0};
+    /// In nanoseconds, or for a hot site in timestamp ticks
+    std::atomic<uint64_t> duration{0};
+    std::atomic<uint64_t> buckets[kBucketCount];
+
+    /// A hot site only records the time of sampled invocations, which are counted here
+    bool isHot = false;
+    std::atomic<uint64_t> sampledCount{0};
+    /// The number of invocations until the next is sampled. Only accessed by the owning thread.
+    uint32_t sampleCountdown = 0;
+
+    /// The next site of the same profiler. Once set it never changes.
+    std::atomic<PerformanceProfileSite*> next{nullptr};
+
+    PerformanceProfileSite() { clear(); }
+
+    void clear()
+    {
+        invocationCount.store(0, std::memory_order_relaxed);
+        duration.store(0, std::memory_order_relaxed);
+        sampledCount.store(0, std::memory_order_relaxed);
+        for (auto& bucket : buckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+};
+
+/// The results for a site accumulated from one or more profilers
+struct FuncProfileAccumulator
+{
+    void add(const PerformanceProfileSite* site, TimestampTickLength& tickLength)
+    {
+        const uint64_t siteInvocationCount = site->invocationCount.load(std::memory_order_relaxed);
+        invocationCount += siteInvocationCount;
+        if (!site->isHot)
+        {
+            durationNs += site->duration.load(std::memory_order_relaxed);
+            for (Index i = 0; i < kBucketCount; ++i)
+                buckets[i] += site->buckets[i].load(std::memory_order_relaxed);
+            return;
+        }
+
+        // Scale the time of the sampled invocations up to all of them, and move each histogram
+        // count to the bucket of its duration in nanoseconds.
+        const uint64_t sampledCount = site->sampledCount.load(std::memory_order_relaxed);
+        if (sampledCount == 0)
+            return;
+        const double nanosecondsPerTick = tickLength.getNanosecondsPerTick();
+        const double scale =
+            nanosecondsPerTick * double(siteInvocationCount) / double(sampledCount);
+        durationNs += uint64_t(double(site->duration.load(std::memory_order_relaxed)) * scale);
+        for (Index i = 0; i < kBucketCount; ++i)
+        {
+            const uint64_t count = site->buckets[i].load(std::memory_order_relaxed);
+            if (count)
+            {
+                const double midpointNs = double(_getBucketMidpoint(i)) * nanosecondsPerTick;
+                buckets[_getBucketIndex(uint64_t(midpointNs))] += count;
+            }
+        }
+    }
+
+    std::chrono::nanoseconds calcPercentile(double percentile) const
+    {
+        uint64_t total = 0;
+        for (auto count : buckets)
+            total += count;
+        if (total == 0)
+            return std::chrono::nanoseconds::zero();
+
+        // The rank (1 based) of the invocation at the percentile
+        uint64_t rank = uint64_t(percentile * double(total) + 0.5);
+        rank = rank < 1 ? 1 : (rank > total ? total : rank);
+
+        uint64_t seen = 0;
+        for (Index i = 0; i < kBucketCount; ++i)
+        {
+            seen += buckets[i];
+            if (seen >= rank)
+                return std::chrono::nanoseconds(_getBucketMidpoint(i));
+        }
+        return std::chrono::nanoseconds::zero();
+    }
+
+    FuncProfileSummary getSummary(const char* funcName) const
+    {
+        FuncProfileSummary summary;
+        summary.funcName = funcName;
+        summary.invocationCount = invocationCount;
+        summary.duration = std::chrono::nanoseconds(durationNs);
+        summary.p50 = calcPercentile(0.50);
+        summary.p95 = calcPercentile(0.95);
+        summary.p99 = calcPercentile(0.99);
+        return summary;
+    }
+
+    uint64_t invocationCount = 0;
+    uint64_t durationNs = 0;
+    uint64_t buckets[kBucketCount] = {};
+};
+
+static void _appendDuration(StringBuilder& out, std::chrono::nanoseconds duration)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.3fms", double(duration.count()) / 1000000.0);
+    out << buffer;
+}
+
+static void _appendSummaries(
+    StringBuilder& out,
+    const char* prefix,
+    const List<FuncProfileSummary>& funcs)
+{
+    char buffer[512];
+    for (const auto& func : funcs)
+    {
+        memset(buffer, 0, sizeof(buffer));
+        snprintf(buffer, sizeof(buffer), "%s %30s", prefix, func.funcName);
+        out << buffer << " \t";
+        out << func.invocationCount << " \tp50 ";
+        _appendDuration(out, func.p50);
+        out << " p95 ";
+        _appendDuration(out, func.p95);
+        out << " p99 ";
+        _appendDuration(out, func.p99);
+
+        auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(func.duration);
+        out << " \t" << static_cast<uint64_t>(milliseconds.count()) << "ms\n";
+    }
+}
+
+/// Get the lock held while the sites of a profiler are deleted, or read or cleared from a thread
+/// other than the one that owns the profiler
+static std::mutex& _getRegistryMutex();
+
 class PerformanceProfilerImpl : public PerformanceProfiler
 {
 public:
-    OrderedDictionary<const char*, FuncProfileInfo> data;
+    /// Lookup of sites by name. Only accessed by the owning thread.
+    Dictionary<const char*, PerformanceProfileSite*> m_siteMap;
+    /// Lookup of hot sites by id. Only accessed by the owning thread.
+    PerformanceProfileSite* m_hotSites[kMaxHotSiteCount] = {};
+
+    /// Sites in the order they were first entered. Readable from any thread.
+    std::atomic<PerformanceProfileSite*> m_firstSite{nullptr};
+    PerformanceProfileSite* m_lastSite = nullptr;
+
+    /// The next profiler in the global list of profilers. Once set it never changes.
+    PerformanceProfilerImpl* m_nextProfiler = nullptr;
+    /// Set whilst a thread is using this profiler
+    std::atomic<bool> m_isInUse{false};
+    /// Index used to identify the profiler in results
+    Index m_profilerIndex = 0;
+    /// Only written by the owning thread
+    std::atomic<uint32_t> m_hotSiteSampleInterval{0};
+
+    PerformanceProfileSite* _getOrAddSite(const char* funcName)
+    {
+        if (auto sitePtr = m_siteMap.tryGetValue(funcName))
+            return *sitePtr;
+
+        auto site = _addSite(funcName, false);
+        m_siteMap.add(funcName, site);
+        return site;
+    }
+
+    PerformanceProfileSite* _addSite(const char* funcName, bool isHot)
+    {
+        auto site = new PerformanceProfileSite;
+        site->funcName = funcName;
+        site->isHot = isHot;
+
+        // Publish the site only after it has been initialized
+        if (m_lastSite)
+            m_lastSite->next.store(site, std::memory_order_release);
+        else
+            m_firstSite.store(site, std::memory_order_release);
+        m_lastSite = site;
+        return site;
+    }
 
     virtual FuncProfileContext enterFunction(const char* funcName) override
     {
-        auto entry = data.tryGetValue(funcName);
-        if (!entry)
-        {
-            data.add(funcName, FuncProfileInfo());
-            entry = data.tryGetValue(funcName);
-        }
-        entry->invocationCount++;
+        auto site = _getOrAddSite(funcName);
+        site->invocationCount.fetch_add(1, std::memory_order_relaxed);
         FuncProfileContext ctx;
         ctx.funcName = funcName;
+        ctx.site = site;
         ctx.startTime = std::chrono::high_resolution_clock::now();
         return ctx;
     }
     virtual void exitFunction(FuncProfileContext ctx) override
     {
         auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = endTime - ctx.startTime;
-        auto entry = data.tryGetValue(ctx.funcName);
-        entry->duration += duration;
+        auto duration =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - ctx.startTime);
+        const uint64_t durationNs = uint64_t(duration.count());
+
+        auto site = ctx.site;
+        site->duration.fetch_add(durationNs, std::memory_order_relaxed);
+        site->buckets[_getBucketIndex(durationNs)].fetch_add(1, std::memory_order_relaxed);
+    }
+    /// Count an invocation of a hot site, returning the site if the invocation is to be timed
+    PerformanceProfileSite* enterHotSite(uint32_t siteId)
+    {
+        // Another thread has hot sites enabled, but this one doesn't
+        const uint32_t interval = m_hotSiteSampleInterval.load(std::memory_order_relaxed);
+        if (interval == 0 || siteId >= kMaxHotSiteCount)
+            return nullptr;
+
+        auto site = m_hotSites[siteId];
+        if (!site)
+        {
+            site = _addSite(g_hotSiteNames[siteId], true);
+            m_hotSites[siteId] = site;
+        }
+        site->invocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        // Restart the countdown if the interval has been lowered since it started
+        if (site->sampleCountdown > 1 && site->sampleCountdown <= interval)
+        {
+            site->sampleCountdown--;
+            return nullptr;
+        }
+        site->sampleCountdown = interval;
+        return site;
     }
     virtual void getResult(StringBuilder& out) override
     {
-        char buffer[512];
-        for (const auto& func : data)
+        List<FuncProfileSummary> funcs;
+        getSummaries(funcs);
+        _appendSummaries(out, "[*]", funcs);
+    }
+    virtual void getSummaries(List<FuncProfileSummary>& outSummaries) override
+    {
+        outSummaries.clear();
+        TimestampTickLength tickLength;
+        for (auto site = m_firstSite.load(std::memory_order_acquire); site;
+             site = site->next.load(std::memory_order_acquire))
         {
-            memset(buffer, 0, sizeof(buffer));
-            snprintf(buffer, sizeof(buffer), "[*] %30s", func.key);
-            out << buffer << " \t";
-            auto milliseconds =
-                std::chrono::duration_cast<std::chrono::milliseconds>(func.value.duration);
-            out << func.value.invocationCount << " \t"
-                << static_cast<uint64_t>(milliseconds.count()) << "ms\n";
+            if (site->invocationCount.load(std::memory_order_relaxed) == 0)
+                continue;
+
+            FuncProfileAccumulator accumulator;
+            accumulator.add(site, tickLength);
+            outSummaries.add(accumulator.getSummary(site->funcName));
         }
     }
-    virtual void clear() override { data.clear(); }
-    virtual void dispose() override { data = decltype(data)(); }
+    virtual void clear() override
+    {
+        for (auto site = m_firstSite.load(std::memory_order_acquire); site;
+             site = site->next.load(std::memory_order_acquire))
+        {
+            site->clear();
+        }
+    }
+    virtual void setHotSiteSampleInterval(uint32_t interval) override
+    {
+        const uint32_t prevInterval =
+            m_hotSiteSampleInterval.exchange(interval, std::memory_order_relaxed);
+        if (prevInterval == 0 && interval != 0)
+        {
+            _getTimestampCalibration();
+            s_hotSiteEnabledCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (prevInterval != 0 && interval == 0)
+        {
+            s_hotSiteEnabledCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+    virtual uint32_t getHotSiteSampleInterval() override
+    {
+        return m_hotSiteSampleInterval.load(std::memory_order_relaxed);
+    }
+    virtual void dispose() override
+    {
+        // Other threads may be combining the results of this profiler
+        std::lock_guard<std::mutex> lock(_getRegistryMutex());
+        _disposeLocked();
+    }
+
+    void _disposeLocked()
+    {
+        auto site = m_firstSite.exchange(nullptr, std::memory_order_acq_rel);
+        while (site)
+        {
+            auto next = site->next.load(std::memory_order_relaxed);
+            delete site;
+            site = next;
+        }
+        m_lastSite = nullptr;
+        m_siteMap = decltype(m_siteMap)();
+        for (auto& hotSite : m_hotSites)
+            hotSite = nullptr;
+    }
+
+    ~PerformanceProfilerImpl() { _disposeLocked(); }
+};
+
+/// Holds every profiler that has been created, as a singly linked list.
+///
+/// Profilers are never removed. When a thread exits its profiler is marked as unused,
+/// keeping its results, and can be picked up by a thread created later.
+///
+/// Recording never takes `m_mutex`. It is held to acquire and release profilers, to combine or
+/// clear the results of every profiler, and to dispose of a profiler's sites, so that sites are
+/// never deleted while another thread reads them.
+struct PerformanceProfilerRegistry
+{
+    PerformanceProfilerImpl* acquire()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto profiler = m_first.load(std::memory_order_acquire); profiler;
+             profiler = profiler->m_nextProfiler)
+        {
+            bool isInUse = false;
+            if (profiler->m_isInUse.compare_exchange_strong(isInUse, true))
+                return profiler;
+        }
+
+        auto profiler = new PerformanceProfilerImpl;
+        profiler->m_isInUse.store(true, std::memory_order_relaxed);
+        profiler->m_profilerIndex = m_profilerCount.fetch_add(1, std::memory_order_relaxed);
+
+        auto first = m_first.load(std::memory_order_relaxed);
+        do
+        {
+            profiler->m_nextProfiler = first;
+        } while (!m_first.compare_exchange_weak(
+            first,
+            profiler,
+            std::memory_order_release,
+            std::memory_order_relaxed));
+        return profiler;
+    }
+
+    void release(PerformanceProfilerImpl* profiler)
+    {
+        // The thread that picks the profiler up next starts with hot sites disabled
+        profiler->setHotSiteSampleInterval(0);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        profiler->m_isInUse.store(false, std::memory_order_release);
+    }
+
+    PerformanceProfilerImpl* getFirst() { return m_first.load(std::memory_order_acquire); }
+
+    ~PerformanceProfilerRegistry()
+    {
+        auto profiler = m_first.exchange(nullptr);
+        while (profiler)
+        {
+            auto next = profiler->m_nextProfiler;
+            delete profiler;
+            profiler = next;
+        }
+    }
+
+    std::atomic<PerformanceProfilerImpl*> m_first{nullptr};
+    std::atomic<Index> m_profilerCount{0};
+    std::mutex m_mutex;
 };
 
+static PerformanceProfilerRegistry& _getRegistry()
+{
+    static PerformanceProfilerRegistry registry;
+    return registry;
+}
+
+static std::mutex& _getRegistryMutex()
+{
+    return _getRegistry().m_mutex;
+}
+
+/// Acquires a profiler for the lifetime of a thread
+struct ThreadPerformanceProfiler
+{
+    ThreadPerformanceProfiler()
+        : m_profiler(_getRegistry().acquire())
+    {
+    }
+    ~ThreadPerformanceProfiler() { _getRegistry().release(m_profiler); }
+
+    PerformanceProfilerImpl* m_profiler;
+};
+
+class AllThreadsPerformanceProfiler : public PerformanceProfiler
+{
+public:
+    virtual FuncProfileContext enterFunction(const char* funcName) override
+    {
+        return getProfiler()->enterFunction(funcName);
+    }
+    virtual void exitFunction(FuncProfileContext ctx) override
+    {
+        getProfiler()->exitFunction(ctx);
+    }
+    virtual void getResult(StringBuilder& out) override
+    {
+        std::lock_guard<std::mutex> lock(_getRegistryMutex());
+
+        // Profilers are pushed to the front of the registry, so sort them for a stable order
+        List<PerformanceProfilerImpl*> profilers;
+        for (auto profiler = _getRegistry().getFirst(); profiler;
+             profiler = profiler->m_nextProfiler)
+        {
+            profilers.add(profiler);
+        }
+        profilers.sort([](PerformanceProfilerImpl* a, PerformanceProfilerImpl* b)
+                       { return a->m_profilerIndex < b->m_profilerIndex; });
+
+        List<FuncProfileSummary> funcs;
+        for (auto profiler : profilers)
+        {
+            profiler->getSummaries(funcs);
+            if (funcs.getCount() == 0)
+                continue;
+
+            StringBuilder prefix;
+            prefix << "[thread " << profiler->m_profilerIndex << "]";
+            _appendSummaries(out, prefix.getBuffer(), funcs);
+        }
+
+        _getSummariesLocked(funcs);
+        _appendSummaries(out, "[*]", funcs);
+    }
+    virtual void getSummaries(List<FuncProfileSummary>& outSummaries) override
+    {
+        std::lock_guard<std::mutex> lock(_getRegistryMutex());
+        _getSummariesLocked(outSummaries);
+    }
+    void _getSummariesLocked(List<FuncProfileSummary>& outSummaries)
+    {
+        outSummaries.clear();
+
+        // Sites are identified by name, since the same function has a different site in each
+        // thread. Use an ordered dictionary so the output follows the order first seen.
+        OrderedDictionary<const char*, FuncProfileAccumulator*> accumulators;
+        List<FuncProfileAccumulator*> toFree;
+        TimestampTickLength tickLength;
+
+        for (auto profiler = _getRegistry().getFirst(); profiler;
+             profiler = profiler->m_nextProfiler)
+        {
+            for (auto site = profiler->m_firstSite.load(std::memory_order_acquire); site;
+                 site = site->next.load(std::memory_order_acquire))
+            {
+                FuncProfileAccumulator* accumulator = nullptr;
+                if (auto accumulatorPtr = accumulators.tryGetValue(site->funcName))
+                {
+                    accumulator = *accumulatorPtr;
+                }
+                else
+                {
+                    accumulator = new FuncProfileAccumulator;
+                    toFree.add(accumulator);
+                    accumulators.add(site->funcName, accumulator);
+                }
+                accumulator->add(site, tickLength);
+            }
+        }
+
+        for (const auto& pair : accumulators)
+        {
+            if (pair.value->invocationCount)
+                outSummaries.add(pair.value->getSummary(pair.key));
+        }
+
+        for (auto accumulator : toFree)
+            delete accumulator;
+    }
+    virtual void clear() override
+    {
+        std::lock_guard<std::mutex> lock(_getRegistryMutex());
+        for (auto profiler = _getRegistry().getFirst(); profiler;
+             profiler = profiler->m_nextProfiler)
+        {
+            profiler->clear();
+        }
+    }
+    virtual void dispose() override { getProfiler()->dispose(); }
+    virtual void setHotSiteSampleInterval(uint32_t interval) override
+    {
+        getProfiler()->setHotSiteSampleInterval(interval);
+    }
+    virtual uint32_t getHotSiteSampleInterval() override
+    {
+        return getProfiler()->getHotSiteSampleInterval();
+    }
+};
+
+static PerformanceProfilerImpl* _getThreadProfiler()
+{
+    thread_local static ThreadPerformanceProfiler threadProfiler;
+    return threadProfiler.m_profiler;
+}
+
 PerformanceProfiler* Slang::PerformanceProfiler::getProfiler()
 {
-    thread_local static PerformanceProfilerImpl profiler = PerformanceProfilerImpl();
+    return _getThreadProfiler();
+}
+
+PerformanceProfiler* Slang::PerformanceProfiler::getAllThreadsProfiler()
+{
+    static AllThreadsPerformanceProfiler profiler;
     return &profiler;
 }
 
+uint32_t Slang::PerformanceProfiler::registerHotSite(const char* name)
+{
+    const uint32_t siteId = g_hotSiteCount.fetch_add(1, std::memory_order_relaxed);
+    if (siteId >= kMaxHotSiteCount)
+        return kMaxHotSiteCount;
+
+    g_hotSiteNames[siteId] = name;
+    return siteId;
+}
+
+PerformanceProfileSite* Slang::PerformanceProfiler::enterHotSite(
+    uint32_t siteId,
+    uint64_t& outStartTick)
+{
+    auto site = _getThreadProfiler()->enterHotSite(siteId);
+    if (site)
+    {
+        // Read last, so the time taken to find the site isn't included
+        outStartTick = _readTimestamp();
+    }
+    return site;
+}
+
+void Slang::PerformanceProfiler::exitHotSite(PerformanceProfileSite* site, uint64_t startTick)
+{
+    const uint64_t ticks = _readTimestamp() - startTick;
+    site->sampledCount.fetch_add(1, std::memory_order_relaxed);
+    site->duration.fetch_add(ticks, std::memory_order_relaxed);
+    site->buckets[_getBucketIndex(ticks)].fetch_add(1, std::memory_order_relaxed);
+}
+
 SlangProfiler::SlangProfiler(PerformanceProfiler* profiler)
 {
-    PerformanceProfilerImpl* profilerImpl = static_cast<PerformanceProfilerImpl*>(profiler);
-    size_t entryCount = profilerImpl->data.getCount();
+    List<FuncProfileSummary> funcs;
+    profiler->getSummaries(funcs);
 
-    m_profilEntries.reserve(entryCount);
+    m_profilEntries.reserve(funcs.getCount());
 
-    int index = 0;
-    for (auto func : profilerImpl->data)
+    for (const auto& func : funcs)
     {
         ProfileInfo profileEntry{};
-        size_t strSize = std::min(sizeof(profileEntry.funcName) - 1, strlen(func.key));
+        size_t strSize = std::min(sizeof(profileEntry.funcName) - 1, strlen(func.funcName));
 
         if (strSize > 0)
         {
-            memcpy(profileEntry.funcName, func.key, strSize);
+            memcpy(profileEntry.funcName, func.funcName, strSize);
         }
-        profileEntry.invocationCount = func.value.invocationCount;
-        profileEntry.duration = func.value.duration;
+        profileEntry.invocationCount = int(func.invocationCount);
+        profileEntry.duration = func.duration;
 
-        m_profilEntries.insert(index, profileEntry);
-        index++;
+        m_profilEntries.add(profileEntry);
     }
 }
 
@@ -5,35 +5,89 @@
 #include "slang-com-helper.h"
 #include "slang-string.h"
 
+#include <atomic>
 #include <chrono>
 #include <vector>
 
 namespace Slang
 {
 
-struct FuncProfileInfo
-{
-    int invocationCount = 0;
-    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
-};
+struct PerformanceProfileSite;
 
 struct FuncProfileContext
 {
     const char* funcName = nullptr;
     std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+    /// The site the invocation is recorded against. Owned by the profiler.
+    PerformanceProfileSite* site = nullptr;
+};
+
+/// Summary of the results for one profiled function or section
+struct FuncProfileSummary
+{
+    const char* funcName = nullptr;
+    uint64_t invocationCount = 0;
+    /// The total time spent over all invocations
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+
+    /// Latency percentiles of individual invocations.
+    ///
+    /// These are derived from a log-linear histogram, so are approximate (within ~12%).
+    std::chrono::nanoseconds p50 = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds p95 = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds p99 = std::chrono::nanoseconds::zero();
 };
 
+/* Each thread records into its own profiler (returned by `getProfiler`), so recording
+never takes a lock. Each thread's profiler is also registered globally, so that the results
+of all threads can be combined via `getAllThreadsProfiler`. Merging only reads the other
+threads' counters, so it can happen while other threads are compiling. It holds the lock of
+the registry, as does `dispose`, so sites are never deleted while they are being read. */
 class PerformanceProfiler
 {
 public:
     virtual FuncProfileContext enterFunction(const char* funcName) = 0;
     virtual void exitFunction(FuncProfileContext context) = 0;
     virtual void getResult(StringBuilder& out) = 0;
+    /// Get a summary of every site that has been invoked, in the order first entered
+    virtual void getSummaries(List<FuncProfileSummary>& outSummaries) = 0;
     virtual void clear() = 0;
     virtual void dispose() = 0;
 
+    /// Set how hot sites are profiled on this profiler's thread. 0 disables them, otherwise one
+    /// in every interval invocations of each site is timed. Other threads are unaffected.
+    virtual void setHotSiteSampleInterval(uint32_t interval) = 0;
+    virtual uint32_t getHotSiteSampleInterval() = 0;
+
 public:
+    /// Get the profiler for the calling thread
     static PerformanceProfiler* getProfiler();
+
+    /// Get a profiler that combines the results of all threads.
+    ///
+    /// Entering or exiting a function, and the hot site sample interval, use the calling
+    /// thread's profiler.
+    /// `getResult` lists each thread followed by the combined results, and `clear`
+    /// clears the results of all threads.
+    static PerformanceProfiler* getAllThreadsProfiler();
+
+    /// Register a hot site called name, returning its id. Sites beyond the maximum number are
+    /// given an id that is never recorded. name must remain valid for the life of the process.
+    static uint32_t registerHotSite(const char* name);
+
+    /// True if any thread's profiler has hot sites enabled
+    static bool isAnyHotSiteEnabled()
+    {
+        return s_hotSiteEnabledCount.load(std::memory_order_relaxed) != 0;
+    }
+
+    /// Record an invocation of a hot site by the calling thread. Returns the site to pass to
+    /// `exitHotSite` if the invocation is to be timed, else nullptr.
+    static PerformanceProfileSite* enterHotSite(uint32_t siteId, uint64_t& outStartTick);
+    static void exitHotSite(PerformanceProfileSite* site, uint64_t startTick);
+
+    /// The number of profilers with hot sites enabled
+    static std::atomic<uint32_t> s_hotSiteEnabledCount;
 };
 
 struct PerformanceProfilerFuncRAIIContext
@@ -49,6 +103,27 @@ struct PerformanceProfilerFuncRAIIContext
     }
 };
 
+struct PerformanceProfilerHotSiteRAIIContext
+{
+    PerformanceProfilerHotSiteRAIIContext(uint32_t siteId)
+    {
+        if (PerformanceProfiler::isAnyHotSiteEnabled())
+        {
+            site = PerformanceProfiler::enterHotSite(siteId, startTick);
+        }
+    }
+    ~PerformanceProfilerHotSiteRAIIContext()
+    {
+        if (site)
+        {
+            PerformanceProfiler::exitHotSite(site, startTick);
+        }
+    }
+
+    PerformanceProfileSite* site = nullptr;
+    uint64_t startTick = 0;
+};
+
 struct SlangProfiler : public ISlangProfiler, public RefObject
 {
 public:
@@ -74,6 +149,32 @@ private:
 #define SLANG_PROFILE PerformanceProfilerFuncRAIIContext _profileContext(__func__)
 #define SLANG_PROFILE_SECTION(s) PerformanceProfilerFuncRAIIContext _profileContext##s(#s)
 
+/* Hot sites are for functions called so often that `SLANG_PROFILE` would cost too much, such as
+those of the lexer or the IR builder. A hot site is declared once at namespace scope, so it is
+registered during static initialization, and entering it is then an index by its id rather than a
+lookup by name. Invocations are timed with the CPU's timestamp counter, which is converted to
+nanoseconds when results are read.
+
+Hot sites are only recorded on threads whose profiler has them enabled with
+`setHotSiteSampleInterval` (as a compile with the `-report-perf-benchmark-hot-functions` option
+does on its own thread). Whilst no thread has them enabled entering one is a single relaxed load.
+With an interval above 1 only that fraction of invocations is timed. The invocation count is still
+exact, and the reported time is scaled up from the timed invocations.
+
+    SLANG_PROFILE_HOT_SITE(lexToken);
+
+    Token Lexer::lexToken()
+    {
+        SLANG_PROFILE_HOT(lexToken);
+        ...
+    }
+*/
+#define SLANG_PROFILE_HOT_SITE(name)                \
+    static const uint32_t _profileHotSiteId##name = \
+        ::Slang::PerformanceProfiler::registerHotSite(#name)
+#define SLANG_PROFILE_HOT(name) \
+    ::Slang::PerformanceProfilerHotSiteRAIIContext _profileHotContext##name(_profileHotSiteId##name)
+
 } // namespace Slang
 
 #endif
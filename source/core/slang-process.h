@@ -84,6 +84,24 @@ protected:
         m_streams[Index(StdStreamType::CountOf)]; ///< Streams to communicate with the process
 };
 
+/* Allows processes on the same machine to connect to each other by name.
+
+On unix-like targets the name is the path of a unix domain socket. On Windows it is the name of a
+named pipe, without the `\\.\pipe\` prefix. */
+class LocalListener : public RefObject
+{
+public:
+    /// Blocks until a process connects. The stream returned can be read from and written to.
+    virtual SlangResult accept(RefPtr<Stream>& outStream) = 0;
+
+    /// Start listening on `name`. Fails if another process is already listening on it.
+    static SlangResult create(const String& name, RefPtr<LocalListener>& outListener);
+
+    /// Connect to the process listening on `name`.
+    /// Returns SLANG_E_NOT_FOUND if no process is listening.
+    static SlangResult connect(const String& name, RefPtr<Stream>& outStream);
+};
+
 } // namespace Slang
 
 #endif // SLANG_PROCESS_H
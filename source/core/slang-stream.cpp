@@ -518,6 +518,12 @@ SlangResult BufferedReadStream::flush()
     return SLANG_E_NOT_AVAILABLE;
 }
 
+SlangResult BufferedReadStream::waitForReadable(Int timeOutInMs)
+{
+    // With no backing stream, this is the end of the stream
+    return m_stream ? m_stream->waitForReadable(timeOutInMs) : SLANG_OK;
+}
+
 SlangResult BufferedReadStream::update()
 {
     if (m_stream == nullptr)
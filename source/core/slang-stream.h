@@ -58,6 +58,18 @@ public:
     /// pipe, or file)
     virtual SlangResult flush() = 0;
 
+    /// Block until a read can make progress - there is data to read, or the stream has ended - or
+    /// until timeOutInMs has elapsed. A timeout of -1 means wait indefinitely.
+    ///
+    /// Returns SLANG_E_TIME_OUT if the time elapsed without the stream becoming readable.
+    /// Returns SLANG_E_NOT_IMPLEMENTED if the stream has no way to wait, in which case the caller
+    /// has to poll with 'read'.
+    virtual SlangResult waitForReadable(Int timeOutInMs)
+    {
+        SLANG_UNUSED(timeOutInMs);
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
+
     /// Helper function that will also *fail* if the specified amount of bytes aren't read.
     SlangResult readExactly(void* buffer, size_t length);
 };
@@ -243,6 +255,8 @@ public:
     virtual void close() SLANG_OVERRIDE;
     virtual bool isEnd() SLANG_OVERRIDE;
     virtual SlangResult flush() SLANG_OVERRIDE;
+    /// Waits on the backing stream. Data already held in the buffer is not taken into account.
+    virtual SlangResult waitForReadable(Int timeOutInMs) SLANG_OVERRIDE;
 
     /// Will read assuming backing stream is
     SlangResult update();
@@ -13,8 +13,11 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <poll.h>
+#include <sys/file.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -66,12 +69,15 @@ public:
     virtual bool canWrite() SLANG_OVERRIDE { return _has(FileAccess::Write) && !m_isClosed; }
     virtual void close() SLANG_OVERRIDE;
     virtual SlangResult flush() SLANG_OVERRIDE;
+    virtual SlangResult waitForReadable(Int timeOutInMs) SLANG_OVERRIDE;
 
-    UnixPipeStream(int fd, FileAccess access, bool isOwned)
-        : m_fd(fd), m_access(access), m_isOwned(isOwned), m_isClosed(false)
+    UnixPipeStream(int fd, FileAccess access, bool isOwned, bool isSocket = false)
+        : m_fd(fd), m_access(access), m_isOwned(isOwned), m_isSocket(isSocket), m_isClosed(false)
     {
     }
 
+    ~UnixPipeStream() { close(); }
+
 protected:
     /// This read file descriptor non blocking. Doing so will change the behavior of
     /// read - it can fail and return an error indicating there is no data, instead of blocking.
@@ -89,6 +95,7 @@ protected:
 
     bool m_isClosed;     ///< If true this stream has been closed (ie cannot read/write to anymore)
     bool m_isOwned;      ///< True if m_fd is owned by this object.
+    bool m_isSocket;     ///< True if m_fd is a socket, so can be written to without SIGPIPE
     FileAccess m_access; ///< Access allowed to this stream - either Read or Write
     int m_fd;            /// The 'file descriptor' for the pipe
 };
@@ -300,6 +307,14 @@ SlangResult UnixPipeStream::read(void* buffer, size_t length, size_t& outReadByt
         {
             return SLANG_OK;
         }
+
+        // Readable but nothing to read is end of file. A socket whose peer has closed
+        // may not report HUP, so close here. Pipes keep relying on HUP.
+        if (m_isSocket)
+        {
+            close();
+            return SLANG_OK;
+        }
     }
 
     if (pollInfo.revents & POLLHUP)
@@ -310,6 +325,35 @@ SlangResult UnixPipeStream::read(void* buffer, size_t length, size_t& outReadByt
     return SLANG_OK;
 }
 
+SlangResult UnixPipeStream::waitForReadable(Int timeOutInMs)
+{
+    if (!_has(FileAccess::Read))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    if (m_isClosed)
+    {
+        return SLANG_OK;
+    }
+
+    pollfd pollInfo;
+    pollInfo.fd = m_fd;
+    pollInfo.events = POLLIN | POLLHUP;
+    pollInfo.revents = 0;
+
+    // A negative timeout blocks until there is an event
+    const int pollTimeout = (timeOutInMs < 0) ? -1 : int(timeOutInMs);
+
+    const int pollResult = ::poll(&pollInfo, 1, pollTimeout);
+    if (pollResult < 0)
+    {
+        // Interrupted by a signal. Callers wait in a loop, so treat as a spurious wake up.
+        return (errno == EINTR) ? SLANG_OK : SLANG_FAIL;
+    }
+
+    return (pollResult == 0) ? SLANG_E_TIME_OUT : SLANG_OK;
+}
+
 SlangResult UnixPipeStream::write(const void* buffer, size_t length)
 {
     if (!_has(FileAccess::Write))
@@ -345,7 +389,15 @@ SlangResult UnixPipeStream::write(const void* buffer, size_t length)
         return SLANG_FAIL;
     }
 
+    // Writing to a socket whose peer has gone raises SIGPIPE, which by default kills the
+    // process. Sockets are written without the signal, so the write just fails.
+#ifdef MSG_NOSIGNAL
+    const ssize_t writeResult =
+        m_isSocket ? ::send(m_fd, buffer, length, MSG_NOSIGNAL) : ::write(m_fd, buffer, length);
+#else
+    // Where there is no MSG_NOSIGNAL, the socket is created with SO_NOSIGPIPE instead
     const ssize_t writeResult = ::write(m_fd, buffer, length);
+#endif
 
     if (writeResult < 0 || size_t(writeResult) != length)
     {
@@ -355,6 +407,194 @@ SlangResult UnixPipeStream::write(const void* buffer, size_t length)
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!! UnixLocalListener !!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+class UnixLocalListener : public LocalListener
+{
+public:
+    // LocalListener
+    virtual SlangResult accept(RefPtr<Stream>& outStream) SLANG_OVERRIDE;
+
+    UnixLocalListener(int fd, int lockFd, const String& path)
+        : m_fd(fd), m_lockFd(lockFd), m_path(path)
+    {
+    }
+    ~UnixLocalListener()
+    {
+        // Remove the socket before giving up the lock, so a new listener can't have replaced it
+        ::unlink(m_path.getBuffer());
+        ::close(m_fd);
+        ::close(m_lockFd);
+    }
+
+protected:
+    int m_fd;      ///< The listening socket
+    int m_lockFd;  ///< Holds the lock on the name while listening
+    String m_path; ///< The path of the socket, removed when done
+};
+
+static SlangResult _initLocalAddress(const String& name, sockaddr_un& outAddress)
+{
+    memset(&outAddress, 0, sizeof(outAddress));
+    outAddress.sun_family = AF_UNIX;
+
+    // Needs space for the terminating zero
+    if (size_t(name.getLength()) >= sizeof(outAddress.sun_path))
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    memcpy(outAddress.sun_path, name.getBuffer(), name.getLength());
+    return SLANG_OK;
+}
+
+static void _initLocalSocket(int fd)
+{
+    // Don't leak the socket into processes we launch
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+#ifdef SO_NOSIGPIPE
+    // Writing to the socket once the peer has gone should fail, rather than raise SIGPIPE
+    int noSigPipe = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+}
+
+static int _createLocalSocket()
+{
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0)
+    {
+        _initLocalSocket(fd);
+    }
+    return fd;
+}
+
+/// True if the process on the other end of the socket `fd` runs as the same user as this one
+static bool _isPeerSameUser(int fd)
+{
+#if defined(SO_PEERCRED)
+    struct ucred cred;
+    socklen_t credSize = sizeof(cred);
+    if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &credSize) != 0)
+    {
+        return false;
+    }
+    return cred.uid == ::geteuid();
+#else
+    uid_t uid;
+    gid_t gid;
+    if (::getpeereid(fd, &uid, &gid) != 0)
+    {
+        return false;
+    }
+    return uid == ::geteuid();
+#endif
+}
+
+SlangResult UnixLocalListener::accept(RefPtr<Stream>& outStream)
+{
+    for (;;)
+    {
+        const int fd = ::accept(m_fd, nullptr, nullptr);
+        if (fd >= 0)
+        {
+            // The socket can only be connected to by its owner, but root can still get in
+            if (!_isPeerSameUser(fd))
+            {
+                ::close(fd);
+                continue;
+            }
+
+            _initLocalSocket(fd);
+            outStream = new UnixPipeStream(fd, FileAccess::ReadWrite, true, true);
+            return SLANG_OK;
+        }
+        if (errno != EINTR && errno != ECONNABORTED)
+        {
+            return SLANG_FAIL;
+        }
+    }
+}
+
+/* static */ SlangResult LocalListener::create(
+    const String& name,
+    RefPtr<LocalListener>& outListener)
+{
+    sockaddr_un address;
+    SLANG_RETURN_ON_FAIL(_initLocalAddress(name, address));
+
+    // The listener holds a lock on `<name>.lock` for as long as it listens. The lock file is
+    // left in place, as removing it would let two processes lock different files.
+    StringBuilder lockPath;
+    lockPath << name << ".lock";
+    const int lockFd = ::open(lockPath.getBuffer(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (lockFd < 0)
+    {
+        return SLANG_FAIL;
+    }
+    if (::flock(lockFd, LOCK_EX | LOCK_NB) != 0)
+    {
+        // Another process is listening on the name
+        ::close(lockFd);
+        return SLANG_E_INVALID_ARG;
+    }
+
+    // Holding the lock means nothing else is listening, so a socket file was left behind by a
+    // process that didn't exit cleanly, and can be replaced.
+    struct stat info;
+    if (::lstat(name.getBuffer(), &info) == 0 && S_ISSOCK(info.st_mode))
+    {
+        ::unlink(name.getBuffer());
+    }
+
+    const int fd = _createLocalSocket();
+    if (fd < 0)
+    {
+        ::close(lockFd);
+        return SLANG_FAIL;
+    }
+
+    // Only the owner may connect. Nothing can connect before `listen`, so there is no window
+    // where the socket is open to others.
+    if (::bind(fd, (const sockaddr*)&address, sizeof(address)) != 0)
+    {
+        ::close(fd);
+        ::close(lockFd);
+        return SLANG_FAIL;
+    }
+    if (::chmod(name.getBuffer(), S_IRUSR | S_IWUSR) != 0 || ::listen(fd, 64) != 0)
+    {
+        ::unlink(name.getBuffer());
+        ::close(fd);
+        ::close(lockFd);
+        return SLANG_FAIL;
+    }
+
+    outListener = new UnixLocalListener(fd, lockFd, name);
+    return SLANG_OK;
+}
+
+/* static */ SlangResult LocalListener::connect(const String& name, RefPtr<Stream>& outStream)
+{
+    sockaddr_un address;
+    SLANG_RETURN_ON_FAIL(_initLocalAddress(name, address));
+
+    const int fd = _createLocalSocket();
+    if (fd < 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    if (::connect(fd, (const sockaddr*)&address, sizeof(address)) != 0)
+    {
+        ::close(fd);
+        return SLANG_E_NOT_FOUND;
+    }
+
+    outStream = new UnixPipeStream(fd, FileAccess::ReadWrite, true, true);
+    return SLANG_OK;
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!! Process !!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
 /* static */ UnownedStringSlice Process::getExecutableSuffix()
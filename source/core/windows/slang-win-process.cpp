@@ -11,6 +11,8 @@
 // mean trying to hide certain struct layouts, which would add
 // more dynamic allocation.
 #include <windows.h>
+// For the conversions between security descriptors and strings
+#include <sddl.h>
 #endif
 
 #include <process.h>
@@ -328,6 +330,173 @@ SlangResult WinPipeStream::flush()
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!! WinLocalListener !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* Listens using a named pipe. Each connection uses a pipe instance, so a new instance is created
+after each connection is accepted. */
+class WinLocalListener : public LocalListener
+{
+public:
+    // LocalListener
+    virtual SlangResult accept(RefPtr<Stream>& outStream) SLANG_OVERRIDE;
+
+    SlangResult init(const String& name);
+
+    ~WinLocalListener()
+    {
+        if (m_securityDescriptor)
+        {
+            ::LocalFree(m_securityDescriptor);
+        }
+    }
+
+protected:
+    SlangResult _createInstance(bool isFirst);
+
+    OSString m_path;
+    WinHandle m_pipeHandle; ///< The instance the next connection will use
+    /// Only lets the current user open the pipe. Allocated with LocalAlloc.
+    PSECURITY_DESCRIPTOR m_securityDescriptor = nullptr;
+};
+
+/// Create a security descriptor that only gives the user running this process access
+static SlangResult _createCurrentUserSecurityDescriptor(PSECURITY_DESCRIPTOR& outDescriptor)
+{
+    WinHandle token;
+    if (!::OpenProcessToken(::GetCurrentProcess(), TOKEN_QUERY, token.writeRef()))
+    {
+        return SLANG_FAIL;
+    }
+
+    DWORD size = 0;
+    ::GetTokenInformation(token, TokenUser, nullptr, 0, &size);
+    List<Byte> tokenUser;
+    tokenUser.setCount(Index(size));
+    if (!::GetTokenInformation(token, TokenUser, tokenUser.getBuffer(), size, &size))
+    {
+        return SLANG_FAIL;
+    }
+
+    LPSTR sid = nullptr;
+    if (!::ConvertSidToStringSidA(((TOKEN_USER*)tokenUser.getBuffer())->User.Sid, &sid))
+    {
+        return SLANG_FAIL;
+    }
+
+    // A protected DACL with a single entry, giving the user all access
+    StringBuilder buf;
+    buf << "D:P(A;;GA;;;" << sid << ")";
+    ::LocalFree(sid);
+
+    if (!::ConvertStringSecurityDescriptorToSecurityDescriptorW(
+            buf.toString().toWString(),
+            SDDL_REVISION_1,
+            &outDescriptor,
+            nullptr))
+    {
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+static OSString _getLocalPipePath(const String& name)
+{
+    StringBuilder buf;
+    buf << "\\\\.\\pipe\\" << name;
+    return buf.toString().toWString();
+}
+
+SlangResult WinLocalListener::_createInstance(bool isFirst)
+{
+    const DWORD bufferSize = 64 * 1024;
+
+    SECURITY_ATTRIBUTES securityAttributes = {};
+    securityAttributes.nLength = sizeof(securityAttributes);
+    securityAttributes.lpSecurityDescriptor = m_securityDescriptor;
+    securityAttributes.bInheritHandle = FALSE;
+
+    HANDLE handle = ::CreateNamedPipeW(
+        m_path,
+        PIPE_ACCESS_DUPLEX | (isFirst ? FILE_FLAG_FIRST_PIPE_INSTANCE : 0),
+        PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+        PIPE_UNLIMITED_INSTANCES,
+        bufferSize,
+        bufferSize,
+        0,
+        &securityAttributes);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return SLANG_FAIL;
+    }
+    m_pipeHandle = handle;
+    return SLANG_OK;
+}
+
+SlangResult WinLocalListener::init(const String& name)
+{
+    m_path = _getLocalPipePath(name);
+    SLANG_RETURN_ON_FAIL(_createCurrentUserSecurityDescriptor(m_securityDescriptor));
+    // Being the first instance means no other process is listening on the name
+    return _createInstance(true);
+}
+
+SlangResult WinLocalListener::accept(RefPtr<Stream>& outStream)
+{
+    if (m_pipeHandle.isNull())
+    {
+        SLANG_RETURN_ON_FAIL(_createInstance(false));
+    }
+
+    // Blocks until a client connects. If the client connected before the call, it's reported as
+    // ERROR_PIPE_CONNECTED which is fine.
+    if (!::ConnectNamedPipe(m_pipeHandle, nullptr) && ::GetLastError() != ERROR_PIPE_CONNECTED)
+    {
+        m_pipeHandle.setNull();
+        return SLANG_FAIL;
+    }
+
+    outStream = new WinPipeStream(m_pipeHandle.detach(), FileAccess::ReadWrite, true);
+    return SLANG_OK;
+}
+
+/* static */ SlangResult LocalListener::create(
+    const String& name,
+    RefPtr<LocalListener>& outListener)
+{
+    RefPtr<WinLocalListener> listener(new WinLocalListener);
+    SLANG_RETURN_ON_FAIL(listener->init(name));
+    outListener = listener;
+    return SLANG_OK;
+}
+
+/* static */ SlangResult LocalListener::connect(const String& name, RefPtr<Stream>& outStream)
+{
+    const OSString path = _getLocalPipePath(name);
+
+    for (;;)
+    {
+        HANDLE handle = ::CreateFileW(
+            path,
+            GENERIC_READ | GENERIC_WRITE,
+            0,
+            nullptr,
+            OPEN_EXISTING,
+            0,
+            nullptr);
+        if (handle != INVALID_HANDLE_VALUE)
+        {
+            outStream = new WinPipeStream(handle, FileAccess::ReadWrite, true);
+            return SLANG_OK;
+        }
+
+        // If all instances are busy, wait for one to become available
+        if (::GetLastError() != ERROR_PIPE_BUSY || !::WaitNamedPipeW(path, 5000))
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+    }
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!! WinProcess !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
 void WinProcess::_hasTerminated()
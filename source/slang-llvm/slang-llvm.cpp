@@ -10,6 +10,7 @@
 #include "clang/Frontend/CompilerInvocation.h"
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
+#include "clang/Frontend/PrecompiledPreamble.h"
 #include "clang/Frontend/TextDiagnosticBuffer.h"
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Frontend/Utils.h"
@@ -32,6 +33,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/Timer.h"
+#include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 
@@ -61,6 +63,7 @@
 #include <core/slang-shared-library.h>
 #include <core/slang-string-util.h>
 #include <core/slang-string.h>
+#include <mutex>
 #include <stdio.h>
 
 // We want to make math functions available to the JIT
@@ -110,6 +113,43 @@ using namespace llvm::orc;
 
 using namespace Slang;
 
+class LLVMJITSession;
+
+/* !!!!!!!!!!!!!!!!!!!!! LLVMPreambleCache !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* The C++ source produced by Slang starts with the prelude, which is typically many times larger
+than the code generated for a kernel and is identical between compilations that use the same
+options. The cache holds clang precompiled preambles of that prefix, such that the prelude only has
+to be parsed once per option set. */
+class LLVMPreambleCache
+{
+public:
+    /// Find or build a precompiled preamble for the first preambleSize bytes of the source in
+    /// sourceBuffer. Returns nullptr if a preamble could not be built - the source should then be
+    /// compiled without one.
+    std::shared_ptr<PrecompiledPreamble> findOrCreate(
+        const CompilerInvocation& invocation,
+        const llvm::MemoryBuffer& sourceBuffer,
+        Index preambleSize,
+        HashCode64 optionsHash,
+        IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem);
+
+protected:
+    struct Entry
+    {
+        HashCode64 optionsHash;
+        String text;
+        std::shared_ptr<PrecompiledPreamble> preamble;
+    };
+
+    // Each preamble is an in memory PCH of the prelude, so only hold a handful
+    static const Index kMaxEntries = 4;
+
+    std::mutex m_mutex;
+    // Ordered from least to most recently used
+    List<Entry> m_entries;
+};
+
 class LLVMDownstreamCompiler : public ComBaseObject, public IDownstreamCompiler
 {
 public:
@@ -167,75 +207,18 @@ public:
     void* getInterface(const Guid& guid);
     void* getObject(const Guid& guid);
 
-    Desc m_desc;
-};
-
-
-/* !!!!!!!!!!!!!!!!!!!!! LLVMJITSharedLibrary !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
-
-/* This implementation uses atomic ref counting to ensure the shared libraries lifetime can outlive
-the LLVMDownstreamCompileResult and the compilation that created it */
-class LLVMJITSharedLibrary : public ISlangSharedLibrary, public ComBaseObject
-{
-public:
-    // ISlangUnknown
-    SLANG_COM_BASE_IUNKNOWN_ALL
-
-    /// ICastable
-    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const Guid& guid) SLANG_OVERRIDE;
-
-    // ISlangSharedLibrary impl
-    virtual SLANG_NO_THROW void* SLANG_MCALL findSymbolAddressByName(char const* name)
-        SLANG_OVERRIDE;
+    /// Get the JIT session shared between compilations, creating it if necessary.
+    /// On failure outError describes the problem.
+    SlangResult _getJITSession(std::shared_ptr<LLVMJITSession>& outSession, std::string& outError);
 
-    LLVMJITSharedLibrary(std::unique_ptr<llvm::orc::LLJIT> jit)
-        : m_jit(std::move(jit))
-    {
-    }
+    Desc m_desc;
 
-protected:
-    ISlangUnknown* getInterface(const SlangUUID& uuid);
-    void* getObject(const SlangUUID& uuid);
+    std::mutex m_jitSessionMutex;
+    std::shared_ptr<LLVMJITSession> m_jitSession;
 
-    std::unique_ptr<llvm::orc::LLJIT> m_jit;
+    LLVMPreambleCache m_preambleCache;
 };
 
-ISlangUnknown* LLVMJITSharedLibrary::getInterface(const SlangUUID& guid)
-{
-    if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangCastable::getTypeGuid() ||
-        guid == ISlangSharedLibrary::getTypeGuid())
-    {
-        return static_cast<ISlangSharedLibrary*>(this);
-    }
-    return nullptr;
-}
-
-void* LLVMJITSharedLibrary::getObject(const SlangUUID& uuid)
-{
-    SLANG_UNUSED(uuid);
-    return nullptr;
-}
-
-void* LLVMJITSharedLibrary::castAs(const Guid& guid)
-{
-    if (auto ptr = getInterface(guid))
-    {
-        return ptr;
-    }
-    return getObject(guid);
-}
-
-void* LLVMJITSharedLibrary::findSymbolAddressByName(char const* name)
-{
-    auto fnExpected = m_jit->lookup(name);
-    if (fnExpected)
-    {
-        auto fn = std::move(*fnExpected);
-        return (void*)fn.getAddress();
-    }
-    return nullptr;
-}
-
 
 static void _ensureSufficientStack() {}
 
@@ -564,6 +547,391 @@ static SlangResult _initLLVM()
 }
 
 
+/* !!!!!!!!!!!!!!!!!!!!! LLVMJITSession !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* Creating a LLJIT and populating it with the functions made available to JITed code is
+relatively expensive and the same for every compilation. A LLVMJITSession holds a single LLJIT
+that is shared between compilations. Each compilation adds its module to a JITDylib of its own,
+which is removed when the LLVMJITSharedLibrary that holds it is released.
+
+The session is held via std::shared_ptr (with atomic ref counting) such that it can outlive the
+LLVMDownstreamCompiler that created it. */
+class LLVMJITSession
+{
+public:
+    /// Adds the module to a new JITDylib, that can access the functions made available to the JIT.
+    SlangResult addModule(ThreadSafeModule module, JITDylib*& outDylib);
+    /// Removes a dylib previously created via addModule
+    void removeDylib(JITDylib* dylib);
+
+    /// Lookup the symbol name in the dylib. Returns nullptr if not found.
+    void* findSymbolAddress(JITDylib* dylib, const char* name);
+
+    /// Create a session. On failure outError describes the problem.
+    static SlangResult create(std::shared_ptr<LLVMJITSession>& outSession, std::string& outError);
+
+protected:
+    SlangResult _addStdcLib();
+
+    std::mutex m_mutex;
+    std::unique_ptr<LLJIT> m_jit;
+    JITDylib* m_stdcLib = nullptr;
+    // Used to make the JITDylib names unique
+    uint64_t m_dylibCounter = 0;
+};
+
+/* static */ SlangResult LLVMJITSession::create(
+    std::shared_ptr<LLVMJITSession>& outSession,
+    std::string& outError)
+{
+    LLJITBuilder jitBuilder;
+
+    Expected<std::unique_ptr<llvm::orc::LLJIT>> expectJit = jitBuilder.create();
+    if (!expectJit)
+    {
+        /* JS: NOTE!
+
+        It is worth saying there can be some odd issues around creating the JIT - if
+        LLVM-C is linked against.
+
+        If it is then LLVM will likely startup saying LLVM-C isn't found.
+        BUT if you have LLVM *installed* on your system (as is reasonable to do from a
+        LLVM distro, then at startup it *MIGHT* find a LLVM-C dll in that installation
+        (ie nothing to do with the version of LLVM linked with). This will likely lead
+        to an odd error saying the 'triple can't be found' and that no targets are
+        registered.
+
+        Also note that the behavior *may* be different with Debug/Release - because of
+        how the linked resolves symbols that are multiply defined.
+
+        If there are problems creating the JIT, check that LLVM-C is not linked against
+        (it should be disabled in the premake).
+        */
+
+        auto err = expectJit.takeError();
+
+        llvm::raw_string_ostream jitErrorStream(outError);
+        jitErrorStream << err;
+        jitErrorStream.flush();
+
+        return SLANG_FAIL;
+    }
+
+    auto session = std::make_shared<LLVMJITSession>();
+    session->m_jit = std::move(*expectJit);
+
+    if (SLANG_FAILED(session->_addStdcLib()))
+    {
+        outError = "Unable to add stdc library to JIT engine";
+        return SLANG_FAIL;
+    }
+
+    outSession = session;
+    return SLANG_OK;
+}
+
+SlangResult LLVMJITSession::_addStdcLib()
+{
+    // Used the following link to test this out
+    // https://www.llvm.org/docs/ORCv2.html
+    // https://www.llvm.org/docs/ORCv2.html#processandlibrarysymbols
+
+    auto& es = m_jit->getExecutionSession();
+
+    const DataLayout& dl = m_jit->getDataLayout();
+    MangleAndInterner mangler(es, dl);
+
+    // The name of the lib must be unique. Should be here as we are only thing adding
+    // libs
+    auto stdcLibExpected = es.createJITDylib("stdc");
+    if (!stdcLibExpected)
+    {
+        consumeError(stdcLibExpected.takeError());
+        return SLANG_FAIL;
+    }
+
+    auto& stdcLib = *stdcLibExpected;
+
+    // Add all the symbolmap
+    SymbolMap symbolMap;
+
+    // symbolMap.insert(std::make_pair(mangler("sin"),
+    // JITEvaluatedSymbol::fromPointer(static_cast<double (*)(double)>(&sin))));
+
+    {
+        static const NameAndFunc funcs[] = {
+            SLANG_LLVM_FUNCS(SLANG_LLVM_FUNC) SLANG_PLATFORM_FUNCS(SLANG_LLVM_FUNC)};
+
+        for (auto& func : funcs)
+        {
+            symbolMap.insert(
+                std::make_pair(mangler(func.name), JITEvaluatedSymbol::fromPointer(func.func)));
+        }
+    }
+
+#if SLANG_PTR_IS_32 && SLANG_VC
+    {
+        // https://docs.microsoft.com/en-us/windows/win32/devnotes/-win32-alldiv
+        symbolMap.insert(std::make_pair(
+            mangler("_alldiv"),
+            JITEvaluatedSymbol::fromPointer(WinSpecific::_alldiv)));
+        symbolMap.insert(std::make_pair(
+            mangler("_allrem"),
+            JITEvaluatedSymbol::fromPointer(WinSpecific::_allrem)));
+        symbolMap.insert(std::make_pair(
+            mangler("_aullrem"),
+            JITEvaluatedSymbol::fromPointer(WinSpecific::_aullrem)));
+        symbolMap.insert(std::make_pair(
+            mangler("_aulldiv"),
+            JITEvaluatedSymbol::fromPointer(WinSpecific::_aulldiv)));
+    }
+#endif
+
+    if (auto err = stdcLib.define(absoluteSymbols(symbolMap)))
+    {
+        consumeError(std::move(err));
+        return SLANG_FAIL;
+    }
+
+    m_stdcLib = &stdcLib;
+    return SLANG_OK;
+}
+
+SlangResult LLVMJITSession::addModule(ThreadSafeModule module, JITDylib*& outDylib)
+{
+    JITDylib* dylib = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        StringBuilder name;
+        name << "module" << m_dylibCounter++;
+
+        auto dylibExpected = m_jit->createJITDylib(name.getBuffer());
+        if (!dylibExpected)
+        {
+            consumeError(dylibExpected.takeError());
+            return SLANG_FAIL;
+        }
+        dylib = &*dylibExpected;
+    }
+
+    // Required or the symbols won't be found
+    dylib->addToLinkOrder(*m_stdcLib);
+
+    if (auto err = m_jit->addIRModule(*dylib, std::move(module)))
+    {
+        consumeError(std::move(err));
+        removeDylib(dylib);
+        return SLANG_FAIL;
+    }
+
+    if (auto err = m_jit->initialize(*dylib))
+    {
+        consumeError(std::move(err));
+        removeDylib(dylib);
+        return SLANG_FAIL;
+    }
+
+    outDylib = dylib;
+    return SLANG_OK;
+}
+
+void LLVMJITSession::removeDylib(JITDylib* dylib)
+{
+    if (auto err = m_jit->deinitialize(*dylib))
+    {
+        consumeError(std::move(err));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto err = m_jit->getExecutionSession().removeJITDylib(*dylib))
+    {
+        consumeError(std::move(err));
+    }
+}
+
+void* LLVMJITSession::findSymbolAddress(JITDylib* dylib, const char* name)
+{
+    auto fnExpected = m_jit->lookup(*dylib, name);
+    if (fnExpected)
+    {
+        auto fn = std::move(*fnExpected);
+        return (void*)fn.getAddress();
+    }
+    consumeError(fnExpected.takeError());
+    return nullptr;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!! LLVMJITSharedLibrary !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* This implementation uses atomic ref counting to ensure the shared libraries lifetime can outlive
+the LLVMDownstreamCompileResult and the compilation that created it */
+class LLVMJITSharedLibrary : public ISlangSharedLibrary, public ComBaseObject
+{
+public:
+    // ISlangUnknown
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    /// ICastable
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const Guid& guid) SLANG_OVERRIDE;
+
+    // ISlangSharedLibrary impl
+    virtual SLANG_NO_THROW void* SLANG_MCALL findSymbolAddressByName(char const* name)
+        SLANG_OVERRIDE;
+
+    LLVMJITSharedLibrary(std::shared_ptr<LLVMJITSession> session, JITDylib* dylib)
+        : m_session(std::move(session)), m_dylib(dylib)
+    {
+    }
+
+    ~LLVMJITSharedLibrary() { m_session->removeDylib(m_dylib); }
+
+protected:
+    ISlangUnknown* getInterface(const SlangUUID& uuid);
+    void* getObject(const SlangUUID& uuid);
+
+    std::shared_ptr<LLVMJITSession> m_session;
+    JITDylib* m_dylib;
+};
+
+ISlangUnknown* LLVMJITSharedLibrary::getInterface(const SlangUUID& guid)
+{
+    if (guid == ISlangUnknown::getTypeGuid() || guid == ISlangCastable::getTypeGuid() ||
+        guid == ISlangSharedLibrary::getTypeGuid())
+    {
+        return static_cast<ISlangSharedLibrary*>(this);
+    }
+    return nullptr;
+}
+
+void* LLVMJITSharedLibrary::getObject(const SlangUUID& uuid)
+{
+    SLANG_UNUSED(uuid);
+    return nullptr;
+}
+
+void* LLVMJITSharedLibrary::castAs(const Guid& guid)
+{
+    if (auto ptr = getInterface(guid))
+    {
+        return ptr;
+    }
+    return getObject(guid);
+}
+
+void* LLVMJITSharedLibrary::findSymbolAddressByName(char const* name)
+{
+    return m_session->findSymbolAddress(m_dylib, name);
+}
+
+/* !!!!!!!!!!!!!!!!!!!!! LLVMPreambleCache !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+// The C++ emitter outputs this directly after the prelude (see CPPSourceEmitter::emitPreModuleImpl)
+static const char kPreludeEndMarker[] =
+    "#ifdef SLANG_PRELUDE_NAMESPACE\nusing namespace SLANG_PRELUDE_NAMESPACE;\n";
+
+/// Returns the size of the prelude at the start of the source, or 0 if it can't be determined.
+static Index _findPreambleSize(const UnownedStringSlice& source)
+{
+    const Index index = source.indexOf(UnownedStringSlice(kPreludeEndMarker));
+    // The preamble must end at the start of a line
+    if (index <= 0 || source[index - 1] != '\n')
+    {
+        return 0;
+    }
+    return index;
+}
+
+/// Hash of all of the options that can change the result of compiling the preamble
+static HashCode64 _calcPreambleOptionsHash(
+    const DownstreamCompileOptions& options,
+    LangStandard::Kind langStd)
+{
+    Hasher hasher;
+    hasher.hashValue(Int(options.sourceLanguage));
+    hasher.hashValue(Int(langStd));
+    hasher.hashValue(Int(options.optimizationLevel));
+    hasher.hashValue(Int(options.floatingPointMode));
+
+    for (const auto& define : options.defines)
+    {
+        hasher.hashValue(asStringSlice(define.nameWithSig));
+        hasher.hashValue(asStringSlice(define.value));
+    }
+    for (const auto& includePath : options.includePaths)
+    {
+        hasher.hashValue(asStringSlice(includePath));
+    }
+    return hasher.getResult();
+}
+
+std::shared_ptr<PrecompiledPreamble> LLVMPreambleCache::findOrCreate(
+    const CompilerInvocation& invocation,
+    const llvm::MemoryBuffer& sourceBuffer,
+    Index preambleSize,
+    HashCode64 optionsHash,
+    IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem)
+{
+    const UnownedStringSlice preambleText(sourceBuffer.getBufferStart(), preambleSize);
+
+    // NOTE! The lock is held whilst building, such that concurrent compilations with the same
+    // prelude don't each build their own preamble.
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (Index i = 0; i < m_entries.getCount(); ++i)
+    {
+        const auto& entry = m_entries[i];
+        if (entry.optionsHash == optionsHash && entry.text.getUnownedSlice() == preambleText)
+        {
+            Entry found = entry;
+            // Make most recently used
+            m_entries.removeAt(i);
+            m_entries.add(found);
+            return found.preamble;
+        }
+    }
+
+    // Diagnostics from building the preamble are ignored. If the build fails, the source is
+    // compiled without a preamble, and will report any problems then.
+    IgnoringDiagConsumer ignoringDiagConsumer;
+    IntrusiveRefCntPtr<DiagnosticsEngine> diags = new DiagnosticsEngine(
+        new DiagnosticIDs(),
+        new DiagnosticOptions(),
+        &ignoringDiagConsumer,
+        false);
+
+    PreambleCallbacks callbacks;
+
+    const bool storeInMemory = true;
+    auto preambleExpected = PrecompiledPreamble::Build(
+        invocation,
+        &sourceBuffer,
+        PreambleBounds(unsigned(preambleSize), true),
+        *diags,
+        fileSystem,
+        std::make_shared<PCHContainerOperations>(),
+        storeInMemory,
+        callbacks);
+
+    if (!preambleExpected)
+    {
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.optionsHash = optionsHash;
+    entry.text = preambleText;
+    entry.preamble = std::make_shared<PrecompiledPreamble>(std::move(*preambleExpected));
+
+    if (m_entries.getCount() >= kMaxEntries)
+    {
+        m_entries.removeAt(0);
+    }
+    m_entries.add(entry);
+
+    return entry.preamble;
+}
+
 bool LLVMDownstreamCompiler::canConvert(const ArtifactDesc& from, const ArtifactDesc& to)
 {
     return false;
@@ -622,6 +990,19 @@ void* LLVMDownstreamCompiler::getObject(const Guid& guid)
     return nullptr;
 }
 
+SlangResult LLVMDownstreamCompiler::_getJITSession(
+    std::shared_ptr<LLVMJITSession>& outSession,
+    std::string& outError)
+{
+    std::lock_guard<std::mutex> lock(m_jitSessionMutex);
+    if (!m_jitSession)
+    {
+        SLANG_RETURN_ON_FAIL(LLVMJITSession::create(m_jitSession, outError));
+    }
+    outSession = m_jitSession;
+    return SLANG_OK;
+}
+
 SlangResult LLVMDownstreamCompiler::compile(
     const CompileOptions& inOptions,
     IArtifact** outArtifact)
@@ -672,7 +1053,10 @@ SlangResult LLVMDownstreamCompiler::compile(
     const auto sourceSlice = StringUtil::getSlice(sourceBlob);
     StringRef sourceStringRef(sourceSlice.begin(), sourceSlice.getLength());
 
-    auto sourceBuffer = llvm::MemoryBuffer::getMemBuffer(sourceStringRef);
+    // The source is presented to clang as a file with this name, with the contents remapped to the
+    // sourceBuffer. Doing so allows a precompiled preamble to be used.
+    const char* sourcePath = "slang-llvm-source";
+    auto sourceBuffer = llvm::MemoryBuffer::getMemBuffer(sourceStringRef, sourcePath);
 
     auto& invocation = clang->getInvocation();
 
@@ -728,13 +1112,11 @@ SlangResult LLVMDownstreamCompiler::compile(
         auto& opts = invocation.getFrontendOpts();
 
         // Add the source
-        // TODO(JS): For the moment this kind of include does *NOT* show a input source filename
-        // not super surprising as one isn't set, but it's not clear how one would be set when the
-        // input is a memory buffer. For Slang usage, this probably isn't an issue, because it's
-        // *output* typically holds #line directives.
+        // NOTE! The file doesn't exist, the contents are remapped to the source buffer below. For
+        // Slang usage the file name isn't an issue, because it's *output* typically holds #line
+        // directives.
         {
-
-            FrontendInputFile inputFile(*sourceBuffer, inputKind);
+            FrontendInputFile inputFile(sourcePath, inputKind);
             opts.Inputs.push_back(inputFile);
         }
 
@@ -822,6 +1204,41 @@ SlangResult LLVMDownstreamCompiler::compile(
         opts.CodeModel = invocation.getTargetOpts().CodeModel;
     }
 
+    IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem = llvm::vfs::getRealFileSystem();
+
+    // If the source starts with the prelude, use a precompiled preamble for it.
+    //
+    // NOTE! This must be done before the source buffer is remapped, as the preamble is built
+    // from a copy of the invocation.
+    std::shared_ptr<PrecompiledPreamble> preamble;
+    {
+        const Index preambleSize = _findPreambleSize(sourceSlice);
+        if (preambleSize > 0)
+        {
+            preamble = m_preambleCache.findOrCreate(
+                invocation,
+                *sourceBuffer,
+                preambleSize,
+                _calcPreambleOptionsHash(options, langStd),
+                fileSystem);
+        }
+    }
+
+    {
+        auto& opts = invocation.getPreprocessorOpts();
+
+        // The buffer is owned by sourceBuffer, so must not be freed by the compiler instance
+        opts.RetainRemappedFileBuffers = true;
+        opts.addRemappedFile(sourcePath, sourceBuffer.get());
+    }
+
+    if (preamble)
+    {
+        // Makes the compilation use the PCH, and skip over the preamble bytes in the source.
+        // May replace fileSystem with an overlay that contains the in memory PCH.
+        preamble->AddImplicitPreamble(invocation, fileSystem, sourceBuffer.get());
+    }
+
     // const llvm::opt::OptTable& opts = clang::driver::getDriverOptTable();
 
     // TODO(JS): Need a way to find in system search paths, for now we just don't bother
@@ -861,7 +1278,7 @@ SlangResult LLVMDownstreamCompiler::compile(
         return SLANG_FAIL;
 
     //
-    clang->createFileManager();
+    clang->createFileManager(fileSystem);
     clang->createSourceManager(clang->getFileManager());
 
 
@@ -958,42 +1375,11 @@ SlangResult LLVMDownstreamCompiler::compile(
     // I guess the idea is it's 'SHADER' style, but is runnable on the host.
     case SLANG_SHADER_HOST_CALLABLE:
         {
-            // Try running something in the module on the JIT
-            std::unique_ptr<llvm::orc::LLJIT> jit;
+            std::shared_ptr<LLVMJITSession> jitSession;
             {
-                // Create the JIT
-
-                LLJITBuilder jitBuilder;
-
-                Expected<std::unique_ptr<llvm::orc::LLJIT>> expectJit = jitBuilder.create();
-                if (!expectJit)
+                std::string jitErrorString;
+                if (SLANG_FAILED(_getJITSession(jitSession, jitErrorString)))
                 {
-                    /* JS: NOTE!
-
-                    It is worth saying there can be some odd issues around creating the JIT - if
-                    LLVM-C is linked against.
-
-                    If it is then LLVM will likely startup saying LLVM-C isn't found.
-                    BUT if you have LLVM *installed* on your system (as is reasonable to do from a
-                    LLVM distro, then at startup it *MIGHT* find a LLVM-C dll in that installation
-                    (ie nothing to do with the version of LLVM linked with). This will likely lead
-                    to an odd error saying the 'triple can't be found' and that no targets are
-                    registered.
-
-                    Also note that the behavior *may* be different with Debug/Release - because of
-                    how the linked resolves symbols that are multiply defined.
-
-                    If there are problems creating the JIT, check that LLVM-C is not linked against
-                    (it should be disabled in the premake).
-                    */
-
-                    auto err = expectJit.takeError();
-
-                    std::string jitErrorString;
-                    llvm::raw_string_ostream jitErrorStream(jitErrorString);
-
-                    jitErrorStream << err;
-
                     ArtifactDiagnostic diagnostic;
 
                     StringBuilder buf;
@@ -1014,87 +1400,16 @@ SlangResult LLVMDownstreamCompiler::compile(
                     *outArtifact = artifact.detach();
                     return SLANG_OK;
                 }
-                jit = std::move(*expectJit);
-            }
-
-            // Used the following link to test this out
-            // https://www.llvm.org/docs/ORCv2.html
-            // https://www.llvm.org/docs/ORCv2.html#processandlibrarysymbols
-
-            {
-                auto& es = jit->getExecutionSession();
-
-                const DataLayout& dl = jit->getDataLayout();
-                MangleAndInterner mangler(es, dl);
-
-                // The name of the lib must be unique. Should be here as we are only thing adding
-                // libs
-                auto stdcLibExpected = es.createJITDylib("stdc");
-
-                if (stdcLibExpected)
-                {
-                    auto& stdcLib = *stdcLibExpected;
-
-                    // Add all the symbolmap
-                    SymbolMap symbolMap;
-
-                    // symbolMap.insert(std::make_pair(mangler("sin"),
-                    // JITEvaluatedSymbol::fromPointer(static_cast<double (*)(double)>(&sin))));
-
-                    {
-                        static const NameAndFunc funcs[] = {SLANG_LLVM_FUNCS(
-                            SLANG_LLVM_FUNC) SLANG_PLATFORM_FUNCS(SLANG_LLVM_FUNC)};
-
-                        for (auto& func : funcs)
-                        {
-                            symbolMap.insert(std::make_pair(
-                                mangler(func.name),
-                                JITEvaluatedSymbol::fromPointer(func.func)));
-                        }
-                    }
-
-#if SLANG_PTR_IS_32 && SLANG_VC
-                    {
-                        // https://docs.microsoft.com/en-us/windows/win32/devnotes/-win32-alldiv
-                        symbolMap.insert(std::make_pair(
-                            mangler("_alldiv"),
-                            JITEvaluatedSymbol::fromPointer(WinSpecific::_alldiv)));
-                        symbolMap.insert(std::make_pair(
-                            mangler("_allrem"),
-                            JITEvaluatedSymbol::fromPointer(WinSpecific::_allrem)));
-                        symbolMap.insert(std::make_pair(
-                            mangler("_aullrem"),
-                            JITEvaluatedSymbol::fromPointer(WinSpecific::_aullrem)));
-                        symbolMap.insert(std::make_pair(
-                            mangler("_aulldiv"),
-                            JITEvaluatedSymbol::fromPointer(WinSpecific::_aulldiv)));
-                    }
-#endif
-
-                    if (auto err = stdcLib.define(absoluteSymbols(symbolMap)))
-                    {
-                        return SLANG_FAIL;
-                    }
-
-                    // Required or the symbols won't be found
-                    jit->getMainJITDylib().addToLinkOrder(stdcLib);
-                }
             }
 
             ThreadSafeModule threadSafeModule(std::move(module), std::move(llvmContext));
 
-            if (auto err = jit->addIRModule(std::move(threadSafeModule)))
-            {
-                return SLANG_FAIL;
-            }
-
-            if (auto err = jit->initialize(jit->getMainJITDylib()))
-            {
-                return SLANG_FAIL;
-            }
+            JITDylib* dylib = nullptr;
+            SLANG_RETURN_ON_FAIL(jitSession->addModule(std::move(threadSafeModule), dylib));
 
             // Create the shared library
-            ComPtr<ISlangSharedLibrary> sharedLibrary(new LLVMJITSharedLibrary(std::move(jit)));
+            ComPtr<ISlangSharedLibrary> sharedLibrary(
+                new LLVMJITSharedLibrary(std::move(jitSession), dylib));
 
             // Work out the ArtifactDesc
             const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
@@ -243,6 +243,7 @@ SLANG_API void slang_shutdown()
     Slang::SPIRVCoreGrammarInfo::freeEmbeddedGrammerInfo();
     Slang::RttiInfo::deallocateAll();
     Slang::freeCapabilityDefs();
+    Slang::freeCapabilitySetCache();
 }
 
 SLANG_API SlangResult slang_createGlobalSessionWithoutCoreModule(
@@ -480,6 +480,14 @@ protected:
 private:
     mutable Val* m_resolvedVal = nullptr;
     SLANG_UNREFLECTED mutable Index m_resolvedValEpoch = 0;
+    /// The id of the ASTBuilder `m_resolvedVal` was resolved with. Vals such as those of the core
+    /// module are shared between linkages, and each linkage resolves them with its own ASTBuilder,
+    /// so a resolution is only reused by the ASTBuilder that made it.
+    SLANG_UNREFLECTED mutable Index m_resolvedValASTBuilderId = 0;
+    /// If `m_resolvedVal` doesn't depend on anything that changes between epochs, the ASTBuilder
+    /// generation it was resolved in, otherwise 0. It stays valid in later epochs of the same
+    /// generation.
+    SLANG_UNREFLECTED mutable Index m_resolvedValStableGeneration = 0;
 };
 
 template<int N, typename T, typename... Ts>
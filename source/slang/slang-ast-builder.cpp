@@ -248,6 +248,7 @@ ASTBuilder::~ASTBuilder()
         nodeClass.destructInstance(node);
     }
     incrementEpoch();
+    getSharedASTBuilder()->m_session->m_astBuilderGenerationId++;
 }
 
 Index ASTBuilder::getEpoch()
@@ -260,6 +261,11 @@ void ASTBuilder::incrementEpoch()
     getSharedASTBuilder()->m_session->m_epochId++;
 }
 
+Index ASTBuilder::getGeneration()
+{
+    return getSharedASTBuilder()->m_session->m_astBuilderGenerationId;
+}
+
 NodeBase* ASTBuilder::createByNodeType(ASTNodeType nodeType)
 {
     auto syntaxClass = SyntaxClass<NodeBase>(nodeType);
@@ -13,6 +13,25 @@
 namespace Slang
 {
 
+/// Counters for `Val::resolve`, reported by `-report-perf-benchmark`
+struct ValResolveStats
+{
+    /// Average depth of nested resolutions at which a val had to be resolved
+    double getAverageChainDepth() const
+    {
+        return resolveImplCount ? double(chainDepthSum) / double(resolveImplCount) : 0.0;
+    }
+
+    void clear() { *this = ValResolveStats(); }
+
+    uint64_t resolveCount = 0;     ///< Calls to `Val::resolve` in a checking context
+    uint64_t hitCount = 0;         ///< Resolved in the current epoch
+    uint64_t stableHitCount = 0;   ///< Resolved in an earlier epoch, but not dependent on it
+    uint64_t resolveImplCount = 0; ///< Had to be resolved
+    uint64_t chainDepthSum = 0;
+    uint64_t maxChainDepth = 0;
+};
+
 class SharedASTBuilder : public RefObject
 {
     friend class ASTBuilder;
@@ -73,6 +92,8 @@ public:
 
     ASTBuilder* getInnerASTBuilder() { return m_astBuilder; }
 
+    ValResolveStats& getValResolveStats() { return m_valResolveStats; }
+
     Name* getThisTypeName()
     {
         if (!m_thisTypeName)
@@ -122,6 +143,8 @@ protected:
     ASTBuilder* m_astBuilder = nullptr;
     Session* m_session = nullptr;
 
+    ValResolveStats m_valResolveStats;
+
     Index m_id = 1;
 };
 
@@ -264,6 +287,9 @@ public:
 
     void incrementEpoch();
 
+    /// Incremented whenever an ASTBuilder is destroyed
+    Index getGeneration();
+
     MemoryArena& getArena() { return m_arena; }
 
     NamePool* getNamePool() { return getSharedASTBuilder()->getNamePool(); }
@@ -716,6 +742,11 @@ ASTBuilder* getCurrentASTBuilder();
 // Sets the ASTBuilder for the current compilation session.
 void setCurrentASTBuilder(ASTBuilder* astBuilder);
 
+// Note that the val being resolved on this thread depends on state that can change when the epoch
+// is incremented (such as the contents of witness tables), so its resolution can only be reused
+// within the current epoch.
+void markValResolveDependsOnEpoch();
+
 struct SetASTBuilderContextRAII
 {
     ASTBuilder* previousASTBuilder = nullptr;
@@ -55,20 +55,66 @@ Val* Val::resolveImpl()
     SLANG_AST_NODE_VIRTUAL_CALL(Val, resolveImpl, ());
 }
 
+// Set whilst resolving a val if its resolution depends on the epoch
+static thread_local bool gValResolveDependsOnEpoch = false;
+// The number of nested `Val::resolveImpl` calls on this thread
+static thread_local uint32_t gValResolveDepth = 0;
+
+void markValResolveDependsOnEpoch()
+{
+    gValResolveDependsOnEpoch = true;
+}
+
 Val* Val::resolve()
 {
     auto astBuilder = getCurrentASTBuilder();
     // If we are not in a proper checking context, just return the previously resolved val.
     if (!astBuilder)
         return m_resolvedVal ? m_resolvedVal : this;
-    if (m_resolvedVal && m_resolvedValEpoch == astBuilder->getEpoch())
+
+    // Vals are deduplicated, so the resolved val cached on the node is shared by every use of
+    // the same val. It is kept across epochs if it didn't depend on them, but not across the
+    // destruction of an ASTBuilder, which may own it. It is only used by the ASTBuilder that
+    // resolved it, as the resolved val is owned by that ASTBuilder's linkage.
+    auto& stats = astBuilder->getSharedASTBuilder()->getValResolveStats();
+    stats.resolveCount++;
+    if (m_resolvedVal && m_resolvedValASTBuilderId == astBuilder->getId())
     {
         SLANG_ASSERT(as<Val>(m_resolvedVal));
-        return m_resolvedVal;
+        if (m_resolvedValEpoch == astBuilder->getEpoch())
+        {
+            stats.hitCount++;
+            if (!m_resolvedValStableGeneration)
+                markValResolveDependsOnEpoch();
+            return m_resolvedVal;
+        }
+        if (m_resolvedValStableGeneration &&
+            m_resolvedValStableGeneration == astBuilder->getGeneration())
+        {
+            stats.stableHitCount++;
+            return m_resolvedVal;
+        }
     }
     // Update epoch now to avoid infinite recursion.
     m_resolvedValEpoch = astBuilder->getEpoch();
+    m_resolvedValASTBuilderId = astBuilder->getId();
+    m_resolvedValStableGeneration = 0;
+
+    // Track if anything resolved along the way depends on the epoch. If so, so does this val
+    // and anything being resolved that uses it.
+    const bool outerDependsOnEpoch = gValResolveDependsOnEpoch;
+    gValResolveDependsOnEpoch = false;
+
+    const uint32_t depth = ++gValResolveDepth;
+    stats.resolveImplCount++;
+    stats.chainDepthSum += depth;
+    stats.maxChainDepth = Math::Max(stats.maxChainDepth, uint64_t(depth));
+
     m_resolvedVal = resolveImpl();
+
+    gValResolveDepth--;
+    m_resolvedValStableGeneration = gValResolveDependsOnEpoch ? 0 : astBuilder->getGeneration();
+    gValResolveDependsOnEpoch = outerDependsOnEpoch || gValResolveDependsOnEpoch;
 #ifdef _DEBUG
     if (m_resolvedVal->_debugUID > 0 && this->_debugUID < 0)
     {
@@ -81,8 +127,10 @@ Val* Val::resolve()
 
 void Val::_setUnique()
 {
+    auto astBuilder = getCurrentASTBuilder();
     m_resolvedVal = this;
-    m_resolvedValEpoch = getCurrentASTBuilder()->getEpoch();
+    m_resolvedValEpoch = astBuilder->getEpoch();
+    m_resolvedValASTBuilderId = astBuilder->getId();
 }
 
 Val* Val::defaultResolveImpl()
@@ -3,6 +3,8 @@
 
 #include "../core/slang-dictionary.h"
 
+#include <atomic>
+
 // This file implements the core of the "capability" system.
 
 namespace Slang
@@ -267,6 +269,68 @@ CapabilityAtomSet CapabilityAtomSet::newSetWithoutImpliedAtoms() const
     return simplifiedSet;
 }
 
+//// CapabilitySetCache
+
+// Expanding a capability name into a `CapabilitySet` permutes its canonical representation
+// over every target and stage, and capability checking does so for most decls and call sites
+// it visits. The expansion only depends on the name, so each name is only expanded once.
+//
+// Sets that come from the cache carry an id, as do the results of joining two such sets,
+// which allows the results of `join` and `implies` between them to be memoized.
+//
+// Capability checks run on every compiling thread, so none of this takes a lock. A name's set
+// is published once with an atomic compare-exchange and never changes afterwards, and the
+// memoized results are held per thread.
+struct CapabilitySetCache
+{
+    /// The expanded set for each name, created on first use.
+    std::atomic<CapabilitySet*> nameSets[Index(CapabilityName::Count)] = {};
+
+    /// The id to give the next interned set. 0 means "not interned".
+    std::atomic<uint32_t> nextId{1};
+
+    uint32_t allocateId() { return nextId.fetch_add(1, std::memory_order_relaxed); }
+
+    static CapabilitySetCache& get()
+    {
+        static CapabilitySetCache cache;
+        return cache;
+    }
+};
+
+// The results of `join` and `implies` between interned sets, keyed on the ids of the two
+// operands. Ids are unique across threads, so a result memoized on one thread is valid on any.
+struct CapabilitySetMemo
+{
+    /// Stop memoizing new results beyond this many, so the memo can't grow without bound.
+    static const Index kMaxMemoizedResultCount = 64 * 1024;
+
+    Dictionary<uint64_t, CapabilitySet> joinResults;
+    Dictionary<uint64_t, bool> impliesResults;
+
+    static uint64_t makeKey(uint32_t a, uint32_t b) { return (uint64_t(a) << 32) | b; }
+
+    static CapabilitySetMemo& get()
+    {
+        thread_local CapabilitySetMemo memo;
+        return memo;
+    }
+};
+
+void freeCapabilitySetCache()
+{
+    auto& cache = CapabilitySetCache::get();
+    for (auto& nameSet : cache.nameSets)
+    {
+        delete nameSet.exchange(nullptr);
+    }
+    // Ids are never reused, so any sets still holding an id just miss the cache from now on.
+    // The results memoized by other threads are freed when those threads exit.
+    auto& memo = CapabilitySetMemo::get();
+    memo.joinResults = Dictionary<uint64_t, CapabilitySet>();
+    memo.impliesResults = Dictionary<uint64_t, bool>();
+}
+
 //// CapabiltySet
 
 CapabilityAtom getTargetAtomInSet(const CapabilityAtomSet& atomSet)
@@ -327,6 +391,8 @@ void CapabilitySet::addConjunction(
     CapabilityAtom knownTargetAtom,
     CapabilityAtom knownStageAtom)
 {
+    m_internedId = 0;
+
     if (knownTargetAtom == CapabilityAtom::Invalid)
     {
         knownTargetAtom = getTargetAtomInSet(conjunction);
@@ -397,9 +463,38 @@ CapabilitySet::CapabilitySet(Int atomCount, CapabilityName const* atoms)
 }
 
 CapabilitySet::CapabilitySet(CapabilityName atom)
+    : CapabilitySet(_getNameSet(atom))
+{
+}
+
+CapabilitySet CapabilitySet::_expandName(CapabilityName name)
+{
+    CapabilitySet result;
+    result.m_targetSets.reserve(kCapabilityTargetCount);
+    result.addUnexpandedCapabilites(name);
+    return result;
+}
+
+const CapabilitySet& CapabilitySet::_getNameSet(CapabilityName name)
 {
-    this->m_targetSets.reserve(kCapabilityTargetCount);
-    addUnexpandedCapabilites(atom);
+    SLANG_ASSERT(Int(name) < Int(CapabilityName::Count));
+
+    auto& cache = CapabilitySetCache::get();
+    auto& slot = cache.nameSets[Index(name)];
+    if (auto nameSet = slot.load(std::memory_order_acquire))
+        return *nameSet;
+
+    auto nameSet = new CapabilitySet(_expandName(name));
+    nameSet->m_internedId = cache.allocateId();
+
+    CapabilitySet* publishedSet = nullptr;
+    if (!slot.compare_exchange_strong(publishedSet, nameSet, std::memory_order_acq_rel))
+    {
+        // Another thread expanded the name first. Use its set, so every thread sees one id.
+        delete nameSet;
+        return *publishedSet;
+    }
+    return *nameSet;
 }
 
 CapabilitySet::CapabilitySet(List<CapabilityName> const& atoms)
@@ -443,16 +538,14 @@ bool CapabilitySet::isIncompatibleWith(CapabilityAtom other) const
     if (isEmpty())
         return false;
 
-    CapabilitySet otherSet((CapabilityName)other);
-    return isIncompatibleWith(otherSet);
+    return isIncompatibleWith(_getNameSet((CapabilityName)other));
 }
 
 bool CapabilitySet::isIncompatibleWith(CapabilityName other) const
 {
     if (isEmpty())
         return false;
-    auto otherSet = CapabilitySet(other);
-    return isIncompatibleWith(otherSet);
+    return isIncompatibleWith(_getNameSet(other));
 }
 
 bool CapabilitySet::isIncompatibleWith(CapabilitySet const& other) const
@@ -508,9 +601,7 @@ bool CapabilitySet::implies(CapabilityAtom atom) const
     if (isEmpty() || atom == CapabilityAtom::Invalid)
         return false;
 
-    CapabilitySet tmpSet = CapabilitySet(CapabilityName(atom));
-
-    return this->implies(tmpSet);
+    return this->implies(_getNameSet(CapabilityName(atom)));
 }
 
 CapabilitySet::ImpliesReturnFlags CapabilitySet::_implies(
@@ -574,8 +665,23 @@ CapabilitySet::ImpliesReturnFlags CapabilitySet::_implies(
 
 bool CapabilitySet::implies(CapabilitySet const& other) const
 {
-    return (int)_implies(other, ImpliesFlags::None) &
-           (int)CapabilitySet::ImpliesReturnFlags::Implied;
+    if (!m_internedId || !other.m_internedId)
+    {
+        return (int)_implies(other, ImpliesFlags::None) &
+               (int)CapabilitySet::ImpliesReturnFlags::Implied;
+    }
+
+    auto& memo = CapabilitySetMemo::get();
+    const auto key = CapabilitySetMemo::makeKey(m_internedId, other.m_internedId);
+    if (auto found = memo.impliesResults.tryGetValue(key))
+        return *found;
+
+    const bool result = (int)_implies(other, ImpliesFlags::None) &
+                        (int)CapabilitySet::ImpliesReturnFlags::Implied;
+
+    if (Index(memo.impliesResults.getCount()) < CapabilitySetMemo::kMaxMemoizedResultCount)
+        memo.impliesResults.set(key, result);
+    return result;
 }
 CapabilitySet::ImpliesReturnFlags CapabilitySet::atLeastOneSetImpliedInOther(
     CapabilitySet const& other) const
@@ -602,6 +708,7 @@ void CapabilitySet::unionWith(const CapabilitySet& other)
     if (this->isInvalid() || other.isInvalid())
         return;
 
+    m_internedId = 0;
     this->m_targetSets.reserve(other.m_targetSets.getCount());
     for (auto otherTargetSet : other.m_targetSets)
     {
@@ -624,8 +731,10 @@ void CapabilitySet::nonDestructiveJoin(const CapabilitySet& other)
     if (this->isEmpty())
     {
         this->m_targetSets = other.m_targetSets;
+        this->m_internedId = other.m_internedId;
         return;
     }
+    m_internedId = 0;
     for (auto& thisTargetSet : this->m_targetSets)
     {
         thisTargetSet.second.tryJoin(other.m_targetSets);
@@ -634,6 +743,9 @@ void CapabilitySet::nonDestructiveJoin(const CapabilitySet& other)
 
 bool CapabilitySet::operator==(CapabilitySet const& that) const
 {
+    if (m_internedId && m_internedId == that.m_internedId)
+        return true;
+
     for (auto set : this->m_targetSets)
     {
         auto thatSet = that.m_targetSets.tryGetValue(set.first);
@@ -719,6 +831,31 @@ bool CapabilityTargetSet::tryJoin(const CapabilityTargetSets& other)
 }
 
 void CapabilitySet::join(const CapabilitySet& other)
+{
+    if (!m_internedId || !other.m_internedId)
+    {
+        _join(other);
+        return;
+    }
+
+    auto& memo = CapabilitySetMemo::get();
+    const auto key = CapabilitySetMemo::makeKey(m_internedId, other.m_internedId);
+    if (auto found = memo.joinResults.tryGetValue(key))
+    {
+        *this = *found;
+        return;
+    }
+
+    _join(other);
+
+    // The result is only interned already if it is one of the operands unchanged.
+    if (!m_internedId)
+        m_internedId = CapabilitySetCache::get().allocateId();
+    if (Index(memo.joinResults.getCount()) < CapabilitySetMemo::kMaxMemoizedResultCount)
+        memo.joinResults.set(key, *this);
+}
+
+void CapabilitySet::_join(const CapabilitySet& other)
 {
     if (this->isEmpty() || other.isInvalid())
     {
@@ -730,6 +867,8 @@ void CapabilitySet::join(const CapabilitySet& other)
     if (other.isEmpty())
         return;
 
+    m_internedId = 0;
+
     List<CapabilityAtom> destroySet;
     destroySet.reserve(this->m_targetSets.getCount());
     for (auto& thisTargetSet : this->m_targetSets)
@@ -1052,6 +1191,8 @@ inline CapabilityName maybeConvertSpirvVersionToGlslSpirvVersion(CapabilityName&
 
 void CapabilitySet::addSpirvVersionFromOtherAsGlslSpirvVersion(CapabilitySet& other)
 {
+    m_internedId = 0;
+
     if (auto* otherTargetSet = other.m_targetSets.tryGetValue(CapabilityAtom::spirv))
     {
         auto* thisTargetSet = m_targetSets.tryGetValue(CapabilityAtom::glsl);
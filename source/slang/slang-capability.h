@@ -210,7 +210,12 @@ public:
         CapabilityAtom knownStage);
     inline void addUnexpandedCapabilites(CapabilityName atom);
 
-    CapabilityTargetSets& getCapabilityTargetSets() { return m_targetSets; }
+    CapabilityTargetSets& getCapabilityTargetSets()
+    {
+        // The caller may modify the set, so it no longer matches its interned identity
+        m_internedId = 0;
+        return m_targetSets;
+    }
     const CapabilityTargetSets& getCapabilityTargetSets() const { return m_targetSets; }
 
     // If this capability set uniquely implies one stage atom, return it. Otherwise returns
@@ -324,6 +329,17 @@ private:
     /// underlying data of CapabilitySet.
     CapabilityTargetSets m_targetSets{};
 
+    /// Identifies the contents of this set in the global capability set cache, so the
+    /// results of `join` and `implies` between cached sets can be memoized.
+    /// 0 if the set did not come from the cache, or has been modified since.
+    uint32_t m_internedId = 0;
+
+    /// Expand the canonical representation of `name` over all of its targets and stages.
+    static CapabilitySet _expandName(CapabilityName name);
+    /// Get the (interned) set for `name`, which is only expanded once per process.
+    static const CapabilitySet& _getNameSet(CapabilityName name);
+    void _join(const CapabilitySet& other);
+
     void addCapability(CapabilityName name);
 
     bool hasSameTargets(const CapabilitySet& other) const;
@@ -378,6 +394,9 @@ bool hasTargetAtom(const CapabilityAtomSet& setIn, CapabilityAtom& targetAtom);
 
 void freeCapabilityDefs();
 
+/// Free the sets and memoized results cached by `CapabilitySet`.
+void freeCapabilitySetCache();
+
 // #define UNIT_TEST_CAPABILITIES
 #ifdef UNIT_TEST_CAPABILITIES
 void TEST_CapabilitySet();
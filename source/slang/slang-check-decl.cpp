@@ -1423,9 +1423,15 @@ bool SemanticsVisitor::shouldSkipChecking(Decl* decl, DeclCheckState state)
     {
         return false;
     }
+    auto& assistInfo = getLinkage()->contentAssistInfo;
+    // Once the request is cancelled nothing more needs checking.
+    if (assistInfo.isCancelRequested())
+    {
+        assistInfo.checkingCancelled = true;
+        return true;
+    }
     if (auto funcDecl = as<FunctionDeclBase>(decl))
     {
-        auto& assistInfo = getLinkage()->contentAssistInfo;
         // If this func is not defined in the primary module, skip checking its body.
         auto moduleDecl = getModuleDecl(decl);
         if (moduleDecl && moduleDecl->module->getNameObj() != assistInfo.primaryModuleName &&
@@ -6,7 +6,9 @@
 #include "slang-check-impl.h"
 #include "slang-compiler.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-link.h"
 #include "slang-ir-util.h"
+#include "slang-serialize-container.h"
 
 namespace Slang
 {
@@ -227,6 +229,161 @@ Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnos
     return SLANG_OK;
 }
 
+// Only snapshot functions:
+// 1) With function bodies, that aren't generic
+// 2) Not marked with unsafeForceInlineDecoration, as they are inlined before linking
+// 3) That aren't entry points, which are specialized for each program
+// 4) That don't take part in automatic differentiation, whose passes need the
+//    original form of the code
+static bool attemptTargetIRSnapshot(IRInst* inst)
+{
+    auto func = as<IRFunc>(inst);
+    if (!func || !func->getFirstBlock())
+    {
+        return false;
+    }
+
+    if (!func->findDecoration<IRExportDecoration>())
+    {
+        return false;
+    }
+
+    for (auto decoration : func->getDecorations())
+    {
+        switch (decoration->getOp())
+        {
+        case kIROp_UnsafeForceInlineEarlyDecoration:
+        case kIROp_EntryPointDecoration:
+            return false;
+        default:
+            if (isAutoDiffDecoration(decoration))
+            {
+                return false;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+/*
+ * Embed a snapshot of the IR of the module's functions, linked for the given
+ * target, in the module IR.
+ *
+ * Unlike `precompileForTarget`, the snapshot is Slang IR, so it can be used
+ * for any program compiled for the target. The functions are linked (which
+ * resolves target specific definitions and `__target_switch`), specialized
+ * and simplified. Target legalization can change the signatures of
+ * functions, so it is left for the program that is finally compiled.
+ *
+ * The snapshot only holds the bodies of the functions, and what only it
+ * defines (like specializations of generics). Everything else is resolved
+ * against the modules being linked when the snapshot is used. The linker
+ * prefers the snapshotted definitions (see `isBetterForTarget`) when linking
+ * for a target with the same capabilities and the same options (see
+ * `getTargetIRSnapshotOptionsDigest`). Snapshots are not made when debug
+ * information is requested, since they are stored without source locations.
+ */
+SlangResult Module::precompileTargetIR(TargetRequest* targetReq, DiagnosticSink* sink)
+{
+    auto module = getIRModule();
+    auto linkage = getLinkage();
+    auto builder = IRBuilder(module);
+
+    List<RefPtr<ComponentType>> allComponentTypes;
+    allComponentTypes.add(this);
+    auto composite = CompositeComponentType::create(linkage, allComponentTypes);
+    composite = fillRequirements(composite);
+
+    TargetProgram tp(composite, targetReq);
+
+    // The snapshot is stored without source locations, so it could never be used by a
+    // program that wants debug information.
+    if (tp.getOptionSet().getDebugInfoLevel() != DebugInfoLevel::None)
+    {
+        return SLANG_OK;
+    }
+
+    auto targetCaps = targetReq->getTargetCaps();
+    auto optionsDigest = getTargetIRSnapshotOptionsDigest(tp.getOptionSet());
+
+    // Don't precompile twice for the same target and options
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (auto inst = as<IREmbeddedTargetIR>(globalInst))
+        {
+            if (inst->getTarget() == targetReq->getTarget() &&
+                inst->getTargetCaps()->getCaps() == targetCaps &&
+                inst->getOptionsDigest()->getStringSlice() == optionsDigest.getUnownedSlice())
+            {
+                return SLANG_OK;
+            }
+        }
+    }
+
+    tp.getOrCreateLayout(sink);
+    tp.getOptionSet().add(CompilerOptionName::GenerateWholeProgram, true);
+
+    CodeGenContext::EntryPointIndices entryPointIndices;
+    CodeGenContext::Shared sharedCodeGenContext(&tp, entryPointIndices, sink, nullptr);
+    CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+    // Mark the functions to snapshot as exported, so they are linked.
+    List<IRInst*> markedFunctions;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (attemptTargetIRSnapshot(inst))
+        {
+            builder.addDecoration(inst, kIROp_DownstreamModuleExportDecoration);
+            markedFunctions.add(inst);
+        }
+    }
+    if (markedFunctions.getCount() == 0)
+    {
+        return SLANG_OK;
+    }
+
+    RefPtr<IRModule> snapshotModule;
+    SlangResult res = codeGenContext.emitTargetIRSnapshot(snapshotModule);
+
+    for (auto inst : markedFunctions)
+    {
+        if (auto dec = inst->findDecoration<IRDownstreamModuleExportDecoration>())
+        {
+            dec->removeAndDeallocate();
+        }
+    }
+
+    SLANG_RETURN_ON_FAIL(res);
+    if (!snapshotModule)
+    {
+        return SLANG_OK;
+    }
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(encodeModuleIRToBlob(snapshotModule, blob.writeRef()));
+
+    builder.setInsertInto(module);
+    builder.emitEmbeddedTargetIR(
+        targetReq->getTarget(),
+        targetCaps,
+        optionsDigest.getUnownedSlice(),
+        blob);
+    return SLANG_OK;
+}
+
+SlangResult Module::precompileRequestedTargetIR(DiagnosticSink* sink)
+{
+    for (auto targetReq : getLinkage()->targets)
+    {
+        if (targetReq->getOptionSet().getBoolOption(CompilerOptionName::EmbedTargetIR))
+        {
+            SLANG_RETURN_ON_FAIL(precompileTargetIR(targetReq, sink));
+        }
+    }
+    return SLANG_OK;
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::getPrecompiledTargetCode(
     SlangCompileTarget target,
     slang::IBlob** outCode,
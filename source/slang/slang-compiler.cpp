@@ -2249,7 +2249,9 @@ SlangResult EndToEndCompileRequest::maybeCreateContainer()
             if (auto artifact = targetProgram->getExistingWholeProgramResult())
             {
                 if (!targetProgram->getOptionSet().getBoolOption(
-                        CompilerOptionName::EmbedDownstreamIR))
+                        CompilerOptionName::EmbedDownstreamIR) &&
+                    !targetProgram->getOptionSet().getBoolOption(
+                        CompilerOptionName::EmbedTargetIR))
                 {
                     artifacts.add(ComPtr<IArtifact>(artifact));
                 }
@@ -2539,7 +2541,8 @@ void EndToEndCompileRequest::generateOutput(ComponentType* program)
     auto linkage = getLinkage();
     for (auto targetReq : linkage->targets)
     {
-        if (targetReq->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
+        if (targetReq->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR) ||
+            targetReq->getOptionSet().getBoolOption(CompilerOptionName::EmbedTargetIR))
             continue;
 
         auto targetProgram = program->getTargetProgram(targetReq);
@@ -2744,6 +2747,9 @@ bool CodeGenContext::isSpecializationDisabled()
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSerializedBlob)
 {
+    DiagnosticSink sink(getLinkage()->getSourceManager(), Lexer::sourceLocationLexer);
+    SLANG_RETURN_ON_FAIL(precompileRequestedTargetIR(&sink));
+
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
     OwnedMemoryStream memoryStream(FileAccess::Write);
@@ -2757,6 +2763,9 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSeriali
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::writeToFile(char const* fileName)
 {
+    DiagnosticSink sink(getLinkage()->getSourceManager(), Lexer::sourceLocationLexer);
+    SLANG_RETURN_ON_FAIL(precompileRequestedTargetIR(&sink));
+
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
     FileStream fileStream;
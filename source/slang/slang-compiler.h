@@ -1624,6 +1624,13 @@ public:
         slang::IModule** outModule,
         slang::IBlob** outDiagnostics = nullptr) SLANG_OVERRIDE;
 
+    /// Embed a snapshot of the IR of the module's functions, linked and simplified for
+    /// `targetReq`, in the module IR. Linking for the same target then uses the snapshot.
+    SlangResult precompileTargetIR(TargetRequest* targetReq, DiagnosticSink* sink);
+
+    /// Call `precompileTargetIR` for each target of the linkage with `EmbedTargetIR` set.
+    SlangResult precompileRequestedTargetIR(DiagnosticSink* sink);
+
     virtual void buildHash(DigestBuilder<SHA1>& builder) SLANG_OVERRIDE;
 
     virtual SLANG_NO_THROW slang::DeclReflection* SLANG_MCALL getModuleReflection() SLANG_OVERRIDE;
@@ -1631,6 +1638,18 @@ public:
     void setDigest(SHA1::Digest const& digest) { m_digest = digest; }
     SHA1::Digest computeDigest();
 
+    /// Get a digest of the declarations of the module that modules importing it can depend on.
+    /// This doesn't include the bodies of functions, so a module only needs to be recompiled if
+    /// the interface digest of a module it imports changes.
+    void setInterfaceDigest(SHA1::Digest const& digest) { m_interfaceDigest = digest; }
+    SHA1::Digest computeInterfaceDigest();
+
+    /// Get the indices in the file dependency list of the files that belong to this module,
+    /// rather than to a module it imports.
+    List<Index> getSourceFileDependencyIndices();
+    /// Get a digest of the compile options and the files that belong to this module.
+    SHA1::Digest computeSourceDigest();
+
     /// Create a module (initially empty).
     Module(Linkage* linkage, ASTBuilder* astBuilder = nullptr);
 
@@ -1796,6 +1815,9 @@ private:
     // A digest that uniquely identifies the contents of the module.
     SHA1::Digest m_digest;
 
+    // A digest of the declarations of the module, see `computeInterfaceDigest`.
+    SHA1::Digest m_interfaceDigest;
+
     // List of modules this module depends on
     ModuleDependencyList m_moduleDependencyList;
 
@@ -2070,6 +2092,7 @@ SourceLanguage getDefaultSourceLanguageForDownstreamCompiler(PassThroughMode com
 const char* getBuildTagString();
 
 struct TypeCheckingCache;
+struct ProfileFeedback;
 
 struct ContainerTypeKey
 {
@@ -2258,6 +2281,14 @@ public:
 
     RefPtr<RefObject> m_typeCheckingCache = nullptr;
 
+    /// Get the profile feedback file at `path` (as set with `-profile-feedback`). The file is only
+    /// read and parsed the first time it's requested. Returns nullptr, after diagnosing to `sink`,
+    /// if it can't be read.
+    ProfileFeedback* getProfileFeedback(String const& path, DiagnosticSink* sink);
+
+    // Map from the path of a profile feedback file to its parsed `ProfileFeedback`
+    Dictionary<String, RefPtr<RefObject>> m_profileFeedbacks;
+
     // Modules that have been dynamically loaded via `import`
     //
     // This is a list of unique modules loaded, in the order they were encountered.
@@ -2392,6 +2423,10 @@ public:
 
     bool isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* baseChunk);
 
+    /// Returns true if the interface of every module the serialized module imports is the same as
+    /// when it was compiled. The imported modules are loaded if necessary.
+    bool _areImportedModuleInterfacesUpToDate(ModuleChunk const* moduleChunk);
+
     RefPtr<Module> findOrImportModule(
         Name* name,
         SourceLoc const& loc,
@@ -2961,6 +2996,11 @@ public:
 
     SlangResult emitPrecompiledDownstreamIR(ComPtr<IArtifact>& outArtifact);
 
+    /// Link the program for the target, and simplify the functions marked with
+    /// DownstreamModuleExportDecoration. The result holds the functions that could be
+    /// snapshotted, or is null if there are none. See `Module::precompileTargetIR`.
+    SlangResult emitTargetIRSnapshot(RefPtr<IRModule>& outIRModule);
+
     void maybeDumpIntermediate(IArtifact* artifact);
 
     // Used to cause instructions available in precompiled blobs to be
@@ -3568,6 +3608,10 @@ public:
     // thread we need to be sure any changes to m_epochId are visible to this thread.
     std::atomic<Index> m_epochId = 1;
 
+    // Incremented whenever an ASTBuilder is destroyed. Vals resolved in one generation may be
+    // owned by the destroyed ASTBuilder, so can't be used in later generations.
+    std::atomic<Index> m_astBuilderGenerationId = 1;
+
     Scope* baseLanguageScope = nullptr;
     Scope* coreLanguageScope = nullptr;
     Scope* hlslLanguageScope = nullptr;
@@ -5,6 +5,8 @@
 #include "slang-syntax.h"
 #include "slang.h"
 
+#include <atomic>
+
 namespace Slang
 {
 
@@ -108,6 +110,18 @@ struct ContentAssistInfo
     // The preprocessors definitions and invocations found during preprocessing. Filled in during
     // preprocessing.
     PreprocessorContentAssistInfo preprocessorInfo;
+
+    // Set by the language server when the request being served is cancelled. Provided by the
+    // language server.
+    const std::atomic<bool>* cancelRequested = nullptr;
+    // True if checking skipped declarations because the request was cancelled, so the checked
+    // modules are incomplete. Filled in during semantics checking.
+    bool checkingCancelled = false;
+
+    bool isCancelRequested() const
+    {
+        return cancelRequested && cancelRequested->load(std::memory_order_relaxed);
+    }
 };
 
 } // namespace Slang
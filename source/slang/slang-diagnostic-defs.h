@@ -241,6 +241,11 @@ DIAGNOSTIC(
 
 DIAGNOSTIC(62, Error, unknownCommandLineValue, "unknown value for option. Valid values are '$0'")
 DIAGNOSTIC(63, Error, unknownHelpCategory, "unknown help category")
+DIAGNOSTIC(
+    64,
+    Warning,
+    invalidProfileFeedbackLine,
+    "ignoring line $0 of profile feedback file '$1', expected 'path:line hotness'")
 
 DIAGNOSTIC(
     70,
@@ -2727,6 +2732,24 @@ DIAGNOSTIC(
     "$0 bytes ($1) used to checkpoint the following item:")
 DIAGNOSTIC(-1, Note, reportCheckpointCounter, "$0 bytes ($1) used for a loop counter here:")
 DIAGNOSTIC(-1, Note, reportCheckpointNone, "no checkpoint contexts to report")
+DIAGNOSTIC(
+    -1,
+    Note,
+    reportMinCutCheckpointPolicy,
+    "checkpoint policy for '$0' stores $1 values ($2 bytes) and recomputes $3 values (estimated "
+    "cost $4), counting every loop iteration")
+DIAGNOSTIC(
+    -1,
+    Note,
+    reportEmittedSourceStats,
+    "generated $0 source has $1 lines and $2 temporaries, after computing $3 repeated values "
+    "once")
+DIAGNOSTIC(-1, Note, reportIRInstCount, "IR after '$0' has $1 instructions")
+DIAGNOSTIC(
+    -1,
+    Note,
+    reportRegisterPressure,
+    "'$0' has at most $1 values live at once ($2 before computing $3 values again inside loops)")
 
 // 9xxxx - Documentation generation
 DIAGNOSTIC(
@@ -112,6 +112,9 @@ CLikeSourceEmitter::CLikeSourceEmitter(const Desc& desc)
 
     auto targetCaps = getTargetReq()->getTargetCaps();
     isCoopvecPoc = targetCaps.implies(CapabilityAtom::hlsl_coopvec_poc);
+
+    m_compactEmittedSource = getTargetProgram()->getOptionSet().getBoolOption(
+        CompilerOptionName::CompactEmittedSource);
 }
 
 SlangResult CLikeSourceEmitter::init()
@@ -1797,7 +1800,13 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
         }
 
         if (ii->mightHaveSideEffects())
-            return false;
+        {
+            // The side effect can't change a value that doesn't depend on memory,
+            // so there is no need for a temporary to hold it.
+            if (!m_compactEmittedSource || !isFoldedValueIndependentOfSideEffects(inst))
+                return false;
+            break;
+        }
     }
 
     // As a safeguard, we should not allow an instruction that references
@@ -1817,6 +1826,26 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
     return true;
 }
 
+bool CLikeSourceEmitter::isFoldedValueIndependentOfSideEffects(IRInst* inst)
+{
+    // Movable instructions only read memory that can't be written (such as a
+    // constant buffer), so it is only their operands we need to worry about.
+    if (!isMovableInst(inst))
+        return false;
+
+    for (UInt i = 0; i < inst->getOperandCount(); i++)
+    {
+        // An operand that isn't folded has been computed by the time inst is emitted,
+        // but a folded one is computed along with inst, at its use.
+        auto operand = inst->getOperand(i);
+        if (!as<IRBlock>(operand->getParent()) || !shouldFoldInstIntoUseSites(operand))
+            continue;
+        if (!isFoldedValueIndependentOfSideEffects(operand))
+            return false;
+    }
+    return true;
+}
+
 void CLikeSourceEmitter::emitDereferenceOperand(IRInst* inst, EmitOpInfo const& outerPrec)
 {
     EmitOpInfo newOuterPrec = outerPrec;
@@ -2000,6 +2029,9 @@ void CLikeSourceEmitter::emitInstResultDecl(IRInst* inst)
     if (as<IRVoidType>(type))
         return;
 
+    if (as<IRBlock>(inst->getParent()))
+        m_emittedTemporaryCount++;
+
     emitTempModifiers(inst);
 
     emitRateQualifiers(inst);
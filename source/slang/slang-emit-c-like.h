@@ -243,6 +243,9 @@ public:
     Linkage* getLinkage() { return m_codeGenContext->getLinkage(); }
     ComponentType* getProgram() { return m_codeGenContext->getProgram(); }
     TargetProgram* getTargetProgram() { return m_codeGenContext->getTargetProgram(); }
+
+    /// Get the number of temporaries declared for instruction results so far
+    Count getEmittedTemporaryCount() const { return m_emittedTemporaryCount; }
     //
     // Types
     //
@@ -309,6 +312,10 @@ public:
 
     virtual bool shouldFoldInstIntoUseSites(IRInst* inst);
 
+    /// True if the value of inst, as emitted with any operands folded into it, can't be changed
+    /// by an instruction with side effects that comes between inst and its use.
+    bool isFoldedValueIndependentOfSideEffects(IRInst* inst);
+
     void emitOperand(IRInst* inst, EmitOpInfo const& outerPrec)
     {
         emitOperandImpl(inst, outerPrec);
@@ -744,6 +751,12 @@ protected:
 
     // Indicates if we are emiting for DXC cooperative vector POC.
     bool isCoopvecPoc = false;
+
+    // Fold single-use values into their use across statements with side effects, when
+    // they can't affect the value (see `CompilerOptionName::CompactEmittedSource`).
+    bool m_compactEmittedSource = false;
+
+    Count m_emittedTemporaryCount = 0;
 };
 
 } // namespace Slang
@@ -1,8 +1,6 @@
 // slang-emit-source-writer.cpp
 #include "slang-emit-source-writer.h"
 
-#include "../core/slang-char-encode.h"
-
 
 // Note: using C++ stdio just to get a locale-independent
 // way to format floating-point values.
@@ -25,6 +23,24 @@ SourceWriter::SourceWriter(
     m_sourceManager = sourceManager;
 }
 
+String SourceWriter::getContent()
+{
+    if (m_chunks.getCount() == 0)
+    {
+        return m_builder.produceString();
+    }
+
+    List<String> chunks(m_chunks);
+    chunks.add(m_builder.produceString());
+    return joinChunks(chunks);
+}
+
+void SourceWriter::clearContent()
+{
+    m_chunks.clear();
+    m_builder.clear();
+}
+
 String SourceWriter::getContentAndClear()
 {
     String content(getContent());
@@ -32,11 +48,71 @@ String SourceWriter::getContentAndClear()
     return content;
 }
 
+void SourceWriter::takeContentChunks(List<String>& ioChunks)
+{
+    ioChunks.addRange(m_chunks);
+    if (m_builder.getLength())
+    {
+        ioChunks.add(m_builder.produceString());
+    }
+    clearContent();
+}
+
+/* static */ String SourceWriter::joinChunks(List<String>& ioChunks)
+{
+    String result;
+    if (ioChunks.getCount() == 1)
+    {
+        // Nothing to join, and by moving the representation can remain unique
+        result = _Move(ioChunks[0]);
+    }
+    else if (ioChunks.getCount() > 1)
+    {
+        Index totalLength = 0;
+        for (const auto& chunk : ioChunks)
+        {
+            totalLength += chunk.getLength();
+        }
+
+        StringBuilder builder(UInt(totalLength));
+        for (const auto& chunk : ioChunks)
+        {
+            builder.append(chunk);
+        }
+        result = builder.produceString();
+    }
+    ioChunks.clear();
+    return result;
+}
+
+void SourceWriter::_flushChunk()
+{
+    // The source map tracking holds an offset into `m_builder`, so make sure
+    // it has seen all of the text in the chunk before the chunk is retired.
+    if (m_sourceMap)
+    {
+        Index lineIndex, columnIndex;
+        _calcLocation(lineIndex, columnIndex);
+    }
+    m_currentOutputOffset = 0;
+
+    m_chunks.add(m_builder.produceString());
+
+    // Releases our reference, so the chunk is now uniquely owned by `m_chunks`.
+    m_builder.clear();
+    m_builder.ensureCapacity(kChunkSize);
+}
+
 void SourceWriter::emitRawTextSpan(char const* textBegin, char const* textEnd)
 {
     // TODO(tfoley): Need to make "corelib" not use `int` for pointer-sized things...
     auto len = textEnd - textBegin;
     m_builder.append(textBegin, len);
+
+    if (m_builder.getLength() >= kChunkSize)
+    {
+        _flushChunk();
+    }
 }
 
 void SourceWriter::emitRawText(char const* text)
@@ -551,60 +627,19 @@ void SourceWriter::_emitLineDirective(const HumaneSourceLoc& sourceLocation)
 
 void SourceWriter::_calcLocation(Index& outLineIndex, Index& outColumnIndex)
 {
-    // If there are move chars we need to update
+    // If there are more chars we need to update
     if (m_currentOutputOffset < m_builder.getLength())
     {
-        const char* cur = m_builder.getBuffer() + m_currentOutputOffset;
-        const char* end = m_builder.end();
-
-        const char* start = cur;
-
-        while (cur < end)
-        {
-            // Reset start
-            start = cur;
-
-            // Look for the end of the line
-            while (*cur != '\n' && *cur != '\r' && cur < end)
-            {
-                cur++;
-            }
-
-            // If we are not at the total end then we must have hit a \n or \r
-            if (cur < end)
-            {
-                const auto c = *cur++;
-
-                // Next line
-                ++m_currentLineIndex;
-
-                // Check the next char to see if it's part of a CR/LF combination
-                if (cur < end)
-                {
-                    const auto d = *cur;
-                    // If it is combination skip the next byte
-                    cur += ((c ^ d) == ('\r' ^ '\n'));
-                }
-
-                // Calculate the offset to the start of this line
-                m_currentColumnIndex = 0;
-                start = cur;
-            }
-        }
+        m_outputLocation.advance(
+            UnownedStringSlice(m_builder.getBuffer() + m_currentOutputOffset, m_builder.end()));
 
         // Set the current offset to the end
         m_currentOutputOffset = m_builder.getLength();
-
-        // Get the bytes remaining on this line (which may not be complete)
-        const UnownedStringSlice lineRemaining(start, m_builder.end());
-
-        // Offset the column index in codepoints
-        m_currentColumnIndex += UTF8Util::calcCodePointCount(lineRemaining);
     }
 
     // Output the position
-    outColumnIndex = m_currentColumnIndex;
-    outLineIndex = m_currentLineIndex;
+    outColumnIndex = m_outputLocation.getColumnIndex();
+    outLineIndex = m_outputLocation.getLineIndex();
 }
 
 } // namespace Slang
@@ -64,12 +64,20 @@ public:
     void advanceToSourceLocationIfValid(const SourceLoc& sourceLocation);
 
     /// Get the content as a string
-    String getContent() { return m_builder.produceString(); }
+    String getContent();
     /// Clear the content
-    void clearContent() { m_builder.clear(); }
+    void clearContent();
     /// Get the content as a string and clear the internal representation
     String getContentAndClear();
 
+    /// Append the content to `ioChunks` as a list of chunks, and clear the internal
+    /// representation. Unlike `getContent` the chunks are not concatenated.
+    void takeContentChunks(List<String>& ioChunks);
+
+    /// Concatenate `ioChunks` into a single string, with a single allocation.
+    /// `ioChunks` is cleared.
+    static String joinChunks(List<String>& ioChunks);
+
     /// Get the line directive mode used
     LineDirectiveMode getLineDirectiveMode() const { return m_lineDirectiveMode; }
     /// Get the source manager user
@@ -104,11 +112,21 @@ protected:
     /// Calculate the current location in the ouput
     void _calcLocation(Index& outLineIndex, Index& outColumnIndex);
 
-    // The string of code we've built so far.
-    // TODO(JS): We could store the text in chunks, and then only sew together into one buffer
-    // when we are done. Doing so would not require copies/reallocs until the full buffer has been
-    // produced. A downside to doing this is that it won't be so simple to debug by trying to
-    // look at the current contents of the buffer
+    /// Move the contents of `m_builder` to the end of `m_chunks`
+    void _flushChunk();
+
+    /// The size in bytes at which `m_builder` is moved into `m_chunks`
+    static const Index kChunkSize = 256 * 1024;
+
+    // The text is stored in chunks, and only sewn together into one buffer when we are done.
+    // This means that large outputs don't need repeated copies/reallocs as the buffer grows.
+    // A downside is that it won't be so simple to debug by trying to look at the current
+    // contents of the buffer, as earlier text may be held in `m_chunks`.
+
+    /// Completed chunks of text, in order
+    List<String> m_chunks;
+
+    // The chunk of code currently being built. Follows all the text in `m_chunks`.
     StringBuilder m_builder;
 
     // Current source position for tracking purposes...
@@ -121,8 +139,7 @@ protected:
     // This is separate from m_loc, because m_loc doesn't appear to track the line/column directly
     // in the output stream - for example when #line emits a "raw" emit takes place.
     Count m_currentOutputOffset = 0;
-    Index m_currentLineIndex = 0;
-    Index m_currentColumnIndex = 0;
+    GeneratedLocationTracker m_outputLocation;
 
     bool m_needToUpdateSourceLocation = false;
 
@@ -134,8 +134,14 @@ public:
     /// Add an instruction to the end of the list of children
     void addInst(SpvInst* inst);
 
-    /// Dump all children, recursively, to a flattened list of SPIR-V words
-    void dumpTo(List<SpvWord>& ioWords);
+    /// Count the words needed to encode all children, recursively
+    Index calcWordCount() const;
+
+    /// Write all children, recursively, as flattened SPIR-V words starting at `dst`.
+    ///
+    /// There must be space for at least `calcWordCount()` words. Returns
+    /// a pointer to the word after the last one written.
+    SpvWord* writeTo(SpvWord* dst) const;
 
     /// The first child, if any.
     SpvInst* m_firstChild = nullptr;
@@ -209,8 +215,14 @@ struct SpvInst : SpvInstParent
     /// The result <id> produced by this instruction, or zero if it has no result.
     SpvWord id = 0;
 
-    /// Dump the instruction (and any children, recursively) into the flat array of SPIR-V words.
-    void dumpTo(List<SpvWord>& ioWords)
+    /// Count the words needed to encode the instruction and any children, recursively.
+    Index calcWordCount() const
+    {
+        return 1 + Index(operandWordsCount) + SpvInstParent::calcWordCount();
+    }
+
+    /// Write the instruction (and any children, recursively) as flat SPIR-V words to `dst`.
+    SpvWord* writeTo(SpvWord* dst) const
     {
         // [2.2: Terms]
         //
@@ -225,11 +237,15 @@ struct SpvInst : SpvInstParent
         // > Opcode: The 16 high-order bits are the WordCount of the instruction.
         // >         The 16 low-order bits are the opcode enumerant.
         //
-        ioWords.add(wordCount << 16 | opcode);
+        *dst++ = wordCount << 16 | opcode;
 
         // The operand words simply follow the opcode word.
         //
-        ioWords.addRange(operandWords, operandWordsCount);
+        if (operandWordsCount)
+        {
+            memcpy(dst, operandWords, sizeof(SpvWord) * operandWordsCount);
+            dst += operandWordsCount;
+        }
 
         // In our representation choice, the children of a
         // parent instruction will always follow the encoded
@@ -238,7 +254,7 @@ struct SpvInst : SpvInstParent
         // * The instructions inside a function always follow the `OpFunction`
         // * The instructions inside a block always follow the `OpLabel`
         //
-        SpvInstParent::dumpTo(ioWords);
+        return SpvInstParent::writeTo(dst);
     }
 
     void removeFromParent()
@@ -308,12 +324,23 @@ void SpvInstParent::addInst(SpvInst* inst)
     m_lastChild = inst;
 }
 
-void SpvInstParent::dumpTo(List<SpvWord>& ioWords)
+Index SpvInstParent::calcWordCount() const
+{
+    Index count = 0;
+    for (auto child = m_firstChild; child; child = child->nextSibling)
+    {
+        count += child->calcWordCount();
+    }
+    return count;
+}
+
+SpvWord* SpvInstParent::writeTo(SpvWord* dst) const
 {
     for (auto child = m_firstChild; child; child = child->nextSibling)
     {
-        child->dumpTo(ioWords);
+        dst = child->writeTo(dst);
     }
+    return dst;
 }
 
 /// The context for inlining a SPV assembly snippet.
@@ -328,64 +355,49 @@ struct SpvSnippetEmitContext
     List<SpvWord> argumentIds;
 };
 
-// A structure which can hold an integer literal, either one word or several
+// A structure which can hold an integer literal, either one word or two.
+//
+// Literals are stored inline (rather than in a heap allocated list) since
+// they are constructed for nearly every constant and type we emit, and at
+// most hold a 64-bit value.
 struct SpvLiteralInteger
 {
     static SpvLiteralInteger from32(int32_t value) { return from32(uint32_t(value)); }
-    static SpvLiteralInteger from32(uint32_t value) { return SpvLiteralInteger{{value}}; }
+    static SpvLiteralInteger from32(uint32_t value) { return SpvLiteralInteger{{value, 0}, 1}; }
     static SpvLiteralInteger from64(int64_t value) { return from64(uint64_t(value)); }
     static SpvLiteralInteger from64(uint64_t value)
     {
-        return SpvLiteralInteger{{SpvWord(value), SpvWord(value >> 32)}};
+        return SpvLiteralInteger{{SpvWord(value), SpvWord(value >> 32)}, 2};
     }
-    List<SpvWord> value; // Words, stored low words to high (TODO, SmallArray or something here)
+
+    SpvWord words[2]; ///< Words, stored low words to high
+    Index wordCount;  ///< The amount of words used in `words`
 };
 
-// A structure which can hold bitwise literal, either one word or several
+// A structure which can hold bitwise literal, either one word or two
 struct SpvLiteralBits
 {
-    static SpvLiteralBits from32(uint32_t value) { return SpvLiteralBits{{value}}; }
+    static SpvLiteralBits from32(uint32_t value) { return SpvLiteralBits{{value, 0}, 1}; }
     static SpvLiteralBits from64(uint64_t value)
     {
-        return SpvLiteralBits{{SpvWord(value), SpvWord(value >> 32)}};
+        return SpvLiteralBits{{SpvWord(value), SpvWord(value >> 32)}, 2};
     }
-    static SpvLiteralBits fromUnownedStringSlice(UnownedStringSlice text)
-    {
-        SpvLiteralBits result;
-
-        // [Section 2.2.1 : Instructions]
-        //
-        // > Literal String: A nul-terminated stream of characters consuming
-        // > an integral number of words. The character set is Unicode in the
-        // > UTF-8 encoding scheme. The UTF-8 octets (8-bit bytes) are packed
-        // > four per word, following the little-endian convention (i.e., the
-        // > first octet is in the lowest-order 8 bits of the word).
-        // > The final word contains the string’s nul-termination character (0), and
-        // > all contents past the end of the string in the final word are padded with 0.
-
-        // First work out the amount of words we'll need
-        const Index textCount = text.getLength();
-        // Calculate the minimum amount of bytes needed - which needs to include terminating 0
-        const Index minByteCount = textCount + 1;
-        // Calculate the amount of words including padding if necessary
-        const Index wordCount = (minByteCount + 3) >> 2;
-
-        // Make space on the operand stack, keeping the free space start in operandStartIndex
-        result.value.setCount(wordCount);
-
-        // Set dst to the start of the operand memory
-        char* dst = (char*)(result.value.getBuffer());
-
-        // Copy the text
-        SLANG_ASSUME(textCount >= 0);
-        memcpy(dst, text.begin(), textCount);
 
-        // Set terminating 0, and remaining buffer 0s
-        memset(dst + textCount, 0, wordCount * sizeof(SpvWord) - textCount);
+    SpvWord words[2]; ///< Words, stored low words to high
+    Index wordCount;  ///< The amount of words used in `words`
+};
 
-        return result;
+// A structure which refers to the text of a literal string operand.
+//
+// The text is not copied, it is encoded directly into the operand
+// words of the instruction being constructed.
+struct SpvLiteralString
+{
+    static SpvLiteralString fromUnownedStringSlice(UnownedStringSlice text)
+    {
+        return SpvLiteralString{text};
     }
-    List<SpvWord> value; // Words, stored low words to high (TODO, SmallArray or something here)
+    UnownedStringSlice text;
 };
 
 // As a convenience, there are often cases where
@@ -514,29 +526,44 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     // At the end of emission we need a single linear stream of words,
     // so we will eventually flatten `m_sections` into a single array.
 
-    /// The final array of SPIR-V words that defines the encoded module
-    List<SpvWord> m_words;
-
     /// Emit the concrete words that make up the binary SPIR-V module.
     ///
-    /// This function fills in `m_words` based on the data in `m_sections`.
-    /// This function should only be called once.
+    /// This function appends the encoded module to `ioBytes` based on the
+    /// data in `m_sections`. This function should only be called once.
     ///
-    void emitPhysicalLayout()
+    void emitPhysicalLayout(List<uint8_t>& ioBytes)
     {
+        // We know the exact size of the module up front, so rather than
+        // growing the output as we go, we size it once and then write
+        // each instruction directly into place.
+        //
+        const Index kHeaderWordCount = 5;
+        Index wordCount = kHeaderWordCount;
+        for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
+        {
+            wordCount += m_sections[ii].calcWordCount();
+        }
+
+        const Index startIndex = ioBytes.getCount();
+        SLANG_ASSERT(startIndex % Index(sizeof(SpvWord)) == 0);
+        ioBytes.setCount(startIndex + wordCount * Index(sizeof(SpvWord)));
+
+        SpvWord* const start = (SpvWord*)(ioBytes.getBuffer() + startIndex);
+        SpvWord* dst = start;
+
         // [2.3: Physical Layout of a SPIR-V Module and Instruction]
         //
         // > Magic Number
         //
-        m_words.add(SpvMagicNumber);
+        *dst++ = SpvMagicNumber;
 
         // > Version nuumber
         //
-        m_words.add(m_spvVersion);
+        *dst++ = m_spvVersion;
 
         // > Generator's magic number.
         //
-        m_words.add(kSPIRVSlangCompilerId);
+        *dst++ = kSPIRVSlangCompilerId;
 
         // > Bound
         //
@@ -544,11 +571,11 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         // <id>s, so its value when we are done emitting code
         // can serve as the bound.
         //
-        m_words.add(m_nextID);
+        *dst++ = m_nextID;
 
         // > 0 (Reserved for instruction schema, if needed.)
         //
-        m_words.add(0);
+        *dst++ = 0;
 
         // > First word of instruction stream
         // > All remaining words are a linear sequence of instructions.
@@ -558,8 +585,9 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         //
         for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
         {
-            m_sections[ii].dumpTo(m_words);
+            dst = m_sections[ii].writeTo(dst);
         }
+        SLANG_ASSERT(dst == start + wordCount);
     }
 
     // We will often need to refer to an instrcition by its
@@ -989,7 +1017,43 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         // Assert that `text` doesn't contain any embedded nul bytes, since they
         // could lead to invalid encoded results.
         SLANG_ASSERT(text.indexOf(0) < 0);
-        emitOperand(SpvLiteralBits::fromUnownedStringSlice(text));
+        emitOperand(SpvLiteralString::fromUnownedStringSlice(text));
+    }
+
+    void emitOperand(const SpvLiteralString& str)
+    {
+        SLANG_ASSERT(m_currentInst || m_peekingOperands);
+
+        // [Section 2.2.1 : Instructions]
+        //
+        // > Literal String: A nul-terminated stream of characters consuming
+        // > an integral number of words. The character set is Unicode in the
+        // > UTF-8 encoding scheme. The UTF-8 octets (8-bit bytes) are packed
+        // > four per word, following the little-endian convention (i.e., the
+        // > first octet is in the lowest-order 8 bits of the word).
+        // > The final word contains the string’s nul-termination character (0), and
+        // > all contents past the end of the string in the final word are padded with 0.
+
+        // First work out the amount of words we'll need
+        const Index textCount = str.text.getLength();
+        // Calculate the minimum amount of bytes needed - which needs to include terminating 0
+        const Index minByteCount = textCount + 1;
+        // Calculate the amount of words including padding if necessary
+        const Index wordCount = (minByteCount + 3) >> 2;
+
+        // Make space on the operand stack, keeping the free space start in operandStartIndex
+        const Index operandStartIndex = m_operandStack.getCount();
+        m_operandStack.setCount(operandStartIndex + wordCount);
+
+        // Set dst to the start of the operand memory
+        char* dst = (char*)(m_operandStack.getBuffer() + operandStartIndex);
+
+        // Copy the text
+        SLANG_ASSUME(textCount >= 0);
+        memcpy(dst, str.text.begin(), textCount);
+
+        // Set terminating 0, and remaining buffer 0s
+        memset(dst + textCount, 0, wordCount * sizeof(SpvWord) - textCount);
     }
 
     // Sometimes we will want to pass down an argument that
@@ -1014,14 +1078,14 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
 
     void emitOperand(const SpvLiteralBits& bits)
     {
-        for (const auto v : bits.value)
-            emitOperand(v);
+        SLANG_ASSERT(m_currentInst || m_peekingOperands);
+        m_operandStack.addRange(bits.words, bits.wordCount);
     }
 
     void emitOperand(const SpvLiteralInteger& integer)
     {
-        for (const auto v : integer.value)
-            emitOperand(v);
+        SLANG_ASSERT(m_currentInst || m_peekingOperands);
+        m_operandStack.addRange(integer.words, integer.wordCount);
     }
 
     template<typename T>
@@ -2228,7 +2292,7 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
                     nullptr,
                     SpvOpString,
                     kResultID,
-                    SpvLiteralBits::fromUnownedStringSlice(sourceStrHead));
+                    SpvLiteralString::fromUnownedStringSlice(sourceStrHead));
 
                 auto result = emitOpDebugSource(
                     getSection(SpvLogicalSectionID::ConstantsAndTypes),
@@ -2247,7 +2311,7 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
                         nullptr,
                         SpvOpString,
                         kResultID,
-                        SpvLiteralBits::fromUnownedStringSlice(slice));
+                        SpvLiteralString::fromUnownedStringSlice(slice));
                     emitOpDebugSourceContinued(
                         getSection(SpvLogicalSectionID::ConstantsAndTypes),
                         nullptr,
@@ -4710,7 +4774,7 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
                     inst,
                     SpvOpString,
                     kResultID,
-                    SpvLiteralBits::fromUnownedStringSlice(value));
+                    SpvLiteralString::fromUnownedStringSlice(value));
             }
         default:
             return nullptr;
@@ -8560,7 +8624,7 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
                             {
                             case kIROp_StringLit:
                                 emitOperand(
-                                    SpvLiteralBits::fromUnownedStringSlice(v->getStringSlice()));
+                                    SpvLiteralString::fromUnownedStringSlice(v->getStringSlice()));
                                 break;
                             case kIROp_IntLit:
                                 {
@@ -9067,7 +9131,7 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     }
 
     SPIRVEmitContext(IRModule* module, TargetProgram* program, DiagnosticSink* sink)
-        : SPIRVEmitSharedContext(module, program, sink), m_irModule(module), m_memoryArena(2048)
+        : SPIRVEmitSharedContext(module, program, sink), m_irModule(module), m_memoryArena(64 * 1024)
     {
     }
 };
@@ -9202,11 +9266,7 @@ SlangResult emitSPIRVFromIR(
 
     context.emitFrontMatter();
 
-    context.emitPhysicalLayout();
-
-    spirvOut.addRange(
-        (uint8_t const*)context.m_words.getBuffer(),
-        context.m_words.getCount() * Index(sizeof(context.m_words[0])));
+    context.emitPhysicalLayout(spirvOut);
 
     return SLANG_OK;
 }
@@ -98,6 +98,7 @@
 #include "slang-ir-specialize-resources.h"
 #include "slang-ir-specialize-stage-switch.h"
 #include "slang-ir-specialize.h"
+#include "slang-ir-ssa-register-allocate.h"
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-string-hash.h"
@@ -107,10 +108,13 @@
 #include "slang-ir-synthesize-active-mask.h"
 #include "slang-ir-translate-global-varying-var.h"
 #include "slang-ir-undo-param-copy.h"
+#include "slang-ir-unroll-inline-heuristics.h"
 #include "slang-ir-uniformity.h"
 #include "slang-ir-user-type-hint.h"
 #include "slang-ir-validate.h"
+#include "slang-ir-value-numbering-for-emit.h"
 #include "slang-ir-variable-scope-correction.h"
+#include "slang-ir-vectorize.h"
 #include "slang-ir-vk-invert-y.h"
 #include "slang-ir-wgsl-legalize.h"
 #include "slang-ir-wrap-structured-buffers.h"
@@ -222,6 +226,38 @@ static void dumpIRIfEnabled(
     }
 }
 
+/// Report the number of instructions in the module after the major pass named `label`, if
+/// -report-ir-inst-counts is set.
+static void reportIRInstCountIfEnabled(
+    CodeGenContext* codeGenContext,
+    IRModule* irModule,
+    char const* label)
+{
+    if (!codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
+            CompilerOptionName::ReportIRInstCounts))
+    {
+        return;
+    }
+
+    // Count every instruction in the module, including the module instruction itself.
+    Count instCount = 0;
+    List<IRInst*> workList;
+    workList.add(irModule->getModuleInst());
+    while (workList.getCount())
+    {
+        auto inst = workList.getLast();
+        workList.removeLast();
+        instCount++;
+        for (auto child : inst->getDecorationsAndChildren())
+            workList.add(child);
+    }
+    codeGenContext->getSink()->diagnose(
+        SourceLoc(),
+        Diagnostics::reportIRInstCount,
+        label,
+        instCount);
+}
+
 static void reportCheckpointIntermediates(
     CodeGenContext* codeGenContext,
     DiagnosticSink* sink,
@@ -293,6 +329,39 @@ static void reportCheckpointIntermediates(
         sink->diagnose(SourceLoc(), Diagnostics::reportCheckpointNone);
 }
 
+static void reduceRegisterPressure(
+    CodeGenContext* codeGenContext,
+    DiagnosticSink* sink,
+    IRModule* irModule)
+{
+    CompilerOptionSet& optionSet = codeGenContext->getTargetProgram()->getOptionSet();
+    const bool shouldReduce = optionSet.getBoolOption(CompilerOptionName::ReduceRegisterPressure);
+    const bool shouldReport = optionSet.getBoolOption(CompilerOptionName::ReportRegisterPressure);
+    if (!shouldReduce && !shouldReport)
+        return;
+
+    for (auto inst : irModule->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func || !func->getFirstBlock())
+            continue;
+
+        const Count initialLiveCount = shouldReport ? LivenessUtil::calcMaxLiveValueCount(func) : 0;
+        const Count rematerializedCount = shouldReduce ? rematerializeValuesUsedInLoops(func) : 0;
+        if (shouldReport)
+        {
+            sink->diagnose(
+                func,
+                Diagnostics::reportRegisterPressure,
+                func,
+                rematerializedCount ? LivenessUtil::calcMaxLiveValueCount(func)
+                                    : initialLiveCount,
+                initialLiveCount,
+                rematerializedCount);
+        }
+    }
+}
+
 struct LinkingAndOptimizationOptions
 {
     bool shouldLegalizeExistentialAndResourceTypes = true;
@@ -646,6 +715,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "LINKED");
 #endif
+    reportIRInstCountIfEnabled(codeGenContext, irModule, "LINKED");
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
@@ -1091,6 +1161,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "SPECIALIZED");
 #endif
+    reportIRInstCountIfEnabled(codeGenContext, irModule, "SPECIALIZED");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     switch (target)
@@ -1106,6 +1177,31 @@ Result linkAndOptimizeIR(
     // Inline calls to any functions marked with [__unsafeInlineEarly] or [ForceInline].
     performForceInlining(irModule);
 
+    // Inline calls and unroll loops that a cost model finds worthwhile, optionally guided by
+    // a profile of which functions and loops are hot.
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::HeuristicUnrollAndInline) &&
+        !fastIRSimplificationOptions.minimalOptimization)
+    {
+        UnrollAndInlineHeuristics heuristics;
+        heuristics.m_sourceManager = codeGenContext->getSourceManager();
+
+        // The linkage parses the profile once, rather than every time code is generated
+        auto profilePath =
+            targetProgram->getOptionSet().getStringOption(CompilerOptionName::ProfileFeedbackFile);
+        if (profilePath.getLength())
+        {
+            heuristics.m_profile =
+                codeGenContext->getLinkage()->getProfileFeedback(profilePath, sink);
+            if (!heuristics.m_profile)
+                return SLANG_FAIL;
+        }
+
+        performHeuristicInlining(irModule, &heuristics);
+        unrollLoopsByHeuristics(targetProgram, irModule, &heuristics);
+        dumpIRIfEnabled(codeGenContext, irModule, "HEURISTIC UNROLL AND INLINE");
+        reportIRInstCountIfEnabled(codeGenContext, irModule, "HEURISTIC UNROLL AND INLINE");
+    }
+
     // Push `structuredBufferLoad` to the end of access chain to avoid loading unnecessary data.
     if (isKhronosTarget(targetRequest) || isMetalTarget(targetRequest) ||
         isWGPUTarget(targetRequest))
@@ -1663,6 +1759,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
 #endif
+    reportIRInstCountIfEnabled(codeGenContext, irModule, "AFTER DCE");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
 
@@ -1720,6 +1817,26 @@ Result linkAndOptimizeIR(
         simplifyIR(targetProgram, irModule, simplificationOptions, sink);
     }
 
+    // Pack scalar arithmetic that computes each component of a vector into vector arithmetic,
+    // on the targets that compute vector operations faster than the same operations on each
+    // component. SPIR-V only gains from packing 16-bit values into packed operations.
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::VectorizeScalarOps))
+    {
+        VectorizeOptions vectorizeOptions;
+        vectorizeOptions.onlyHalf = isKhronosTarget(targetRequest);
+        if (isKhronosTarget(targetRequest) || isMetalTarget(targetRequest) ||
+            isCPUTarget(targetRequest))
+        {
+            vectorizeScalarOps(irModule, vectorizeOptions);
+            dumpIRIfEnabled(codeGenContext, irModule, "VECTORIZED");
+            reportIRInstCountIfEnabled(codeGenContext, irModule, "VECTORIZED");
+        }
+    }
+
+    // Shorten the live ranges of values held across loops, while the IR is still in SSA form
+    // and the values and their uses are easy to find.
+    reduceRegisterPressure(codeGenContext, sink, irModule);
+
     // As a late step, we need to take the SSA-form IR and move things *out*
     // of SSA form, by eliminating all "phi nodes" (block parameters) and
     // introducing explicit temporaries instead. Doing this at the IR level
@@ -1812,6 +1929,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "OPTIMIZED");
 #endif
+    reportIRInstCountIfEnabled(codeGenContext, irModule, "OPTIMIZED");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     if ((target != CodeGenTarget::SPIRV) && (target != CodeGenTarget::SPIRVAssembly))
@@ -1844,6 +1962,148 @@ Result linkAndOptimizeIR(
     return sink->getErrorCount() == 0 ? SLANG_OK : SLANG_FAIL;
 }
 
+/// Does `func` use a global shader parameter? Their layout is only known to the program that
+/// is finally compiled, so a function that uses one can't be snapshotted.
+static bool _doesFuncUseGlobalParam(IRFunc* func)
+{
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            for (UInt i = 0; i < inst->getOperandCount(); ++i)
+            {
+                if (as<IRGlobalParam>(inst->getOperand(i)))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+SlangResult CodeGenContext::emitTargetIRSnapshot(RefPtr<IRModule>& outIRModule)
+{
+    SLANG_PROFILE;
+    outIRModule = nullptr;
+
+    auto sink = getSink();
+    auto targetProgram = getTargetProgram();
+
+    // Only passes that keep the signatures of functions as they are can be applied, because
+    // the functions are called from programs that haven't been through them. That covers
+    // linking (which resolves target specific definitions and `__target_switch`),
+    // specialization and simplification, but not legalization for the target.
+    //
+    LinkedIR linkedIR = linkIR(this);
+    auto irModule = linkedIR.module;
+    validateIRModuleIfEnabled(this, irModule);
+
+    if (!isSpecializationDisabled())
+    {
+        SpecializationOptions specOptions;
+        specOptions.lowerWitnessLookups = false;
+        specializeModule(targetProgram, irModule, sink, specOptions);
+    }
+    if (sink->getErrorCount() != 0)
+        return SLANG_FAIL;
+
+    performMandatoryEarlyInlining(irModule);
+    simplifyIR(targetProgram, irModule, IRSimplificationOptions::getDefault(targetProgram), sink);
+    if (sink->getErrorCount() != 0)
+        return SLANG_FAIL;
+    validateIRModuleIfEnabled(this, irModule);
+
+    // When the snapshot is used, everything the snapshotted functions refer to is resolved
+    // against the modules being linked. So other functions those modules define don't need
+    // their bodies, which leaves only the snapshotted functions and what only the snapshot
+    // defines (such as specializations of generics).
+    //
+    List<IRModule*> sourceModules;
+    getProgram()->enumerateIRModules([&](IRModule* module) { sourceModules.add(module); });
+    for (auto& coreModule : getSession()->coreModules)
+        sourceModules.add(coreModule->getIRModule());
+
+    auto findSourceDefinition = [&](UnownedStringSlice mangledName, bool& outIsKeptAlive)
+    {
+        bool isDefined = false;
+        outIsKeptAlive = false;
+        ImmutableHashedString hashedName(mangledName);
+        for (auto module : sourceModules)
+        {
+            for (auto value : module->findSymbolByMangledName(hashedName))
+            {
+                isDefined = true;
+                outIsKeptAlive |= value->findDecoration<IRKeepAliveDecoration>() != nullptr;
+            }
+        }
+        return isDefined;
+    };
+
+    // The functions to be snapshotted were marked as exported to have them linked, and so were
+    // kept alive. That is removed so they aren't kept alive where the snapshot is used.
+    auto removeExportMarker = [&](IRFunc* func, bool isKeptAlive)
+    {
+        if (auto marker = func->findDecoration<IRDownstreamModuleExportDecoration>())
+            marker->removeAndDeallocate();
+        if (!isKeptAlive)
+        {
+            if (auto keepAlive = func->findDecoration<IRKeepAliveDecoration>())
+                keepAlive->removeAndDeallocate();
+        }
+    };
+
+    List<IRFunc*> snapshotFuncs;
+    List<IRInst*> blocksToRemove;
+    for (auto inst : irModule->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func || !func->getFirstBlock())
+            continue;
+        auto linkage = func->findDecoration<IRLinkageDecoration>();
+        if (!linkage)
+            continue;
+
+        bool isKeptAlive = false;
+        const bool isDefined = findSourceDefinition(linkage->getMangledName(), isKeptAlive);
+
+        if (func->findDecoration<IRDownstreamModuleExportDecoration>())
+        {
+            if (!_doesFuncUseGlobalParam(func))
+            {
+                snapshotFuncs.add(func);
+                continue;
+            }
+            removeExportMarker(func, isKeptAlive);
+        }
+
+        if (isDefined)
+        {
+            for (auto block : func->getBlocks())
+                blocksToRemove.add(block);
+        }
+    }
+    for (auto block : blocksToRemove)
+        block->removeAndDeallocate();
+
+    if (snapshotFuncs.getCount() == 0)
+        return SLANG_OK;
+
+    eliminateDeadCode(irModule);
+
+    IRBuilder builder(irModule);
+    for (auto func : snapshotFuncs)
+    {
+        bool isKeptAlive = false;
+        findSourceDefinition(
+            func->findDecoration<IRLinkageDecoration>()->getMangledName(),
+            isKeptAlive);
+        removeExportMarker(func, isKeptAlive);
+        builder.addDecoration(func, kIROp_TargetIRSnapshotDecoration);
+    }
+
+    outIRModule = irModule;
+    return SLANG_OK;
+}
+
 SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outArtifact)
 {
     SLANG_PROFILE;
@@ -1973,6 +2233,7 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
     SLANG_RETURN_ON_FAIL(sourceEmitter->init());
 
     ComPtr<IArtifactPostEmitMetadata> metadata;
+    Count sharedValueCount = 0;
     {
         LinkingAndOptimizationOptions linkingAndOptimizationOptions;
 
@@ -1994,6 +2255,11 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
 
         auto irModule = linkedIR.module;
 
+        // Share values computed more than once. This has to come before the simplifications
+        // below, which duplicate cheap loads and element extracts into each of their uses.
+        if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::CompactEmittedSource))
+            sharedValueCount = numberValuesForEmit(irModule);
+
         // Perform final simplifications to help emit logic to generate more compact code.
         simplifyForEmit(irModule, targetRequest);
 
@@ -2006,8 +2272,8 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         sourceEmitter->emitModule(irModule, sink);
     }
 
-    String code = sourceWriter.getContent();
-    sourceWriter.clearContent();
+    List<String> codeChunks;
+    sourceWriter.takeContentChunks(codeChunks);
 
     // Now that we've emitted the code for all the declarations in the file,
     // it is time to stitch together the final output.
@@ -2063,12 +2329,32 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
 
     // Get the content built so far from the front matter/prelude/preModule
     // By getting in this way, the content is no longer referenced by the sourceWriter.
-    String finalResult = sourceWriter.getContentAndClear();
+    List<String> chunks;
+    sourceWriter.takeContentChunks(chunks);
 
     // Append the modules output code
-    finalResult.append(code);
+    chunks.addRange(codeChunks);
 
-    finalResult.append(sourceWriter.getContentAndClear());
+    sourceWriter.takeContentChunks(chunks);
+
+    // Sew the chunks together into a single buffer. As we know the final size
+    // this only requires a single allocation and copy of each chunk.
+    String finalResult = SourceWriter::joinChunks(chunks);
+
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ReportEmittedSourceStats))
+    {
+        Count lineCount = 0;
+        for (auto c : finalResult.getUnownedSlice())
+            lineCount += Count(c == '\n');
+
+        sink->diagnose(
+            SourceLoc(),
+            Diagnostics::reportEmittedSourceStats,
+            TypeTextUtil::getCompileTargetName(SlangCompileTarget(target)),
+            lineCount,
+            sourceEmitter->getEmittedTemporaryCount(),
+            sharedValueCount);
+    }
 
     // Write out the result
 
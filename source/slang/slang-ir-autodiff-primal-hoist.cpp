@@ -5,6 +5,7 @@
 #include "slang-ir-autodiff-loop-analysis.h"
 #include "slang-ir-autodiff-region.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-layout.h"
 #include "slang-ir-simplify-cfg.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
@@ -431,7 +432,7 @@ RefPtr<HoistedPrimalsInfo> AutodiffCheckpointPolicyBase::processFunc(
 
     RefPtr<CheckpointSetInfo> checkpointInfo = new CheckpointSetInfo();
 
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = findOrComputeDominatorTree(func);
 
     List<UseOrPseudoUse> workList;
     HashSet<UseOrPseudoUse> processedUses;
@@ -1134,7 +1135,7 @@ void AutodiffCheckpointPolicyBase::collectLoopExitConditions(IRGlobalValueWithCo
 {
     // Assume that the InductionValueInfo is already collected.
     IRBuilder builder(func->getModule());
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = findOrComputeDominatorTree(func);
     for (auto block : func->getBlocks())
     {
         auto loopInst = as<IRLoop>(block->getTerminator());
@@ -1964,7 +1965,7 @@ RefPtr<HoistedPrimalsInfo> ensurePrimalAvailability(
     // }
     //
 
-    RefPtr<IRDominatorTree> domTree = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> domTree = findOrComputeDominatorTree(func);
 
     IRBlock* defaultVarBlock = func->getFirstBlock()->getNextBlock();
 
@@ -2529,7 +2530,10 @@ void lowerCheckpointObjectInsts(IRGlobalValueWithCode* func)
 // For each primal inst that is used in reverse blocks, decide if we should recompute or store
 // its value, then make them accessible in reverse blocks based the decision.
 //
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    TargetProgram* targetProgram,
+    DiagnosticSink* sink)
 {
     sortBlocksInFunc(func);
 
@@ -2562,10 +2566,39 @@ RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
     // If we decide to recompute the inst, emit the recompute inst in the corresponding
     // recompute block.
     //
-    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy = new DefaultCheckpointPolicy(func->getModule());
+    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy;
+    RefPtr<MinCutCheckpointPolicy> minCutPolicy;
+    if (targetProgram &&
+        targetProgram->getOptionSet().getBoolOption(CompilerOptionName::MinCutCheckpointPolicy))
+    {
+        minCutPolicy = new MinCutCheckpointPolicy(
+            func->getModule(),
+            targetProgram->getOptionSet(),
+            indexedBlockInfo);
+        chkPolicy = minCutPolicy;
+    }
+    else
+    {
+        chkPolicy = new DefaultCheckpointPolicy(func->getModule());
+    }
     chkPolicy->preparePolicy(func);
     auto primalsInfo = chkPolicy->processFunc(func, recomputeBlockMap, cloneCtx, indexedBlockInfo);
 
+    if (minCutPolicy && sink &&
+        targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::ReportCheckpointIntermediates))
+    {
+        auto& summary = minCutPolicy->getSummary();
+        sink->diagnose(
+            func,
+            Diagnostics::reportMinCutCheckpointPolicy,
+            func,
+            summary.storeCount,
+            summary.storeBytes,
+            summary.recomputeCount,
+            summary.recomputeCost);
+    }
+
     // Legalize the primal inst accesses by introducing local variables / arrays and emitting
     // necessary load/store logic.
     //
@@ -2876,4 +2909,477 @@ HoistResult DefaultCheckpointPolicy::classify(UseOrPseudoUse use)
         }
     }
 }
+
+// A flow network for finding a minimum s-t cut, using Dinic's max-flow algorithm.
+//
+// Once the max flow is found, the nodes still reachable from the source through edges with
+// spare capacity form the source side of a minimum cut.
+//
+struct MinCutFlowGraph
+{
+    static const IRIntegerValue kInfiniteCapacity = IRIntegerValue(1) << 60;
+
+    struct Edge
+    {
+        Index to;
+        IRIntegerValue capacity;
+    };
+
+    // Edges are added in pairs, so the reverse of edge `i` is `i ^ 1`.
+    List<Edge> edges;
+    List<List<Index>> edgesFromNode;
+
+    List<Index> levels;
+    List<Index> nextEdgeIndex;
+
+    Index addNode()
+    {
+        edgesFromNode.add(List<Index>());
+        return edgesFromNode.getCount() - 1;
+    }
+
+    void addEdge(Index from, Index to, IRIntegerValue capacity)
+    {
+        if (capacity <= 0)
+            return;
+        edgesFromNode[from].add(edges.getCount());
+        edges.add(Edge{to, capacity});
+        edgesFromNode[to].add(edges.getCount());
+        edges.add(Edge{from, 0});
+    }
+
+    // Find the distance of every node from `source` in the residual graph, and return if `sink`
+    // is reachable.
+    bool computeLevels(Index source, Index sink)
+    {
+        levels.setCount(edgesFromNode.getCount());
+        for (auto& level : levels)
+            level = -1;
+
+        List<Index> queue;
+        levels[source] = 0;
+        queue.add(source);
+        for (Index i = 0; i < queue.getCount(); i++)
+        {
+            auto node = queue[i];
+            for (auto edgeIndex : edgesFromNode[node])
+            {
+                auto& edge = edges[edgeIndex];
+                if (edge.capacity > 0 && levels[edge.to] < 0)
+                {
+                    levels[edge.to] = levels[node] + 1;
+                    queue.add(edge.to);
+                }
+            }
+        }
+        return levels[sink] >= 0;
+    }
+
+    IRIntegerValue pushFlow(Index node, Index sink, IRIntegerValue flow)
+    {
+        if (node == sink)
+            return flow;
+
+        auto& nodeEdges = edgesFromNode[node];
+        for (auto& i = nextEdgeIndex[node]; i < nodeEdges.getCount(); i++)
+        {
+            auto edgeIndex = nodeEdges[i];
+            auto to = edges[edgeIndex].to;
+            auto capacity = edges[edgeIndex].capacity;
+            if (capacity <= 0 || levels[to] != levels[node] + 1)
+                continue;
+
+            auto pushed = pushFlow(to, sink, Math::Min(flow, capacity));
+            if (pushed > 0)
+            {
+                edges[edgeIndex].capacity -= pushed;
+                edges[edgeIndex ^ 1].capacity += pushed;
+                return pushed;
+            }
+        }
+        return 0;
+    }
+
+    // Saturate the network, then return which nodes are on the source side of the cut.
+    void computeMinCut(Index source, Index sink, List<bool>& outIsSourceSide)
+    {
+        while (computeLevels(source, sink))
+        {
+            nextEdgeIndex.setCount(edgesFromNode.getCount());
+            for (auto& i : nextEdgeIndex)
+                i = 0;
+            while (pushFlow(source, sink, kInfiniteCapacity) > 0)
+            {
+            }
+        }
+
+        computeLevels(source, sink);
+        outIsSourceSide.setCount(edgesFromNode.getCount());
+        for (Index i = 0; i < levels.getCount(); i++)
+            outIsSourceSide[i] = levels[i] >= 0;
+    }
+};
+
+// The cost of storing one byte, relative to the cost of recomputing a simple ALU operation on
+// one 32-bit lane. A stored value is written in the primal pass and read in the backward
+// pass, and the storage competes with registers for occupancy, so bytes are weighted the same
+// as operations.
+//
+static const IRIntegerValue kCheckpointCostPerStoredByte = 1;
+static const IRIntegerValue kCheckpointCostPerRecomputedOp = 1;
+
+// The trip count assumed for a loop without a known maximum iteration count.
+static const IRIntegerValue kCheckpointDefaultLoopTripCount = 16;
+
+// Limit on the trip count multiplier so that the costs of deeply nested loops don't overflow.
+static const IRIntegerValue kCheckpointMaxTripCount = IRIntegerValue(1) << 24;
+
+// The cost assumed for a call to a function whose body isn't visible.
+static const IRIntegerValue kCheckpointDefaultCallCost = 16;
+
+IRIntegerValue MinCutCheckpointPolicy::getTripCount(IRInst* inst)
+{
+    IRIntegerValue tripCount = 1;
+    auto indices = blockIndexInfo.tryGetValue(getBlock(inst));
+    if (!indices)
+        return tripCount;
+
+    for (auto& index : *indices)
+    {
+        IRIntegerValue iters = index.maxIters > 0 ? IRIntegerValue(index.maxIters)
+                                                  : kCheckpointDefaultLoopTripCount;
+        iters = Math::Min(iters, kCheckpointMaxTripCount);
+        tripCount = Math::Min(tripCount * iters, kCheckpointMaxTripCount);
+    }
+    return tripCount;
+}
+
+IRIntegerValue MinCutCheckpointPolicy::getStoreCost(IRInst* inst)
+{
+    IRSizeAndAlignment sizeAndAlignment;
+    IRIntegerValue size = 4;
+    if (SLANG_SUCCEEDED(
+            getNaturalSizeAndAlignment(optionSet, inst->getDataType(), &sizeAndAlignment)) &&
+        sizeAndAlignment.size != IRSizeAndAlignment::kIndeterminateSize)
+    {
+        size = Math::Max(sizeAndAlignment.size, IRIntegerValue(1));
+    }
+    return size * getTripCount(inst);
+}
+
+IRIntegerValue MinCutCheckpointPolicy::getRecomputeCost(IRInst* inst)
+{
+    IRIntegerValue opCost = 1;
+    switch (inst->getOp())
+    {
+    case kIROp_Param:
+    case kIROp_Var:
+    case kIROp_LoopExitValue:
+        // These aren't computations.
+        return 0;
+
+    case kIROp_Div:
+    case kIROp_FRem:
+    case kIROp_IRem:
+        opCost = 4;
+        break;
+
+    case kIROp_Call:
+        {
+            // Estimate the cost of a call by the size of the callee's body.
+            opCost = kCheckpointDefaultCallCost;
+            auto callee = as<IRFunc>(getResolvedInstForDecorations(inst->getOperand(0), true));
+            if (callee && callee->getFirstBlock())
+            {
+                opCost = 0;
+                for (auto block : callee->getBlocks())
+                    opCost += block->getChildren().getCount();
+            }
+            return opCost * getTripCount(inst);
+        }
+    }
+
+    // Operations on vectors and matrices cost one operation per 32-bit lane.
+    IRSizeAndAlignment sizeAndAlignment;
+    IRIntegerValue lanes = 1;
+    if (inst->getDataType() &&
+        SLANG_SUCCEEDED(
+            getNaturalSizeAndAlignment(optionSet, inst->getDataType(), &sizeAndAlignment)) &&
+        sizeAndAlignment.size != IRSizeAndAlignment::kIndeterminateSize)
+    {
+        lanes = Math::Max(sizeAndAlignment.size / 4, IRIntegerValue(1));
+    }
+    return opCost * lanes * getTripCount(inst);
+}
+
+// Can the min-cut policy choose between storing and recomputing `inst`?
+//
+// These are the values the default policy recomputes because they are cheap, and which can
+// just as well be stored.
+//
+bool MinCutCheckpointPolicy::isFreeToCheckpoint(IRInst* inst)
+{
+    if (as<IRType>(inst) || !inst->getDataType() || !canTypeBeStored(inst->getDataType()))
+        return false;
+
+    switch (inst->getOp())
+    {
+    case kIROp_Add:
+    case kIROp_Sub:
+    case kIROp_Mul:
+    case kIROp_Div:
+    case kIROp_Neg:
+    case kIROp_Geq:
+    case kIROp_FRem:
+    case kIROp_IRem:
+    case kIROp_Leq:
+    case kIROp_Neq:
+    case kIROp_Eql:
+    case kIROp_Greater:
+    case kIROp_Less:
+    case kIROp_And:
+    case kIROp_Or:
+    case kIROp_Not:
+    case kIROp_BitNot:
+    case kIROp_BitAnd:
+    case kIROp_BitOr:
+    case kIROp_BitXor:
+    case kIROp_Lsh:
+    case kIROp_Rsh:
+    case kIROp_Select:
+    case kIROp_GetElement:
+    case kIROp_FieldExtract:
+    case kIROp_swizzle:
+    case kIROp_UpdateElement:
+    case kIROp_MatrixReshape:
+    case kIROp_VectorReshape:
+    case kIROp_GetTupleElement:
+        break;
+
+    case kIROp_Call:
+        {
+            // Only calls that the default policy would recompute, and that don't write through
+            // pointer arguments (whose vars are classified together with the call).
+            auto callee = getResolvedInstForDecorations(inst->getOperand(0), true);
+            if (getCheckpointPreference(callee) != CheckpointPreference::None)
+                return false;
+            if (!callee->findDecoration<IRReadNoneDecoration>())
+                return false;
+            auto call = as<IRCall>(inst);
+            for (UInt i = 0; i < call->getArgCount(); i++)
+            {
+                if (as<IRPtrTypeBase>(call->getArg(i)->getDataType()))
+                    return false;
+            }
+            break;
+        }
+
+    default:
+        return false;
+    }
+
+    return canRecompute(UseOrPseudoUse(nullptr, inst));
+}
+
+void MinCutCheckpointPolicy::preparePolicy(IRGlobalValueWithCode* func)
+{
+    DefaultCheckpointPolicy::preparePolicy(func);
+
+    decisions.clear();
+    summary = Summary();
+
+    // The default classification depends on these, and `processFunc` only collects them after
+    // the policy has been prepared.
+    //
+    collectInductionValues(func);
+    collectLoopExitConditions(func);
+
+    // The values that take part are the primal insts of this function. Everything else is
+    // available to the differential blocks as is.
+    //
+    auto isPrimalValue = [&](IRInst* inst)
+    {
+        if (!inst || isDifferentialInst(inst) || as<IRBlock>(inst) || as<IRFunc>(inst))
+            return false;
+        auto block = as<IRBlock>(inst->getParent());
+        return block && block->getParent() == func && !isDifferentialBlock(block);
+    };
+
+    MinCutFlowGraph graph;
+    auto source = graph.addNode();
+    auto sink = graph.addNode();
+
+    // Every value is split into two nodes, joined by an edge for storing the value. The value
+    // is available to the differential blocks if its second node is on the sink side of the
+    // cut. It is recomputed if its first node is also on the sink side, which cuts the edge from
+    // the source for recomputing it, and is stored if only its second node is.
+    //
+    struct ValueNodes
+    {
+        Index recomputeNode;
+        Index storeNode;
+        bool isFree;
+    };
+    Dictionary<IRInst*, ValueNodes> valueNodes;
+    List<IRInst*> values;
+
+    auto getValueNodes = [&](IRInst* inst)
+    {
+        if (auto nodes = valueNodes.tryGetValue(inst))
+            return *nodes;
+
+        ValueNodes nodes;
+        nodes.recomputeNode = graph.addNode();
+        nodes.storeNode = graph.addNode();
+        nodes.isFree = isFreeToCheckpoint(inst);
+        valueNodes.add(inst, nodes);
+        values.add(inst);
+        return nodes;
+    };
+
+    auto requireValue = [&](IRInst* inst)
+    {
+        if (isPrimalValue(inst))
+            graph.addEdge(getValueNodes(inst).storeNode, sink, MinCutFlowGraph::kInfiniteCapacity);
+    };
+
+    // Seed the graph with the primal values used by the differential blocks, the same way
+    // `processFunc` does.
+    //
+    for (auto block : func->getBlocks())
+    {
+        if (block == func->getFirstBlock() || !isDifferentialBlock(block))
+            continue;
+
+        for (auto child : block->getChildren())
+        {
+            if (as<IRMakeDifferentialPair>(child) && child->firstUse &&
+                as<IRReturn>(child->firstUse->getUser()))
+                continue;
+
+            for (UInt i = 0; i < child->getOperandCount(); i++)
+                requireValue(child->getOperand(i));
+
+            for (auto decoration : child->getDecorations())
+            {
+                if (auto primalCtxDecoration =
+                        as<IRBackwardDerivativePrimalContextDecoration>(decoration))
+                    requireValue(primalCtxDecoration->primalContextVar.get());
+                else if (auto loopExitDecoration = as<IRLoopExitPrimalValueDecoration>(decoration))
+                    requireValue(loopExitDecoration->exitVal.get());
+            }
+        }
+    }
+
+    // Add the edges for each value. The list grows as the dependencies of values that can be
+    // recomputed are added.
+    //
+    for (Index i = 0; i < values.getCount(); i++)
+    {
+        auto inst = values[i];
+        auto nodes = valueNodes[inst];
+
+        bool canStore = true;
+        bool canRecomputeValue = true;
+        if (!nodes.isFree)
+        {
+            auto defaultResult = DefaultCheckpointPolicy::classify(UseOrPseudoUse(nullptr, inst));
+            canStore = defaultResult.mode == HoistResult::Mode::Store;
+            canRecomputeValue = !canStore;
+        }
+
+        graph.addEdge(
+            nodes.recomputeNode,
+            nodes.storeNode,
+            canStore ? getStoreCost(inst) * kCheckpointCostPerStoredByte
+                     : MinCutFlowGraph::kInfiniteCapacity);
+        graph.addEdge(
+            source,
+            nodes.recomputeNode,
+            canRecomputeValue ? getRecomputeCost(inst) * kCheckpointCostPerRecomputedOp
+                              : MinCutFlowGraph::kInfiniteCapacity);
+
+        if (!canRecomputeValue)
+            continue;
+
+        // A value can only be recomputed if its dependencies are available.
+        auto addDependency = [&](IRInst* dependency)
+        {
+            if (!isPrimalValue(dependency))
+                return;
+            graph.addEdge(
+                getValueNodes(dependency).storeNode,
+                nodes.recomputeNode,
+                MinCutFlowGraph::kInfiniteCapacity);
+        };
+
+        if (auto param = as<IRParam>(inst))
+        {
+            // A recomputed phi param depends on the arguments of its predecessors, unless it is
+            // replaced by the loop counter.
+            if (inductionValueInsts.containsKey(param))
+                continue;
+            auto paramBlock = as<IRBlock>(param->getParent());
+            UIndex paramIndex = 0;
+            for (auto blockParam : paramBlock->getParams())
+            {
+                if (blockParam == param)
+                    break;
+                paramIndex++;
+            }
+            for (auto predecessor : paramBlock->getPredecessors())
+            {
+                auto branch = as<IRUnconditionalBranch>(predecessor->getTerminator());
+                if (branch && branch->getArgCount() > paramIndex)
+                    addDependency(branch->getArg(paramIndex));
+            }
+        }
+        else if (!as<IRVar>(inst) && !as<IRLoopExitValue>(inst))
+        {
+            for (UInt j = 0; j < inst->getOperandCount(); j++)
+                addDependency(inst->getOperand(j));
+        }
+    }
+
+    List<bool> isSourceSide;
+    graph.computeMinCut(source, sink, isSourceSide);
+
+    for (auto inst : values)
+    {
+        auto nodes = valueNodes[inst];
+        if (isSourceSide[nodes.storeNode])
+        {
+            // Not needed by the differential blocks after all.
+            continue;
+        }
+
+        HoistResult::Mode mode;
+        if (isSourceSide[nodes.recomputeNode])
+        {
+            mode = HoistResult::Mode::Store;
+            summary.storeCount++;
+            summary.storeBytes += getStoreCost(inst);
+        }
+        else
+        {
+            mode = HoistResult::Mode::Recompute;
+            summary.recomputeCount++;
+            summary.recomputeCost += getRecomputeCost(inst);
+        }
+
+        if (nodes.isFree)
+            decisions[inst] = mode;
+    }
+}
+
+HoistResult MinCutCheckpointPolicy::classify(UseOrPseudoUse use)
+{
+    if (auto mode = decisions.tryGetValue(use.usedVal))
+    {
+        if (*mode == HoistResult::Mode::Store)
+            return HoistResult::store(use.usedVal);
+        return HoistResult::recompute(use.usedVal);
+    }
+    return DefaultCheckpointPolicy::classify(use);
+}
 }; // namespace Slang
@@ -340,9 +340,74 @@ public:
     virtual void preparePolicy(IRGlobalValueWithCode* func);
     virtual HoistResult classify(UseOrPseudoUse use);
 
-private:
+protected:
     bool canRecompute(UseOrPseudoUse use);
 };
 
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func);
+// A policy that weighs storing a primal value against recomputing it.
+//
+// The primal values that the differential blocks depend on form a graph, where a value
+// can be made available either by storing it, or by recomputing it from its operands (which
+// then have to be made available in turn). The policy finds the cheapest choice for every
+// value at once as a minimum cut of that graph, where storing costs the bytes of the value,
+// recomputing costs an estimate of its ALU work, and both are scaled by the trip counts of
+// the enclosing loops.
+//
+// Only values that the default policy could either store or recompute are decided this way.
+// Everything else (vars, phi params, calls with side effects, ...) is classified as the default
+// policy would, and acts as a fixed point in the graph.
+//
+class MinCutCheckpointPolicy : public DefaultCheckpointPolicy
+{
+public:
+    MinCutCheckpointPolicy(
+        IRModule* module,
+        CompilerOptionSet& optionSet,
+        Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo)
+        : DefaultCheckpointPolicy(module), optionSet(optionSet), blockIndexInfo(blockIndexInfo)
+    {
+    }
+
+    virtual void preparePolicy(IRGlobalValueWithCode* func);
+    virtual HoistResult classify(UseOrPseudoUse use);
+
+    // The totals for the values the cut chose to store or recompute, including the fixed ones.
+    // Costs are scaled by the trip counts of the enclosing loops.
+    //
+    struct Summary
+    {
+        Count storeCount = 0;
+        IRIntegerValue storeBytes = 0;
+        Count recomputeCount = 0;
+        IRIntegerValue recomputeCost = 0;
+    };
+
+    const Summary& getSummary() const { return summary; }
+
+private:
+    IRIntegerValue getTripCount(IRInst* inst);
+    IRIntegerValue getStoreCost(IRInst* inst);
+    IRIntegerValue getRecomputeCost(IRInst* inst);
+    bool isFreeToCheckpoint(IRInst* inst);
+
+    CompilerOptionSet& optionSet;
+    Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo;
+
+    // The choice made by the cut for each value it was free to decide.
+    Dictionary<IRInst*, HoistResult::Mode> decisions;
+
+    Summary summary;
+};
+
+// For each primal inst that is used in reverse blocks, decide if we should recompute or store
+// its value, then make them accessible in reverse blocks based the decision.
+//
+// `targetProgram` selects the checkpoint policy (see `CompilerOptionName::MinCutCheckpointPolicy`)
+// and `sink` is used to report its decisions. Either may be null, in which case the default
+// policy is used.
+//
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    TargetProgram* targetProgram = nullptr,
+    DiagnosticSink* sink = nullptr);
 }; // namespace Slang
@@ -859,7 +859,10 @@ void BackwardDiffTranscriberBase::transcribeFuncImpl(
 
     // Apply checkpointing policy to legalize cross-scope uses of primal values
     // using either recompute or store strategies.
-    auto primalsInfo = applyCheckpointPolicy(diffPropagateFunc);
+    auto primalsInfo = applyCheckpointPolicy(
+        diffPropagateFunc,
+        autoDiffSharedContext->targetProgram,
+        getSink());
 
     eliminateDeadCode(diffPropagateFunc);
 
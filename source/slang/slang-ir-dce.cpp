@@ -266,9 +266,11 @@ struct DeadCodeEliminationContext
             }
             if (changed)
             {
-                // If the function body is changed, invalidate its dominator tree.
+                // If the function body is changed, invalidate its analyses. Any blocks or
+                // terminators removed are tracked by the CFG version, so analyses of the
+                // control flow graph are preserved.
                 if (auto func = as<IRGlobalValueWithCode>(inst))
-                    module->invalidateAnalysisForInst(func);
+                    module->invalidateAnalysisForInst(func, IRAnalysisKind::CFGOnly);
             }
         }
         return changed;
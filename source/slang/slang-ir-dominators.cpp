@@ -849,4 +849,11 @@ RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code)
     return context.createDominatorTree(code);
 }
 
+RefPtr<IRDominatorTree> findOrComputeDominatorTree(IRGlobalValueWithCode* code)
+{
+    if (auto module = code->getModule())
+        return module->findOrCreateDominatorTree(code);
+    return computeDominatorTree(code);
+}
+
 } // namespace Slang
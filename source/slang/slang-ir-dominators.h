@@ -167,6 +167,10 @@ private:
 
 RefPtr<IRDominatorTree> computeDominatorTree(IRGlobalValueWithCode* code);
 
+/// Get the dominator tree for `code`, reusing the one cached by its module if the control flow
+/// graph of `code` hasn't changed since it was computed.
+RefPtr<IRDominatorTree> findOrComputeDominatorTree(IRGlobalValueWithCode* code);
+
 void computePostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder);
 void computePostorder(
     IRGlobalValueWithCode* code,
@@ -20,6 +20,7 @@
 
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-unroll-inline-heuristics.h"
 #include "slang-ir.h"
 
 namespace Slang
@@ -1110,6 +1111,40 @@ bool performForceInlining(IRGlobalValueWithCode* func)
     return pass.considerAllCallSitesRec(func);
 }
 
+/// An inlining pass that inlines the calls a cost model finds worthwhile.
+struct HeuristicInliningPass : InliningPassBase
+{
+    typedef InliningPassBase Super;
+
+    UnrollAndInlineHeuristics* m_heuristics;
+
+    HeuristicInliningPass(IRModule* module, UnrollAndInlineHeuristics* heuristics)
+        : Super(module), m_heuristics(heuristics)
+    {
+    }
+
+    bool shouldInline(CallSiteInfo const& info)
+    {
+        // Leave functions that are marked as not to be inlined, or whose definition may be
+        // replaced by one specific to the target.
+        auto callee = info.callee;
+        if (callee->findDecoration<IRNoInlineDecoration>() ||
+            callee->findDecoration<IRTargetSpecificDecoration>() ||
+            callee->findDecoration<IRKnownBuiltinDecoration>() ||
+            callee->findDecoration<IRIntrinsicOpDecoration>())
+            return false;
+        return m_heuristics->shouldInline(info.call, callee);
+    }
+};
+
+bool performHeuristicInlining(IRModule* module, UnrollAndInlineHeuristics* heuristics)
+{
+    SLANG_PROFILE;
+
+    HeuristicInliningPass pass(module, heuristics);
+    return pass.considerAllCallSites();
+}
+
 struct PreAutoDiffForceInliningPass : InliningPassBase
 {
     typedef InliningPassBase Super;
@@ -12,6 +12,7 @@ struct IRGlobalValueWithCode;
 class DiagnosticSink;
 class TargetProgram;
 struct IRInst;
+struct UnrollAndInlineHeuristics;
 
 /// Any call to a function that takes or returns a string/RefType parameter is inlined
 Result performTypeInlining(IRModule* module, DiagnosticSink* sink);
@@ -25,6 +26,9 @@ void performForceInlining(IRModule* module);
 /// Inline any call sites to functions marked `[ForceInline]` inside `func`.
 bool performForceInlining(IRGlobalValueWithCode* func);
 
+/// Inline the call sites that `heuristics` finds worth inlining.
+bool performHeuristicInlining(IRModule* module, UnrollAndInlineHeuristics* heuristics);
+
 /// Perform force inlining of functions that does not have custom derivatives.
 bool performPreAutoDiffForceInlining(IRGlobalValueWithCode* func);
 
@@ -880,6 +880,10 @@ INST_RANGE(BindingQuery, GetRegisterIndex, GetRegisterSpace)
 
     INST(AvailableInDownstreamIRDecoration, availableInDownstreamIR, 1, 0)
 
+        // Marks a function that came from the target IR snapshot of a module,
+        // and so has already been linked and simplified for the target.
+    INST(TargetIRSnapshotDecoration, targetIRSnapshot, 0, 0)
+
         // Added to IRParam parameters to an entry point
     /* GeometryInputPrimitiveTypeDecoration */
         INST(PointInputPrimitiveTypeDecoration,  pointPrimitiveType,     0, 0)
@@ -1373,6 +1377,7 @@ INST(DebugNoScope, DebugNoScope, 1, 0)
 
 /* Embedded Precompiled Libraries */
 INST(EmbeddedDownstreamIR, EmbeddedDownstreamIR, 2, 0)
+INST(EmbeddedTargetIR, EmbeddedTargetIR, 4, 0)
 
 /* Inline assembly */
 
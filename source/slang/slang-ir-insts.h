@@ -496,6 +496,8 @@ struct IRAvailableInDownstreamIRDecoration : IRDecoration
     }
 };
 
+IR_SIMPLE_DECORATION(TargetIRSnapshotDecoration)
+
 struct IRGLSLLocationDecoration : IRDecoration
 {
     IR_LEAF_ISA(GLSLLocationDecoration)
@@ -3636,6 +3638,23 @@ struct IREmbeddedDownstreamIR : IRInst
     IRBlobLit* getBlob() { return cast<IRBlobLit>(getOperand(1)); }
 };
 
+/// A snapshot of the IR of the functions of a module, linked and simplified for a target,
+/// see `Module::precompileTargetIR`. The blob holds a serialized IR module.
+struct IREmbeddedTargetIR : IRInst
+{
+    IR_LEAF_ISA(EmbeddedTargetIR)
+    CodeGenTarget getTarget()
+    {
+        return static_cast<CodeGenTarget>(cast<IRIntLit>(getOperand(0))->getValue());
+    }
+    /// The capabilities of the target the snapshot was linked for
+    IRCapabilitySet* getTargetCaps() { return cast<IRCapabilitySet>(getOperand(1)); }
+    /// The digest of the options the snapshot was simplified with,
+    /// see `getTargetIRSnapshotOptionsDigest`
+    IRStringLit* getOptionsDigest() { return cast<IRStringLit>(getOperand(2)); }
+    IRBlobLit* getBlob() { return cast<IRBlobLit>(getOperand(3)); }
+};
+
 struct IRBuilderSourceLocRAII;
 
 struct IRBuilder
@@ -4347,6 +4366,11 @@ public:
         IRInst* value);
 
     IRInst* emitEmbeddedDownstreamIR(CodeGenTarget target, ISlangBlob* blob);
+    IRInst* emitEmbeddedTargetIR(
+        CodeGenTarget target,
+        CapabilitySet const& targetCaps,
+        UnownedStringSlice const& optionsDigest,
+        ISlangBlob* blob);
 
     IRFunc* createFunc();
     IRGlobalVar* createGlobalVar(IRType* valueType);
@@ -2,6 +2,7 @@
 #include "slang-ir-link.h"
 
 #include "../compiler-core/slang-artifact.h"
+#include "../core/slang-crypto.h"
 #include "../core/slang-performance-profiler.h"
 #include "slang-capability.h"
 #include "slang-ir-autodiff.h"
@@ -13,6 +14,7 @@
 #include "slang-legalize-types.h"
 #include "slang-mangle.h"
 #include "slang-module-library.h"
+#include "slang-serialize-container.h"
 
 namespace Slang
 {
@@ -23,10 +25,18 @@ namespace Slang
 /// for an explanation of the problems.
 EntryPointLayout* findEntryPointLayout(ProgramLayout* programLayout, EntryPoint* entryPoint);
 
+/// The global values that share a mangled name across all of the modules being linked.
 struct IRSpecSymbol : RefObject
 {
-    IRInst* irGlobalValue;
-    RefPtr<IRSpecSymbol> nextWithSameName;
+    /// The values are copied out of the symbol indices of the modules, as an index can be
+    /// rebuilt (and so reallocated) whilst the symbol is cached.
+    ///
+    /// The order is the one candidates have always been considered in, as ties between equally
+    /// good candidates for a target go to the earliest: the first value found, followed by
+    /// the rest in the reverse of the order they were found in.
+    List<IRInst*> values;
+
+    IRInst* getFirstValue() const { return values[0]; }
 };
 
 struct IRSpecEnv
@@ -49,14 +59,12 @@ struct IRSharedSpecContext
     // The specialized module we are building
     RefPtr<IRModule> module;
 
-    // A map from mangled symbol names to zero or
-    // more global IR values that have that name,
-    // in the *original* module.
+    // A cache of the symbols looked up so far, from mangled
+    // names to the global IR values that have that name in
+    // the *original* modules, or null if there are none.
     typedef Dictionary<ImmutableHashedString, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
-    Dictionary<ImmutableHashedString, bool> isImportedSymbol;
-
     bool useAutodiff = false;
 
     IRBuilder builderStorage;
@@ -65,8 +73,6 @@ struct IRSharedSpecContext
     IRSpecEnv globalEnv;
 };
 
-void insertGlobalValueSymbol(IRSharedSpecContext* sharedContext, IRInst* gv);
-
 struct WitnessTableCloneInfo : RefObject
 {
     IRWitnessTable* clonedTable;
@@ -90,18 +96,34 @@ struct IRSpecContextBase
     IRSpecSymbol* findSymbols(UnownedStringSlice mangledName)
     {
         ImmutableHashedString hashedName(mangledName);
+        if (auto found = shared->symbols.tryGetValue(hashedName))
+            return *found;
+
+        // Each module builds its index of mangled names once, when it is created or
+        // loaded, so we only need to consult those indices here rather than walking
+        // the global instructions of every module (including the core module) on
+        // every link.
+        //
         RefPtr<IRSpecSymbol> symbol;
-        if (shared->symbols.tryGetValue(hashedName, symbol))
-            return symbol;
         for (auto m : irModules)
         {
-            for (auto inst : m->findSymbolByMangledName(hashedName))
-                insertGlobalValueSymbol(shared, inst);
+            auto values = m->findSymbolByMangledName(hashedName);
+            if (values.getCount() == 0)
+                continue;
+
+            if (!symbol)
+                symbol = new IRSpecSymbol();
+            symbol->values.addRange(values.getBuffer(), values.getCount());
         }
-        if (shared->symbols.tryGetValue(hashedName, symbol))
-            return symbol;
-        shared->symbols[hashedName] = nullptr;
-        return nullptr;
+        if (symbol && symbol->values.getCount() > 2)
+        {
+            // Keep the first value first, and reverse the rest
+            auto& values = symbol->values;
+            for (Index i = 1, j = values.getCount() - 1; i < j; ++i, --j)
+                Swap(values[i], values[j]);
+        }
+        shared->symbols[hashedName] = symbol;
+        return symbol;
     }
 
     // The current specialization environment to use.
@@ -185,9 +207,10 @@ void registerClonedValue(
     IROriginalValuesForClone const& originalValues)
 {
     registerClonedValue(context, clonedValue, originalValues.originalVal);
-    for (auto s = originalValues.sym; s; s = s->nextWithSameName)
+    if (originalValues.sym)
     {
-        registerClonedValue(context, clonedValue, s->irGlobalValue);
+        for (auto value : originalValues.sym->values)
+            registerClonedValue(context, clonedValue, value);
     }
 }
 
@@ -536,9 +559,10 @@ static void cloneExtraDecorations(
         builder->setInsertBefore(firstChild);
     }
 
-    for (auto sym = originalValues.sym; sym; sym = sym->nextWithSameName)
+    if (originalValues.sym)
     {
-        cloneExtraDecorationsFromInst(context, builder, clonedInst, sym->irGlobalValue);
+        for (auto value : originalValues.sym->values)
+            cloneExtraDecorationsFromInst(context, builder, clonedInst, value);
     }
 }
 
@@ -623,10 +647,11 @@ IRGeneric* cloneGenericImpl(
     // We want to clone extra decorations on the
     // return value from other symbols as well.
     auto clonedInnerVal = findGenericReturnVal(clonedVal);
-    for (auto originalSym = originalValues.sym; originalSym;
-         originalSym = originalSym->nextWithSameName.get())
+    auto originalSymValues =
+        originalValues.sym ? originalValues.sym->values.getArrayView() : ArrayView<IRInst*>();
+    for (auto originalSymValue : originalSymValues)
     {
-        auto originalGeneric = as<IRGeneric>(originalSym->irGlobalValue);
+        auto originalGeneric = as<IRGeneric>(originalSymValue);
         if (!originalGeneric)
             continue;
         auto originalInnerVal = findGenericReturnVal(originalGeneric);
@@ -1069,7 +1094,7 @@ IRFunc* specializeIRForEntryPoint(
     // follow the linkage decoration and discover the
     // other values on its own.
     //
-    auto originalVal = sym->irGlobalValue;
+    auto originalVal = sym->getFirstValue();
 
     // We will start by cloning the entry point reference
     // like any other global value.
@@ -1298,6 +1323,15 @@ bool isBetterForTarget(IRSpecContext* context, IRInst* newVal, IRInst* oldVal)
     if (newIsDef != oldIsDef)
         return newIsDef;
 
+    // All preceding factors being equal, a definition from a
+    // target IR snapshot is better, because it has already been
+    // linked and simplified for our target.
+    //
+    bool newIsSnapshot = newVal->findDecoration<IRTargetIRSnapshotDecoration>() != nullptr;
+    bool oldIsSnapshot = oldVal->findDecoration<IRTargetIRSnapshotDecoration>() != nullptr;
+    if (newIsSnapshot != oldIsSnapshot)
+        return newIsSnapshot;
+
     return false;
 }
 
@@ -1517,9 +1551,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // definitions over declarations.
     //
     IRInst* bestVal = nullptr;
-    for (IRSpecSymbol* ss = sym; ss; ss = ss->nextWithSameName)
+    for (IRInst* newVal : sym->values)
     {
-        IRInst* newVal = ss->irGlobalValue;
         if (isBetterForTarget(context, newVal, bestVal))
             bestVal = newVal;
     }
@@ -1557,49 +1590,6 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(IRSharedSpecContext* sharedContext, IRInst* gv)
-{
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
-
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
-        return;
-
-    auto mangledName = String(linkage->getMangledName());
-
-    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
-    sym->irGlobalValue = gv;
-
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.tryGetValue(mangledName, prev))
-    {
-        sym->nextWithSameName = prev->nextWithSameName;
-        prev->nextWithSameName = sym;
-    }
-    else
-    {
-        sharedContext->symbols.add(mangledName, sym);
-    }
-
-    if (as<IRImportDecoration>(linkage))
-        sharedContext->isImportedSymbol.tryGetValueOrAdd(mangledName, true);
-    else
-        sharedContext->isImportedSymbol.set(mangledName, false);
-}
-
-void insertGlobalValueSymbols(IRSharedSpecContext* sharedContext, IRModule* originalModule)
-{
-    if (!originalModule)
-        return;
-
-    for (auto ii : originalModule->getGlobalInsts())
-    {
-        insertGlobalValueSymbol(sharedContext, ii);
-    }
-}
-
 void initializeSharedSpecContext(
     IRSharedSpecContext* sharedContext,
     Session* session,
@@ -1644,6 +1634,73 @@ struct IRSpecializationState
     }
 };
 
+String getTargetIRSnapshotOptionsDigest(CompilerOptionSet& optionSet)
+{
+    // The passes run on a snapshot before it is stored (linking, specialization, early
+    // inlining and simplification) depend on these options.
+    DigestBuilder<SHA1> builder;
+    builder.append(optionSet.getOptimizationLevel());
+    builder.append(optionSet.shouldPerformMinimumOptimizations());
+    builder.append(optionSet.getFloatingPointMode());
+    builder.append(optionSet.getMatrixLayoutMode());
+    builder.append(optionSet.getBoolOption(CompilerOptionName::DisableSpecialization));
+    builder.append(optionSet.getBoolOption(CompilerOptionName::DisableDynamicDispatch));
+    builder.append(optionSet.getBoolOption(CompilerOptionName::EnableExperimentalPasses));
+    builder.append(optionSet.getBoolOption(CompilerOptionName::LoopInversion));
+    return builder.finalize().toString();
+}
+
+/// Find the target IR snapshot embedded in `module` that was linked for the target of
+/// `targetProgram` with the same options, decoding it if this is the first time it is needed.
+static IRModule* _findTargetIRSnapshot(IRModule* module, TargetProgram* targetProgram)
+{
+    auto targetReq = targetProgram->getTargetReq();
+    auto& optionSet = targetProgram->getOptionSet();
+
+    // Snapshots are stored without source locations, so they can't be used when
+    // debug information is wanted.
+    if (optionSet.getDebugInfoLevel() != DebugInfoLevel::None)
+        return nullptr;
+
+    String optionsDigest;
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto embeddedInst = as<IREmbeddedTargetIR>(inst);
+        if (!embeddedInst || embeddedInst->getTarget() != targetReq->getTarget())
+            continue;
+
+        // The choice between target specific definitions made when the snapshot was
+        // linked is only valid for the same capabilities.
+        if (!(embeddedInst->getTargetCaps()->getCaps() == targetReq->getTargetCaps()))
+            continue;
+
+        // The snapshot was simplified with the options of the program that produced it,
+        // which must be the ones we would simplify with.
+        if (optionsDigest.getLength() == 0)
+            optionsDigest = getTargetIRSnapshotOptionsDigest(optionSet);
+        if (embeddedInst->getOptionsDigest()->getStringSlice() != optionsDigest.getUnownedSlice())
+            continue;
+
+        auto& decodedSnapshots = module->getDecodedTargetIRSnapshots();
+        if (auto found = decodedSnapshots.tryGetValue(embeddedInst))
+            return *found;
+
+        // If the snapshot can't be read, we record that so we don't try again, and link the
+        // module as usual.
+        RefPtr<IRModule> snapshotModule;
+        if (SLANG_FAILED(decodeModuleIRFromBlob(
+                snapshotModule,
+                embeddedInst->getBlob()->getStringSlice(),
+                module->getSession())))
+        {
+            snapshotModule = nullptr;
+        }
+        decodedSnapshots.add(embeddedInst, snapshotModule);
+        return snapshotModule;
+    }
+    return nullptr;
+}
+
 static bool _isHLSLExported(IRInst* inst)
 {
     for (auto decoration : inst->getDecorations())
@@ -2074,6 +2131,21 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
 
     Index userModuleCount = irModules.getCount();
     irModules.addRange(builtinModules);
+
+    // A module can carry a snapshot of the IR of its functions, already linked and
+    // simplified for our target. The definitions in a snapshot are preferred by
+    // `isBetterForTarget`, and everything else they refer to is resolved against
+    // the other modules as usual, so the snapshots are just added to the modules
+    // we link against.
+    //
+    List<IRModule*> snapshotModules;
+    for (Index i = 0; i < userModuleCount; ++i)
+    {
+        if (auto snapshotModule = _findTargetIRSnapshot(irModules[i], targetProgram))
+            snapshotModules.add(snapshotModule);
+    }
+    irModules.addRange(snapshotModules);
+
     ArrayView<IRModule*> userModules = irModules.getArrayView(0, userModuleCount);
 
     // Check if any user module uses auto-diff, if so we will need to link
@@ -25,6 +25,17 @@ struct LinkedIR
 //
 LinkedIR linkIR(CodeGenContext* codeGenContext);
 
+// Get a digest of the options in `optionSet` that change the IR of a target IR snapshot
+// (see `Module::precompileTargetIR`). A snapshot is only linked into programs compiled
+// with options that have the same digest.
+//
+String getTargetIRSnapshotOptionsDigest(CompilerOptionSet& optionSet);
+
+// Is `decor` one of the decorations used by automatic differentiation,
+// which are only linked when a module uses it.
+//
+bool isAutoDiffDecoration(IRInst* decor);
+
 // Replace any global constants in the IR module with their
 // definitions, if possible.
 //
@@ -1,5 +1,6 @@
 #include "slang-ir-liveness.h"
 
+#include "../core/slang-uint-set.h"
 #include "slang-ir-dominators.h"
 #include "slang-ir-insts.h"
 #include "slang-ir.h"
@@ -1341,7 +1342,7 @@ void LivenessContext::_processFunction(IRFunc* func)
     SLANG_ASSERT(m_rangeStarts.getCount() > 0);
 
     // Create the dominator tree, for the function
-    m_dominatorTree = computeDominatorTree(func);
+    m_dominatorTree = findOrComputeDominatorTree(func);
 
     // We are going to precalculate a variety of things for blocks.
     // Most processing is performed via BlockIndex, so we need to set up a map from the block
@@ -1674,4 +1675,128 @@ static void _processFunction(IRFunc* funcInst, List<IRVar*>& ioVars)
     }
 }
 
+// True if inst produces a value that needs to be held somewhere until its last use.
+static bool _isLiveValue(IRInst* inst)
+{
+    if (!inst->hasUses() || as<IRVar>(inst) || as<IRType>(inst))
+        return false;
+    auto type = inst->getDataType();
+    return type && !as<IRVoidType>(type);
+}
+
+/* static */ Count LivenessUtil::calcMaxLiveValueCount(
+    IRGlobalValueWithCode* func,
+    Dictionary<IRBlock*, Count>* outBlockLiveCounts)
+{
+    // Number the values, and find the values each block uses before defining them (`uses`) and
+    // the values it defines (`defs`).
+    Dictionary<IRInst*, UInt> mapInstToIndex;
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            if (_isLiveValue(inst))
+                mapInstToIndex.add(inst, UInt(mapInstToIndex.getCount()));
+        }
+    }
+    if (mapInstToIndex.getCount() == 0)
+        return 0;
+
+    const UInt valueCount = UInt(mapInstToIndex.getCount());
+    List<IRBlock*> blocks;
+    Dictionary<IRBlock*, Index> mapBlockToIndex;
+    for (auto block : func->getBlocks())
+    {
+        mapBlockToIndex.add(block, blocks.getCount());
+        blocks.add(block);
+    }
+
+    List<UIntSet> uses, defs, liveIns, liveOuts;
+    uses.setCount(blocks.getCount());
+    defs.setCount(blocks.getCount());
+    liveIns.setCount(blocks.getCount());
+    liveOuts.setCount(blocks.getCount());
+    for (Index i = 0; i < blocks.getCount(); i++)
+    {
+        uses[i].resizeAndClear(valueCount);
+        defs[i].resizeAndClear(valueCount);
+        liveIns[i].resizeAndClear(valueCount);
+        liveOuts[i].resizeAndClear(valueCount);
+
+        for (auto inst : blocks[i]->getChildren())
+        {
+            for (UInt j = 0; j < inst->getOperandCount(); j++)
+            {
+                if (auto index = mapInstToIndex.tryGetValue(inst->getOperand(j)))
+                {
+                    if (!defs[i].contains(*index))
+                        uses[i].add(*index);
+                }
+            }
+            if (auto index = mapInstToIndex.tryGetValue(inst))
+                defs[i].add(*index);
+        }
+    }
+
+    // A value is live into a block if the block uses it, or if it is live out of the block and
+    // the block doesn't define it. Values passed to the parameters of a successor are operands of
+    // the branch, so they are already counted as uses of the predecessor.
+    bool changed = true;
+    UIntSet liveIn;
+    while (changed)
+    {
+        changed = false;
+        for (Index i = blocks.getCount() - 1; i >= 0; i--)
+        {
+            for (auto succ : blocks[i]->getSuccessors())
+                liveOuts[i].unionWith(liveIns[mapBlockToIndex[succ]]);
+
+            liveIn = liveOuts[i];
+            liveIn.subtractWith(defs[i]);
+            liveIn.unionWith(uses[i]);
+            if (liveIn != liveIns[i])
+            {
+                liveIns[i] = liveIn;
+                changed = true;
+            }
+        }
+    }
+
+    // Walk each block backwards from the values live out of it, to find the most values live at
+    // any one point.
+    Count maxLiveCount = 0;
+    UIntSet live;
+    for (Index i = 0; i < blocks.getCount(); i++)
+    {
+        live = liveOuts[i];
+        Count liveCount = live.countElements();
+        Count blockMaxLiveCount = liveCount;
+        for (auto inst = blocks[i]->getLastChild(); inst; inst = inst->getPrevInst())
+        {
+            if (auto index = mapInstToIndex.tryGetValue(inst))
+            {
+                if (live.contains(*index))
+                {
+                    live.remove(*index);
+                    liveCount--;
+                }
+            }
+            for (UInt j = 0; j < inst->getOperandCount(); j++)
+            {
+                auto index = mapInstToIndex.tryGetValue(inst->getOperand(j));
+                if (index && !live.contains(*index))
+                {
+                    live.add(*index);
+                    liveCount++;
+                }
+            }
+            blockMaxLiveCount = Math::Max(blockMaxLiveCount, liveCount);
+        }
+        maxLiveCount = Math::Max(maxLiveCount, blockMaxLiveCount);
+        if (outBlockLiveCounts)
+            outBlockLiveCounts->set(blocks[i], blockMaxLiveCount);
+    }
+    return maxLiveCount;
+}
+
 } // namespace Slang
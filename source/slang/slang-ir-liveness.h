@@ -195,6 +195,16 @@ struct LivenessUtil
 
     /// Adds LiveRangeEnd instructions to demark the end of all of the liveness starts in the module
     static void addRangeEnds(IRModule* module, LivenessMode mode);
+
+    /// Returns the largest number of SSA values that are live at the same point in the function.
+    /// Unlike the variable ranges above, this is about the values held in registers, and is an
+    /// estimate of the register pressure the function's code will have in a downstream compiler.
+    ///
+    /// If `outBlockLiveCounts` is set, the largest number of values live at once within each
+    /// block is added to it.
+    static Count calcMaxLiveValueCount(
+        IRGlobalValueWithCode* func,
+        Dictionary<IRBlock*, Count>* outBlockLiveCounts = nullptr);
 };
 
 } // namespace Slang
@@ -7,6 +7,7 @@
 #include "slang-ir-insts.h"
 #include "slang-ir-peephole.h"
 #include "slang-ir-simplify-cfg.h"
+#include "slang-ir-unroll-inline-heuristics.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
 
@@ -49,10 +50,10 @@ static bool _eliminateDeadBlocks(List<IRBlock*>& blocks, IRBlock* unreachableBlo
     return changed;
 }
 
+static constexpr int kMaxIterationsToAttempt = 4096;
+
 static int _getLoopMaxIterationsToUnroll(IRLoop* loopInst)
 {
-    static constexpr int kMaxIterationsToAttempt = 4096;
-
     auto forceUnrollDecor = loopInst->findDecoration<IRForceUnrollDecoration>();
     if (!forceUnrollDecor)
         return -1;
@@ -146,7 +147,7 @@ static void _foldAndSimplifyLoopIteration(
     }
 }
 
-// Unroll loop up to a predefined maximum number of iterations.
+// Unroll loop up to `maxIterations` iterations, or not at all if `maxIterations` is negative.
 // Returns true if we can statically determine that the loop terminated within the iteration limit.
 // This operation assumes the loop does not have `continue` jumps, i.e. continueBlock ==
 // targetBlock.
@@ -154,7 +155,8 @@ static bool _unrollLoop(
     TargetProgram* targetProgram,
     IRModule* module,
     IRLoop* loopInst,
-    List<IRBlock*>& blocks)
+    List<IRBlock*>& blocks,
+    int maxIterations)
 {
     if (blocks.getCount() == 0)
     {
@@ -165,7 +167,6 @@ static bool _unrollLoop(
         return true;
     }
 
-    auto maxIterations = _getLoopMaxIterationsToUnroll(loopInst);
     if (maxIterations < 0)
         return true;
 
@@ -471,7 +472,8 @@ bool unrollLoopsInFunc(
 
         auto blocks = collectBlocksInRegion(func, loop);
         auto loopLoc = loop->sourceLoc;
-        if (!_unrollLoop(targetProgram, module, loop, blocks))
+        auto maxIterations = _getLoopMaxIterationsToUnroll(loop);
+        if (!_unrollLoop(targetProgram, module, loop, blocks, maxIterations))
         {
             if (sink)
                 sink->diagnose(loopLoc, Diagnostics::cannotUnrollLoop);
@@ -505,6 +507,89 @@ bool unrollLoopsInModule(TargetProgram* target, IRModule* module, DiagnosticSink
     return true;
 }
 
+// Returns the most times a loop can run, if it is known and the loop may be unrolled, or -1.
+static IRIntegerValue _getLoopMaxIterationsForHeuristics(IRLoop* loopInst)
+{
+    if (auto loopControl = loopInst->findDecoration<IRLoopControlDecoration>())
+    {
+        if (loopControl->getMode() == kIRLoopControl_Loop)
+            return -1;
+    }
+    auto maxItersDecor = loopInst->findDecoration<IRLoopMaxItersDecoration>();
+    auto maxIters = maxItersDecor ? as<IRIntLit>(maxItersDecor->getOperand(0)) : nullptr;
+    return maxIters ? maxIters->getValue() : -1;
+}
+
+// Returns true if unrolling `loop` in `func` up to `maxIterations` iterations removes it.
+// `_unrollLoop` only finds that out once it has changed the code, so it is run on a copy of
+// `func` that is then thrown away.
+static bool _doesLoopEndWhenUnrolled(
+    TargetProgram* target,
+    IRModule* module,
+    IRFunc* func,
+    IRLoop* loop,
+    int maxIterations)
+{
+    IRCloneEnv cloneEnv;
+    cloneEnv.squashChildrenMapping = true;
+    IRBuilder builder(module);
+    builder.setInsertBefore(func);
+    auto clonedFunc = as<IRFunc>(cloneInst(&cloneEnv, &builder, func));
+    auto clonedLoop = as<IRLoop>(cloneEnv.mapOldValToNew.getValue(loop));
+
+    eliminateContinueBlocks(module, clonedLoop);
+    auto blocks = collectBlocksInRegion(clonedFunc, clonedLoop);
+    bool loopEnded = _unrollLoop(target, module, clonedLoop, blocks, maxIterations);
+
+    clonedFunc->removeAndDeallocate();
+    return loopEnded;
+}
+
+void unrollLoopsByHeuristics(
+    TargetProgram* target,
+    IRModule* module,
+    UnrollAndInlineHeuristics* heuristics)
+{
+    SLANG_PROFILE;
+
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func)
+            continue;
+
+        List<IRLoop*> loops = collectLoopsInFunc(
+            func,
+            [](IRLoop* l) { return _getLoopMaxIterationsForHeuristics(l) > 0; });
+
+        for (auto loop : loops)
+        {
+            if (!loop->parent)
+                continue;
+
+            auto maxIters = _getLoopMaxIterationsForHeuristics(loop);
+            auto blocks = collectBlocksInRegion(func, loop);
+            if (!heuristics->shouldUnroll(loop, blocks, maxIters))
+                continue;
+
+            // The budget assumes the loop goes away once it is unrolled. A loop whose exit
+            // depends on data isn't removed, and unrolling it would only put copies of its body
+            // in front of it, so it is left as it is.
+            auto maxIterations =
+                int(Math::Min(maxIters + 1, IRIntegerValue(kMaxIterationsToAttempt)));
+            if (!_doesLoopEndWhenUnrolled(target, module, func, loop, maxIterations))
+                continue;
+
+            eliminateContinueBlocks(module, loop);
+            blocks = collectBlocksInRegion(func, loop);
+            _unrollLoop(target, module, loop, blocks, maxIterations);
+
+            simplifyCFG(func, CFGSimplificationOptions::getDefault());
+            eliminateDeadCode(func);
+        }
+    }
+}
+
 void eliminateContinueBlocks(IRModule* module, IRLoop* loopInst)
 {
     // Eliminate the continue jumps by turning a loop in the form of:
@@ -11,6 +11,7 @@ class DiagnosticSink;
 struct IRModule;
 struct IRBlock;
 class TargetProgram;
+struct UnrollAndInlineHeuristics;
 
 // Return true if successfull, false if errors occurred.
 bool unrollLoopsInFunc(
@@ -21,6 +22,14 @@ bool unrollLoopsInFunc(
 
 bool unrollLoopsInModule(TargetProgram* target, IRModule* module, DiagnosticSink* sink);
 
+// Unroll the loops with a known maximum number of iterations that `heuristics` finds worth
+// unrolling. A loop is only unrolled if it is then removed, that is, if its exit doesn't
+// depend on anything but the iterations it has run.
+void unrollLoopsByHeuristics(
+    TargetProgram* target,
+    IRModule* module,
+    UnrollAndInlineHeuristics* heuristics);
+
 // Turn a loop with continue block into a loop with only back jumps and breaks.
 // Each iteration will be wrapped in a breakable region, where everything before `continue`
 // is within the breakable region, and everything after `continue` is outside the breakable
@@ -1,8 +1,10 @@
 // slang-ir-ssa-register-allocate.cpp
 #include "slang-ir-ssa-register-allocate.h"
 
+#include "slang-ir-clone.h"
 #include "slang-ir-dominators.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-liveness.h"
 #include "slang-ir-reachability.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
@@ -161,7 +163,7 @@ struct RegisterAllocateContext
         ReachabilityContext reachabilityContext(func);
         mapTypeToRegisterList.clear();
 
-        auto dom = computeDominatorTree(func);
+        auto dom = findOrComputeDominatorTree(func);
         inOutDom = dom;
 
         // Note that if inst A does not dominate inst B, then A can't be alive at B.
@@ -333,4 +335,208 @@ RegisterAllocationResult allocateRegistersForFunc(
     return RegisterAllocationResult();
 }
 
+/// True if inst is a pure operation cheap enough to compute again on every iteration of a loop,
+/// rather than holding its result in a register across the loop.
+static bool _isCheapToRematerialize(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_Add:
+    case kIROp_Sub:
+    case kIROp_Mul:
+    case kIROp_Neg:
+    case kIROp_Not:
+    case kIROp_BitNot:
+    case kIROp_BitAnd:
+    case kIROp_BitOr:
+    case kIROp_BitXor:
+    case kIROp_Lsh:
+    case kIROp_Rsh:
+    case kIROp_And:
+    case kIROp_Or:
+    case kIROp_Eql:
+    case kIROp_Neq:
+    case kIROp_Less:
+    case kIROp_Leq:
+    case kIROp_Greater:
+    case kIROp_Geq:
+    case kIROp_Select:
+    case kIROp_IntCast:
+    case kIROp_FloatCast:
+    case kIROp_CastIntToFloat:
+    case kIROp_CastFloatToInt:
+    case kIROp_BitCast:
+    case kIROp_swizzle:
+    case kIROp_MakeVectorFromScalar:
+    case kIROp_FieldExtract:
+    case kIROp_GetElement:
+    case kIROp_GetTupleElement:
+        break;
+    default:
+        return false;
+    }
+    return isMovableInst(inst) && !inst->findDecoration<IRPreciseDecoration>();
+}
+
+struct RematerializeContext
+{
+    HashSet<IRBlock*> loopBlocks;
+    Count rematerializedCount = 0;
+
+    bool isInLoop(IRInst* inst)
+    {
+        auto block = as<IRBlock>(inst->getParent());
+        return block && loopBlocks.contains(block);
+    }
+
+    /// True if operand is live on every iteration of the loop whether or not inst is
+    /// recomputed inside it, so recomputing inst there doesn't lengthen any live range.
+    bool isLiveAcrossLoop(IRInst* operand, IRInst* inst)
+    {
+        if (!as<IRBlock>(operand->getParent()))
+            return true;
+        for (auto use = operand->firstUse; use; use = use->nextUse)
+        {
+            if (use->getUser() != inst && isInLoop(use->getUser()))
+                return true;
+        }
+        return false;
+    }
+
+    bool shouldRematerialize(IRInst* inst)
+    {
+        if (!inst->hasUses() || !_isCheapToRematerialize(inst))
+            return false;
+
+        // If the value is used after the loop, it stays live across the loop anyway.
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            if (!isInLoop(use->getUser()))
+                return false;
+        }
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            if (!isLiveAcrossLoop(inst->getOperand(i), inst))
+                return false;
+        }
+        return true;
+    }
+
+    void rematerialize(IRInst* inst)
+    {
+        // Recompute the value once in each block that uses it, just before the first use.
+        OrderedDictionary<IRBlock*, List<IRUse*>> mapBlockToUses;
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            auto block = as<IRBlock>(use->getUser()->getParent());
+            if (auto uses = mapBlockToUses.tryGetValue(block))
+                uses->add(use);
+            else
+                mapBlockToUses.add(block, List<IRUse*>{use});
+        }
+
+        IRBuilder builder(inst);
+        for (auto& pair : mapBlockToUses)
+        {
+            HashSet<IRInst*> users;
+            for (auto use : pair.value)
+                users.add(use->getUser());
+
+            IRInst* firstUser = pair.key->getFirstChild();
+            while (!users.contains(firstUser))
+                firstUser = firstUser->getNextInst();
+
+            builder.setInsertBefore(firstUser);
+            IRCloneEnv env;
+            auto clone = cloneInst(&env, &builder, inst);
+            for (auto use : pair.value)
+                builder.replaceOperand(use, clone);
+        }
+        inst->removeAndDeallocate();
+        rematerializedCount++;
+    }
+
+    /// Recompute values inside `loop` if the loop is where the function's register pressure
+    /// peaks. `blockLiveCounts` holds the most values live at once in each block, and
+    /// `maxLiveCount` the most in the function.
+    void processLoop(
+        IRDominatorTree* dom,
+        IRLoop* loop,
+        const Dictionary<IRBlock*, Count>& blockLiveCounts,
+        Count maxLiveCount)
+    {
+        loopBlocks.clear();
+        for (auto block : collectBlocksInRegion(dom, loop))
+            loopBlocks.add(block);
+
+        // Only values that are carried around a back-edge are worth recomputing.
+        bool hasBackEdge = false;
+        for (auto pred : loop->getTargetBlock()->getPredecessors())
+            hasBackEdge = hasBackEdge || loopBlocks.contains(pred);
+        if (!hasBackEdge)
+            return;
+
+        // The most values live at once anywhere in the function decides how many registers it
+        // needs. Recomputing values in a loop with fewer live values than that only costs
+        // arithmetic, without freeing any registers.
+        Count loopLiveCount = 0;
+        for (auto block : loopBlocks)
+        {
+            if (auto count = blockLiveCounts.tryGetValue(block))
+                loopLiveCount = Math::Max(loopLiveCount, *count);
+        }
+        if (loopLiveCount < maxLiveCount)
+            return;
+
+        // Values used in the loop but defined outside it dominate the loop header. Going
+        // backwards up the dominator tree visits a value before the values it uses, so a value
+        // that is recomputed can make its operands worth recomputing too.
+        for (auto block = dom->getImmediateDominator(loop->getTargetBlock()); block;
+             block = dom->getImmediateDominator(block))
+        {
+            IRInst* prevInst = nullptr;
+            for (auto inst = block->getLastChild(); inst; inst = prevInst)
+            {
+                prevInst = inst->getPrevInst();
+                if (shouldRematerialize(inst))
+                    rematerialize(inst);
+            }
+        }
+    }
+};
+
+Count rematerializeValuesUsedInLoops(IRGlobalValueWithCode* func)
+{
+    if (!func->getFirstBlock())
+        return 0;
+
+    List<IRLoop*> loops;
+    for (auto block : func->getBlocks())
+    {
+        if (auto loop = as<IRLoop>(block->getTerminator()))
+            loops.add(loop);
+    }
+    if (!loops.getCount())
+        return 0;
+
+    // Recomputing values doesn't change the control flow graph, so the tree stays valid.
+    auto dom = findOrComputeDominatorTree(func);
+    RematerializeContext context;
+    Dictionary<IRBlock*, Count> blockLiveCounts;
+    Count maxLiveCount = LivenessUtil::calcMaxLiveValueCount(func, &blockLiveCounts);
+    for (auto loop : loops)
+    {
+        const Count prevRematerializedCount = context.rematerializedCount;
+        context.processLoop(dom, loop, blockLiveCounts, maxLiveCount);
+
+        // Moving values changes where the pressure peaks
+        if (context.rematerializedCount != prevRematerializedCount)
+        {
+            blockLiveCounts.clear();
+            maxLiveCount = LivenessUtil::calcMaxLiveValueCount(func, &blockLiveCounts);
+        }
+    }
+    return context.rematerializedCount;
+}
+
 } // namespace Slang
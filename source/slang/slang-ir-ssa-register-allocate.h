@@ -24,4 +24,15 @@ RegisterAllocationResult allocateRegistersForFunc(
     RefPtr<IRDominatorTree>& inOutDom,
     bool allocateForCompositeTypesOnly);
 
+/// Compute cheap values again inside the loops that use them, instead of holding them in a
+/// register across every iteration. A value is only moved if it isn't used after the loop and
+/// its operands are live across the loop anyway, so no live range gets longer.
+///
+/// Only loops where the most values are live at once, as estimated by
+/// `LivenessUtil::calcMaxLiveValueCount`, are changed, since elsewhere recomputing values
+/// doesn't lower the number of registers the function needs.
+///
+/// Returns the number of values that were moved.
+Count rematerializeValuesUsedInLoops(IRGlobalValueWithCode* func);
+
 } // namespace Slang
@@ -0,0 +1,189 @@
+// slang-ir-unroll-inline-heuristics.cpp
+#include "slang-ir-unroll-inline-heuristics.h"
+
+#include "../core/slang-string-util.h"
+#include "slang-diagnostics.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+
+namespace Slang
+{
+
+// The hotness given to every function and loop when there is no profile.
+static const double kDefaultHotness = 0.25;
+
+// Calls to functions at most this big are inlined however cold they are, as the call costs about
+// as much as the body.
+static const Count kInlineBaseSize = 8;
+// How much bigger a function may be when the call to it is as hot as anything in the profile.
+static const Count kInlineHotSize = 96;
+// The number of instructions saved by not making a call, not counting its arguments.
+static const Count kCallCost = 2;
+
+// The growth a loop may cause however cold it is, and how much more it may cause when it is as
+// hot as anything in the profile.
+static const Count kUnrollBaseBudget = 16;
+static const Count kUnrollHotBudget = 512;
+// The number of instructions that control each iteration of a loop: the test, the branch and the
+// update of the counter.
+static const Count kLoopControlCost = 3;
+// Loops that run more times than this are never unrolled by the heuristics.
+static const IRIntegerValue kMaxUnrollIterations = 64;
+
+static bool _isPathMatch(UnownedStringSlice path, UnownedStringSlice entryPath)
+{
+    if (!path.endsWith(entryPath))
+        return false;
+    if (path.getLength() == entryPath.getLength())
+        return true;
+    const char before = path[path.getLength() - entryPath.getLength() - 1];
+    return before == '/' || before == '\\';
+}
+
+void ProfileFeedback::parse(UnownedStringSlice text, String const& fileName, DiagnosticSink* sink)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text, lines);
+
+    for (Index i = 0; i < lines.getCount(); i++)
+    {
+        const auto line = lines[i].trim();
+        if (line.getLength() == 0 || line[0] == '#')
+            continue;
+
+        // The path may contain spaces and colons, so split at the last of each.
+        Entry entry;
+        const Index spaceIndex = Math::Max(line.lastIndexOf(' '), line.lastIndexOf('\t'));
+        const auto location = spaceIndex > 0 ? line.head(spaceIndex).trim() : UnownedStringSlice();
+        const Index colonIndex = location.lastIndexOf(':');
+        if (spaceIndex <= 0 || colonIndex <= 0 ||
+            SLANG_FAILED(StringUtil::parseInt(location.tail(colonIndex + 1), entry.line)) ||
+            SLANG_FAILED(StringUtil::parseDouble(line.tail(spaceIndex + 1), entry.hotness)) ||
+            entry.hotness < 0)
+        {
+            if (sink)
+            {
+                sink->diagnose(
+                    SourceLoc(),
+                    Diagnostics::invalidProfileFeedbackLine,
+                    i + 1,
+                    fileName);
+            }
+            continue;
+        }
+
+        entry.path = location.head(colonIndex);
+        m_maxHotness = Math::Max(m_maxHotness, entry.hotness);
+        m_entries.add(entry);
+    }
+}
+
+double ProfileFeedback::getHotness(SourceManager* sourceManager, SourceLoc loc)
+{
+    if (!loc.isValid() || m_maxHotness <= 0)
+        return 0;
+
+    const auto humaneLoc = sourceManager->getHumaneLoc(loc);
+    const auto path = humaneLoc.pathInfo.foundPath.getUnownedSlice();
+    double hotness = 0;
+    for (auto& entry : m_entries)
+    {
+        if (entry.line == humaneLoc.line && _isPathMatch(path, entry.path.getUnownedSlice()))
+            hotness = Math::Max(hotness, entry.hotness);
+    }
+    return hotness / m_maxHotness;
+}
+
+static Count _countInsts(List<IRBlock*> const& blocks)
+{
+    Count count = 0;
+    for (auto block : blocks)
+    {
+        for (auto inst : block->getChildren())
+        {
+            SLANG_UNUSED(inst);
+            count++;
+        }
+    }
+    return count;
+}
+
+double UnrollAndInlineHeuristics::getHotness(IRInst* inst)
+{
+    if (!m_profile)
+        return kDefaultHotness;
+
+    // A function that was specialized or cloned may have lost its own location, but its body
+    // still has the locations of the source it came from.
+    SourceLoc loc = inst->sourceLoc;
+    if (!loc.isValid())
+    {
+        if (auto func = as<IRFunc>(inst))
+        {
+            if (auto firstBlock = func->getFirstBlock())
+            {
+                if (auto firstInst = firstBlock->getFirstOrdinaryInst())
+                    loc = firstInst->sourceLoc;
+            }
+        }
+    }
+    return m_profile->getHotness(m_sourceManager, loc);
+}
+
+bool UnrollAndInlineHeuristics::shouldInline(IRCall* call, IRFunc* callee)
+{
+    auto caller = getParentFunc(call);
+    if (!caller || caller == callee)
+        return false;
+
+    // A function called from one place can be inlined without growing the code, once the
+    // function itself is removed.
+    if (call->getCallee() == callee && !callee->firstUse->nextUse &&
+        !callee->findDecoration<IREntryPointDecoration>())
+        return true;
+
+    List<IRBlock*> blocks;
+    for (auto block : callee->getBlocks())
+        blocks.add(block);
+    const Count calleeSize = _countInsts(blocks);
+
+    // A call is as hot as the hotter of the function making it and the function called, so
+    // that the functions along a hot call chain are inlined into each other.
+    const double hotness = Math::Max(getHotness(caller), getHotness(callee));
+    const Count saved = kCallCost + Count(call->getArgCount());
+    const double budget = double(kInlineBaseSize + saved) + hotness * double(kInlineHotSize);
+    return double(calleeSize) <= budget;
+}
+
+bool UnrollAndInlineHeuristics::shouldUnroll(
+    IRLoop* loop,
+    List<IRBlock*> const& blocks,
+    IRIntegerValue maxIters)
+{
+    if (maxIters <= 1 || maxIters > kMaxUnrollIterations)
+        return false;
+
+    // Every use of the loop's parameters, such as its counter, may fold to a constant in each
+    // unrolled iteration.
+    HashSet<IRBlock*> blockSet;
+    for (auto block : blocks)
+        blockSet.add(block);
+    Count counterUseCount = 0;
+    for (auto param : loop->getTargetBlock()->getParams())
+    {
+        for (auto use = param->firstUse; use; use = use->nextUse)
+        {
+            if (blockSet.contains(as<IRBlock>(use->getUser()->getParent())))
+                counterUseCount++;
+        }
+    }
+
+    const Count bodySize = _countInsts(blocks);
+    const Count growth = bodySize * Count(maxIters - 1);
+    const Count saved = Count(maxIters) * (kLoopControlCost + counterUseCount);
+    const double budget = double(kUnrollBaseBudget + saved) +
+                          getHotness(loop) * double(kUnrollHotBudget);
+    return double(growth) <= budget;
+}
+
+} // namespace Slang
@@ -0,0 +1,60 @@
+// slang-ir-unroll-inline-heuristics.h
+#pragma once
+
+#include "../compiler-core/slang-source-loc.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+class DiagnosticSink;
+struct IRCall;
+struct IRLoop;
+
+/// How hot functions and loops are, read from a profile feedback file.
+///
+/// Each line of the file holds a source location and its hotness, as `path:line hotness`. The
+/// location is that of a function declaration or a loop statement. A path matches a source file
+/// whose path ends with it, so a file name alone is enough when it is unique. Hotness can be any
+/// non-negative measure, such as a sample count or a time, and is taken relative to the hottest
+/// entry. Blank lines and lines starting with `#` are ignored.
+struct ProfileFeedback : RefObject
+{
+    struct Entry
+    {
+        String path;
+        Int line = 0;
+        double hotness = 0;
+    };
+
+    /// Adds the entries in text, reporting lines that can't be read to sink.
+    void parse(UnownedStringSlice text, String const& fileName, DiagnosticSink* sink);
+
+    /// Returns the hotness of the function or loop at loc, from 0 to 1, or 0 if it isn't listed.
+    double getHotness(SourceManager* sourceManager, SourceLoc loc);
+
+    List<Entry> m_entries;
+    double m_maxHotness = 0;
+};
+
+/// Decides which calls to inline and which loops to unroll, where neither is required.
+///
+/// Both grow the code, so each is done when the growth fits in a budget. The budget is larger
+/// for hot code, and grows with the work that is saved: for a call, the call itself and the
+/// copies of its arguments; for a loop, the instructions that control it and the uses of its
+/// counter, which become constants once it is unrolled. Without a profile every function and
+/// loop is treated as warm; with one, code the profile doesn't list is treated as cold.
+struct UnrollAndInlineHeuristics
+{
+    SourceManager* m_sourceManager = nullptr;
+    RefPtr<ProfileFeedback> m_profile;
+
+    /// Returns the hotness of a function or loop, from 0 to 1.
+    double getHotness(IRInst* inst);
+
+    bool shouldInline(IRCall* call, IRFunc* callee);
+
+    /// True if a loop that runs at most maxIters times, made of blocks, should be unrolled.
+    bool shouldUnroll(IRLoop* loop, List<IRBlock*> const& blocks, IRIntegerValue maxIters);
+};
+
+} // namespace Slang
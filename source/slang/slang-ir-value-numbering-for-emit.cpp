@@ -0,0 +1,291 @@
+// slang-ir-value-numbering-for-emit.cpp
+#include "slang-ir-value-numbering-for-emit.h"
+
+#include "../core/slang-short-list.h"
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+static bool _isCommutative(IROp op)
+{
+    switch (op)
+    {
+    case kIROp_Add:
+    case kIROp_Mul:
+    case kIROp_And:
+    case kIROp_Or:
+    case kIROp_BitAnd:
+    case kIROp_BitOr:
+    case kIROp_BitXor:
+    case kIROp_Eql:
+    case kIROp_Neq:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Identifies the value computed by an instruction: its opcode and type, and the value numbers
+/// of its operands.
+struct ValueKey
+{
+    IROp op = kIROp_Invalid;
+    IRInst* type = nullptr;
+    ShortList<IRInst*, 4> operands;
+    HashCode hashCode = 0;
+
+    HashCode getHashCode() const { return hashCode; }
+
+    bool operator==(const ValueKey& other) const
+    {
+        if (hashCode != other.hashCode || op != other.op || type != other.type ||
+            operands.getCount() != other.operands.getCount())
+            return false;
+        for (Index i = 0; i < operands.getCount(); i++)
+        {
+            if (operands[i] != other.operands[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+struct ValueNumberingForEmitContext
+{
+    RefPtr<IRDominatorTree> dom;
+
+    // Maps an instruction that was left in place to the instruction that dominates it and
+    // computes the same value.
+    Dictionary<IRInst*, IRInst*> mapInstToValueNumber;
+    List<IRInst*> repeatedInsts;
+
+    // The instructions available in the block being processed, which are those of the blocks
+    // that dominate it. `scopeKeys` holds the keys in the order they were added, so that they
+    // can be removed again when leaving a dominator subtree.
+    Dictionary<ValueKey, IRInst*> availableValues;
+    List<ValueKey> scopeKeys;
+
+    Count replacedCount = 0;
+
+    IRInst* getValueNumber(IRInst* inst)
+    {
+        if (auto valueNumber = mapInstToValueNumber.tryGetValue(inst))
+            return *valueNumber;
+        return inst;
+    }
+
+    static bool shouldNumber(IRInst* inst)
+    {
+        if (!inst->getDataType())
+            return false;
+        if (!isMovableInst(inst))
+            return false;
+
+        // Folding a `[precise]` computation into one that isn't would lose the decoration.
+        if (inst->findDecoration<IRPreciseDecoration>())
+            return false;
+        return true;
+    }
+
+    /// True if emitting inst again at each use costs less than declaring a temporary for it.
+    static bool isCheapToRepeat(IRInst* inst)
+    {
+        switch (inst->getOp())
+        {
+        case kIROp_swizzle:
+        case kIROp_FieldExtract:
+        case kIROp_FieldAddress:
+        case kIROp_GetElement:
+        case kIROp_GetElementPtr:
+        case kIROp_GetTupleElement:
+        case kIROp_IntCast:
+        case kIROp_FloatCast:
+        case kIROp_CastIntToFloat:
+        case kIROp_CastFloatToInt:
+        case kIROp_MakeVectorFromScalar:
+        case kIROp_Specialize:
+        case kIROp_LookupWitness:
+            break;
+        default:
+            return false;
+        }
+
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            auto operand = inst->getOperand(i);
+            if (!as<IRBlock>(operand->getParent()))
+                continue;
+            switch (operand->getOp())
+            {
+            case kIROp_Param:
+            case kIROp_Var:
+            case kIROp_Load:
+                continue;
+            default:
+                break;
+            }
+            if (!isCheapToRepeat(operand))
+                return false;
+        }
+        return true;
+    }
+
+    /// True if `inst` is defined in the region of a loop that `block` is after. The loop is
+    /// emitted as a statement, and a temporary declared in its body is out of scope at `block`,
+    /// so `inst` can't be used there. This is the test `applyVariableScopeCorrection` makes,
+    /// and that pass has already run.
+    bool isDefinedInLoopBefore(IRInst* inst, IRBlock* block)
+    {
+        auto defBlock = as<IRBlock>(inst->getParent());
+        for (auto dominator = dom->getImmediateDominator(defBlock); dominator;
+             dominator = dom->getImmediateDominator(dominator))
+        {
+            auto loop = as<IRLoop>(dominator->getTerminator());
+            if (!loop)
+                continue;
+            auto breakBlock = loop->getBreakBlock();
+            if (!dom->dominates(breakBlock, defBlock) && dom->dominates(breakBlock, block))
+                return true;
+        }
+        return false;
+    }
+
+    ValueKey getKey(IRInst* inst)
+    {
+        ValueKey key;
+        key.op = inst->getOp();
+        key.type = inst->getFullType();
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+            key.operands.add(getValueNumber(inst->getOperand(i)));
+
+        // Put the operands of a commutative operation in a fixed order. The order only has to
+        // be the same for every key, so comparing addresses is fine, and the choice of which
+        // instruction is kept doesn't depend on it.
+        if (_isCommutative(key.op) && key.operands.getCount() == 2 &&
+            key.operands[1] < key.operands[0])
+        {
+            auto first = key.operands[0];
+            key.operands[0] = key.operands[1];
+            key.operands[1] = first;
+        }
+
+        HashCode hashCode = combineHash(Slang::getHashCode(key.op), Slang::getHashCode(key.type));
+        for (auto operand : key.operands)
+            hashCode = combineHash(hashCode, Slang::getHashCode(operand));
+        key.hashCode = hashCode;
+        return key;
+    }
+
+    void processBlock(IRBlock* block)
+    {
+        IRInst* nextInst = nullptr;
+        for (auto inst = block->getFirstChild(); inst; inst = nextInst)
+        {
+            nextInst = inst->getNextInst();
+            if (!shouldNumber(inst))
+                continue;
+
+            auto key = getKey(inst);
+            if (auto existing = availableValues.tryGetValue(key))
+            {
+                if (isDefinedInLoopBefore(*existing, block))
+                    continue;
+
+                if (isCheapToRepeat(inst))
+                {
+                    // Leave it where it is, but let its users find the values they share.
+                    mapInstToValueNumber[inst] = *existing;
+                    repeatedInsts.add(inst);
+                }
+                else
+                {
+                    inst->replaceUsesWith(*existing);
+                    inst->removeAndDeallocate();
+                    replacedCount++;
+                }
+                continue;
+            }
+            availableValues.add(key, inst);
+            scopeKeys.add(key);
+        }
+    }
+
+    void processFunc(IRGlobalValueWithCode* func)
+    {
+        auto root = func->getFirstBlock();
+        if (!root)
+            return;
+
+        dom = findOrComputeDominatorTree(func);
+
+        // Walk the dominator tree depth first, so that the values available in a block are
+        // exactly those computed in the blocks that dominate it.
+        struct Frame
+        {
+            IRDominatorTree::DominatedList::Iterator nextChild;
+            IRDominatorTree::DominatedList::Iterator endChild;
+            Index scopeStart;
+        };
+        List<Frame> stack;
+
+        auto enterBlock = [&](IRBlock* block)
+        {
+            Frame frame;
+            frame.scopeStart = scopeKeys.getCount();
+            processBlock(block);
+
+            auto children = dom->getImmediatelyDominatedBlocks(block);
+            frame.nextChild = children.begin();
+            frame.endChild = children.end();
+            stack.add(frame);
+        };
+
+        enterBlock(root);
+        while (stack.getCount())
+        {
+            auto& frame = stack.getLast();
+            if (frame.nextChild != frame.endChild)
+            {
+                auto child = *frame.nextChild;
+                ++frame.nextChild;
+                enterBlock(child);
+                continue;
+            }
+
+            for (Index i = frame.scopeStart; i < scopeKeys.getCount(); i++)
+                availableValues.remove(scopeKeys[i]);
+            scopeKeys.setCount(frame.scopeStart);
+            stack.removeLast();
+        }
+
+        // Instructions that were left in place may no longer be used, now that their users
+        // have been replaced. They were found in dominance order, so going backwards removes
+        // users before the instructions they use.
+        for (Index i = repeatedInsts.getCount() - 1; i >= 0; i--)
+        {
+            auto inst = repeatedInsts[i];
+            if (!inst->hasUses())
+                inst->removeAndDeallocate();
+        }
+
+        mapInstToValueNumber.clear();
+        repeatedInsts.clear();
+    }
+};
+
+Count numberValuesForEmit(IRModule* module)
+{
+    ValueNumberingForEmitContext context;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(inst))
+            context.processFunc(func);
+    }
+    return context.replacedCount;
+}
+
+} // namespace Slang
@@ -0,0 +1,24 @@
+// slang-ir-value-numbering-for-emit.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+struct IRModule;
+
+/// Number the values computed by pure instructions across the blocks of each function, and
+/// replace an instruction with the one computing the same value that dominates it.
+///
+/// This is run just before source emit so that a value used at several places is computed
+/// once and held in a temporary, instead of the same expression being emitted at every use.
+/// Unlike `removeRedundancy`, the operands of commutative operations may appear in either
+/// order, and instructions that are cheaper to repeat than to hold in a temporary (such as
+/// an access to an element of a named value) are numbered but left in place. A value computed
+/// in a loop is not shared with a use after the loop, since this runs after
+/// `applyVariableScopeCorrection`.
+///
+/// Returns the number of instructions that were replaced.
+Count numberValuesForEmit(IRModule* module);
+
+} // namespace Slang
@@ -0,0 +1,402 @@
+// slang-ir-vectorize.cpp
+#include "slang-ir-vectorize.h"
+
+#include "../core/slang-short-list.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+static bool _isPackableOp(IROp op)
+{
+    switch (op)
+    {
+    case kIROp_Add:
+    case kIROp_Sub:
+    case kIROp_Mul:
+    case kIROp_Div:
+    case kIROp_Neg:
+    case kIROp_BitAnd:
+    case kIROp_BitOr:
+    case kIROp_BitXor:
+    case kIROp_BitNot:
+    case kIROp_Lsh:
+    case kIROp_Rsh:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool _hasSingleUse(IRInst* inst)
+{
+    return inst->firstUse && !inst->firstUse->nextUse;
+}
+
+/// The values of each component of a vector.
+typedef ShortList<IRInst*, 4> Lanes;
+
+struct VectorizeContext
+{
+    enum class PackKind
+    {
+        /// The same value in every component.
+        Splat,
+        /// A constant in every component.
+        Constant,
+        /// The components of a vector that already exists, possibly in a different order.
+        Extract,
+        /// The same operation in every component.
+        Op,
+        /// A load of every component of a vector in memory, in order.
+        Load,
+        /// Anything else, which has to be built with a `MakeVector`.
+        Gather,
+    };
+
+    /// The number of scalar instructions packing would remove, and of vector instructions it
+    /// would add.
+    struct Cost
+    {
+        Count scalarCount = 0;
+        Count vectorCount = 0;
+    };
+
+    VectorizeOptions options;
+    IRBuilder builder;
+    Count vectorizedCount = 0;
+
+    // The scalar instructions replaced while packing a vector, with the users of a value
+    // after it.
+    List<IRInst*> replacedInsts;
+
+    VectorizeContext(IRModule* module, VectorizeOptions const& inOptions)
+        : options(inOptions), builder(module)
+    {
+    }
+
+    bool isPackableType(IRType* type)
+    {
+        if (!as<IRBasicType>(type) || as<IRVoidType>(type) || as<IRBoolType>(type))
+            return false;
+        return !options.onlyHalf || type->getOp() == kIROp_HalfType;
+    }
+
+    /// Returns the vector that lane is a component of, or nullptr if it isn't one.
+    static IRInst* getExtractBase(IRInst* lane, IRIntegerValue& outIndex)
+    {
+        IRInst* base = nullptr;
+        IRInst* index = nullptr;
+        if (lane->getOp() == kIROp_GetElement)
+        {
+            base = lane->getOperand(0);
+            index = lane->getOperand(1);
+        }
+        else if (auto swizzle = as<IRSwizzle>(lane))
+        {
+            if (swizzle->getElementCount() != 1)
+                return nullptr;
+            base = swizzle->getBase();
+            index = swizzle->getElementIndex(0);
+        }
+
+        auto indexLit = as<IRIntLit>(index);
+        if (!indexLit || !as<IRVectorType>(base->getDataType()))
+            return nullptr;
+        outIndex = indexLit->getValue();
+        return base;
+    }
+
+    /// Returns the pointer to the vector that lane loads a component of, or nullptr if it
+    /// isn't such a load.
+    static IRInst* getLoadBase(IRInst* lane, IRIntegerValue& outIndex)
+    {
+        auto load = as<IRLoad>(lane);
+        if (!load)
+            return nullptr;
+        auto ptr = load->getPtr();
+        if (ptr->getOp() != kIROp_GetElementPtr)
+            return nullptr;
+
+        auto base = ptr->getOperand(0);
+        auto ptrType = as<IRPtrTypeBase>(base->getDataType());
+        auto indexLit = as<IRIntLit>(ptr->getOperand(1));
+        if (!ptrType || !as<IRVectorType>(ptrType->getValueType()) || !indexLit)
+            return nullptr;
+        outIndex = indexLit->getValue();
+        return base;
+    }
+
+    static Count getElementCount(IRInst* vector)
+    {
+        auto countLit = as<IRIntLit>(as<IRVectorType>(vector->getDataType())->getElementCount());
+        return countLit ? Count(countLit->getValue()) : 0;
+    }
+
+    /// True if the loaded value is the same if the load happens just before `insertBefore`.
+    static bool canMoveLoadTo(IRInst* load, IRInst* insertBefore)
+    {
+        if (load->getParent() != insertBefore->getParent())
+            return false;
+        for (auto inst = load->getNextInst(); inst != insertBefore; inst = inst->getNextInst())
+        {
+            if (!inst || inst->mightHaveSideEffects())
+                return false;
+        }
+        return true;
+    }
+
+    static Lanes getOperandLanes(Lanes const& lanes, UInt operandIndex)
+    {
+        Lanes operandLanes;
+        for (auto lane : lanes)
+            operandLanes.add(lane->getOperand(operandIndex));
+        return operandLanes;
+    }
+
+    bool isOp(Lanes const& lanes)
+    {
+        auto first = lanes[0];
+        if (!_isPackableOp(first->getOp()))
+            return false;
+        for (auto lane : lanes)
+        {
+            // Every lane has to be removed once its vector is computed.
+            if (lane->getOp() != first->getOp() || !_hasSingleUse(lane) ||
+                lane->getOperandCount() != first->getOperandCount() ||
+                lane->getDataType() != first->getDataType() ||
+                lane->findDecoration<IRPreciseDecoration>())
+                return false;
+            for (UInt i = 0; i < lane->getOperandCount(); i++)
+            {
+                auto operandType = lane->getOperand(i)->getDataType();
+                if (operandType != first->getOperand(i)->getDataType() ||
+                    !isPackableType(operandType))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    PackKind classify(Lanes const& lanes, IRInst* insertBefore)
+    {
+        auto first = lanes[0];
+        bool isSplat = true;
+        bool isConstant = true;
+        for (auto lane : lanes)
+        {
+            isSplat = isSplat && lane == first;
+            isConstant = isConstant && as<IRConstant>(lane);
+        }
+        if (isSplat)
+            return PackKind::Splat;
+        if (isConstant)
+            return PackKind::Constant;
+
+        IRIntegerValue index = 0;
+        if (auto base = getExtractBase(first, index))
+        {
+            bool isExtract = true;
+            for (auto lane : lanes)
+                isExtract = isExtract && getExtractBase(lane, index) == base;
+            if (isExtract)
+                return PackKind::Extract;
+        }
+
+        if (isOp(lanes))
+            return PackKind::Op;
+
+        if (auto base = getLoadBase(first, index))
+        {
+            auto valueType = as<IRPtrTypeBase>(base->getDataType())->getValueType();
+            auto countLit = as<IRIntLit>(as<IRVectorType>(valueType)->getElementCount());
+            bool isLoad = countLit && countLit->getValue() == lanes.getCount();
+            for (Index i = 0; isLoad && i < lanes.getCount(); i++)
+            {
+                isLoad = getLoadBase(lanes[i], index) == base && index == i &&
+                         _hasSingleUse(lanes[i]) && canMoveLoadTo(lanes[i], insertBefore);
+            }
+            if (isLoad)
+                return PackKind::Load;
+        }
+        return PackKind::Gather;
+    }
+
+    /// True if the lanes are the components of their vector, in order.
+    static bool isWholeVector(Lanes const& lanes, IRInst* base)
+    {
+        if (getElementCount(base) != lanes.getCount())
+            return false;
+        for (Index i = 0; i < lanes.getCount(); i++)
+        {
+            IRIntegerValue index = 0;
+            getExtractBase(lanes[i], index);
+            if (index != i)
+                return false;
+        }
+        return true;
+    }
+
+    void estimate(Lanes const& lanes, IRInst* insertBefore, Cost& ioCost)
+    {
+        IRIntegerValue index = 0;
+        switch (classify(lanes, insertBefore))
+        {
+        case PackKind::Splat:
+            ioCost.vectorCount += as<IRConstant>(lanes[0]) ? 0 : 1;
+            break;
+        case PackKind::Constant:
+            break;
+        case PackKind::Extract:
+            if (!isWholeVector(lanes, getExtractBase(lanes[0], index)))
+                ioCost.vectorCount++;
+            break;
+        case PackKind::Op:
+            ioCost.scalarCount += lanes.getCount();
+            ioCost.vectorCount++;
+            for (UInt i = 0; i < lanes[0]->getOperandCount(); i++)
+                estimate(getOperandLanes(lanes, i), insertBefore, ioCost);
+            break;
+        case PackKind::Load:
+            ioCost.scalarCount += lanes.getCount();
+            ioCost.vectorCount++;
+            break;
+        case PackKind::Gather:
+            ioCost.vectorCount++;
+            break;
+        }
+    }
+
+    /// Emits the vector whose components are the lanes, at the builder's insert location.
+    IRInst* pack(Lanes const& lanes, IRInst* insertBefore)
+    {
+        const Count count = lanes.getCount();
+        auto vectorType = builder.getVectorType(lanes[0]->getDataType(), count);
+
+        IRIntegerValue index = 0;
+        switch (classify(lanes, insertBefore))
+        {
+        case PackKind::Splat:
+            return builder.emitMakeVectorFromScalar(vectorType, lanes[0]);
+        case PackKind::Extract:
+            {
+                auto base = getExtractBase(lanes[0], index);
+                if (isWholeVector(lanes, base))
+                    return base;
+                uint32_t indices[4];
+                for (Index i = 0; i < count; i++)
+                {
+                    getExtractBase(lanes[i], index);
+                    indices[i] = uint32_t(index);
+                }
+                return builder.emitSwizzle(vectorType, base, count, indices);
+            }
+        case PackKind::Op:
+            {
+                // Pack the operands first, so that they are computed before the operation.
+                IRInst* operands[2];
+                const UInt operandCount = lanes[0]->getOperandCount();
+                SLANG_ASSERT(Index(operandCount) <= SLANG_COUNT_OF(operands));
+                for (UInt i = 0; i < operandCount; i++)
+                    operands[i] = pack(getOperandLanes(lanes, i), insertBefore);
+                for (auto lane : lanes)
+                    replacedInsts.add(lane);
+                return builder.emitIntrinsicInst(
+                    vectorType,
+                    lanes[0]->getOp(),
+                    operandCount,
+                    operands);
+            }
+        case PackKind::Load:
+            {
+                auto base = getLoadBase(lanes[0], index);
+                for (auto lane : lanes)
+                    replacedInsts.add(lane);
+                return builder.emitLoad(vectorType, base);
+            }
+        case PackKind::Constant:
+        case PackKind::Gather:
+            break;
+        }
+
+        IRInst* args[4];
+        for (Index i = 0; i < count; i++)
+            args[i] = lanes[i];
+        return builder.emitMakeVector(vectorType, count, args);
+    }
+
+    void tryPack(IRInst* makeVector)
+    {
+        auto vectorType = as<IRVectorType>(makeVector->getDataType());
+        const UInt count = makeVector->getOperandCount();
+        if (!vectorType || count < 2 || count > 4 || getElementCount(makeVector) != Count(count))
+            return;
+
+        auto elementType = vectorType->getElementType();
+        Lanes lanes;
+        for (UInt i = 0; i < count; i++)
+        {
+            auto lane = makeVector->getOperand(i);
+            if (lane->getDataType() != elementType)
+                return;
+            lanes.add(lane);
+        }
+        if (!isPackableType(elementType) || classify(lanes, makeVector) != PackKind::Op)
+            return;
+
+        Cost cost;
+        estimate(lanes, makeVector, cost);
+        if (cost.vectorCount >= cost.scalarCount)
+            return;
+
+        builder.setInsertBefore(makeVector);
+        auto packed = pack(lanes, makeVector);
+        makeVector->replaceUsesWith(packed);
+        makeVector->removeAndDeallocate();
+
+        // Remove the scalar instructions, users first. A load leaves behind the address of its
+        // component, which nothing else may use.
+        for (Index i = replacedInsts.getCount() - 1; i >= 0; i--)
+        {
+            auto inst = replacedInsts[i];
+            SLANG_ASSERT(!inst->hasUses());
+            IRInst* ptr = as<IRLoad>(inst) ? as<IRLoad>(inst)->getPtr() : nullptr;
+            inst->removeAndDeallocate();
+            if (ptr && !ptr->hasUses())
+                ptr->removeAndDeallocate();
+        }
+        replacedInsts.clear();
+        vectorizedCount++;
+    }
+
+    void processFunc(IRFunc* func)
+    {
+        for (auto block : func->getBlocks())
+        {
+            // The scalar instructions a vector is built from all come before it, so removing
+            // them doesn't disturb the walk.
+            IRInst* nextInst = nullptr;
+            for (auto inst = block->getFirstChild(); inst; inst = nextInst)
+            {
+                nextInst = inst->getNextInst();
+                if (inst->getOp() == kIROp_MakeVector)
+                    tryPack(inst);
+            }
+        }
+    }
+};
+
+Count vectorizeScalarOps(IRModule* module, VectorizeOptions const& options)
+{
+    VectorizeContext context(module, options);
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(inst))
+            context.processFunc(func);
+    }
+    return context.vectorizedCount;
+}
+
+} // namespace Slang
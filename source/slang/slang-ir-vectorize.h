@@ -0,0 +1,29 @@
+// slang-ir-vectorize.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+struct IRModule;
+
+struct VectorizeOptions
+{
+    /// Only pack operations on `half` values. Some targets, such as SPIR-V, have packed 16-bit
+    /// arithmetic but gain nothing from packing operations on wider types.
+    bool onlyHalf = false;
+};
+
+/// Pack scalar operations that compute the components of a vector into vector operations.
+///
+/// A vector built from the results of the same arithmetic operation on each of its components,
+/// such as `float4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w)`, is replaced with the operation
+/// on vectors, `a * b`. The operands of the operations are packed the same way, so chains of
+/// operations such as a multiply-add become chains of vector operations. Loads of every component
+/// of a vector become a load of the vector. A vector is only packed when the vector code has
+/// fewer instructions than the scalar code it replaces.
+///
+/// Returns the number of vectors that were packed.
+Count vectorizeScalarOps(IRModule* module, VectorizeOptions const& options);
+
+} // namespace Slang
@@ -2,6 +2,7 @@
 #include "slang-ir.h"
 
 #include "../core/slang-basic.h"
+#include "../core/slang-performance-profiler.h"
 #include "../core/slang-writer.h"
 #include "slang-ir-dominators.h"
 #include "slang-ir-insts.h"
@@ -176,9 +177,40 @@ void IRUse::debugValidate()
 #endif
 }
 
+// Notify the module of `code`, if it is a function in a module, that its CFG has changed.
+static void _notifyCFGChanged(IRInst* code)
+{
+    auto func = as<IRGlobalValueWithCode>(code);
+    if (!func)
+        return;
+    if (auto module = func->getModule())
+        module->notifyCFGChanged(func);
+}
+
+// A block used as an operand of a terminator is a CFG edge, so changing it changes the CFG of
+// the function the terminator is in.
+static void _notifyIfCFGEdge(IRInst* user, IRInst* value)
+{
+    if (!value || value->getOp() != kIROp_Block || !as<IRTerminatorInst>(user))
+        return;
+    if (auto block = user->getParent())
+        _notifyCFGChanged(block->getParent());
+}
+
+// Adding or removing a block of a function, or a terminator of one of its blocks, changes the
+// CFG of the function.
+static void _notifyIfCFGMember(IRInst* inst, IRInst* parent)
+{
+    if (inst->getOp() == kIROp_Block)
+        _notifyCFGChanged(parent);
+    else if (as<IRTerminatorInst>(inst))
+        _notifyCFGChanged(parent->getParent());
+}
+
 void IRUse::init(IRInst* u, IRInst* v)
 {
     clear();
+    _notifyIfCFGEdge(u, v);
     user = u;
     usedValue = v;
     if (v)
@@ -216,6 +248,7 @@ void IRUse::clear()
 
     if (usedValue)
     {
+        _notifyIfCFGEdge(user, usedValue);
 #ifdef SLANG_ENABLE_FULL_IR_VALIDATION
         auto uv = usedValue;
 #endif
@@ -3943,8 +3976,11 @@ IRInst* IRBuilder::createIntrinsicInst(
 }
 
 
+SLANG_PROFILE_HOT_SITE(emitIntrinsicInst);
+
 IRInst* IRBuilder::emitIntrinsicInst(IRType* type, IROp op, UInt argCount, IRInst* const* args)
 {
+    SLANG_PROFILE_HOT(emitIntrinsicInst);
     auto inst = createIntrinsicInst(type, op, argCount, args);
     if (!inst->parent)
         addInst(inst);
@@ -4113,6 +4149,21 @@ IRInst* IRBuilder::emitEmbeddedDownstreamIR(CodeGenTarget target, ISlangBlob* bl
     return emitIntrinsicInst(getVoidType(), kIROp_EmbeddedDownstreamIR, 2, args);
 }
 
+IRInst* IRBuilder::emitEmbeddedTargetIR(
+    CodeGenTarget target,
+    CapabilitySet const& targetCaps,
+    UnownedStringSlice const& optionsDigest,
+    ISlangBlob* blob)
+{
+    IRInst* args[] = {
+        getIntValue(getIntType(), (int)target),
+        getCapabilityValue(targetCaps),
+        getStringValue(optionsDigest),
+        getBlobValue(blob)};
+
+    return emitIntrinsicInst(getVoidType(), kIROp_EmbeddedTargetIR, 4, args);
+}
+
 enum class TypeCastStyle
 {
     Unknown = -1,
@@ -4746,18 +4797,29 @@ void IRModule::buildMangledNameToGlobalInstMap()
 
 IRDominatorTree* IRModule::findOrCreateDominatorTree(IRGlobalValueWithCode* func)
 {
+    getCFGVersion(func);
     IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
-    if (analysis)
-        return analysis->getDominatorTree();
-    else
-    {
-        m_mapInstToAnalysis[func] = IRAnalysis();
-        analysis = m_mapInstToAnalysis.tryGetValue(func);
-    }
+    if (auto domTree = analysis->getDominatorTree())
+        return domTree;
+
     analysis->domTree = computeDominatorTree(func);
+    analysis->domTreeCFGVersion = analysis->cfgVersion;
     return analysis->getDominatorTree();
 }
 
+UInt IRModule::getCFGVersion(IRGlobalValueWithCode* func)
+{
+    IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
+    if (!analysis)
+    {
+        IRAnalysis newAnalysis;
+        newAnalysis.cfgVersion = ++m_cfgVersionCounter;
+        m_mapInstToAnalysis.add(func, newAnalysis);
+        return newAnalysis.cfgVersion;
+    }
+    return analysis->cfgVersion;
+}
+
 IRInst* IRBuilder::addDifferentiableTypeDictionaryDecoration(IRInst* target)
 {
     return addDecoration(target, kIROp_DifferentiableTypeDictionaryDecoration);
@@ -8258,6 +8320,10 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
 void IRInst::replaceUsesWith(IRInst* other)
 {
+    // The uses are moved over without going through `IRUse::set`, so a block being replaced
+    // has to be accounted for here.
+    if (getOp() == kIROp_Block)
+        _notifyCFGChanged(getParent());
     _replaceInstUsesWith(this, other);
 }
 
@@ -8317,6 +8383,8 @@ void IRInst::_insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent)
     this->next = inNext;
     this->parent = inParent;
 
+    _notifyIfCFGMember(this, inParent);
+
 #if _DEBUG
     validateIRInstOperands(this);
 #endif
@@ -8403,6 +8471,8 @@ void IRInst::removeFromParent()
     prev = nullptr;
     next = nullptr;
     parent = nullptr;
+
+    _notifyIfCFGMember(this, oldParent);
 }
 
 void IRInst::removeArguments()
@@ -9043,6 +9113,8 @@ IRInst* getGenericReturnVal(IRInst* inst)
 
 IRDominatorTree* IRAnalysis::getDominatorTree()
 {
+    if (domTreeCFGVersion != cfgVersion)
+        return nullptr;
     return static_cast<IRDominatorTree*>(domTree.get());
 }
 
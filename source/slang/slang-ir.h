@@ -2382,9 +2382,36 @@ private:
 
 struct IRDominatorTree;
 
+/// The kinds of analysis of a function that `IRModule` caches.
+struct IRAnalysisKind
+{
+    typedef uint32_t Type;
+    enum Enum : Type
+    {
+        None = 0,
+        DominatorTree = 0x01,
+
+        /// The analyses that only depend on the control flow graph
+        CFGOnly = DominatorTree,
+        All = DominatorTree,
+    };
+};
+typedef IRAnalysisKind::Type IRAnalysisKinds;
+
+/// The analyses cached for a function.
+///
+/// `cfgVersion` is bumped whenever a block or terminator of the function is added, removed or
+/// retargeted. Each analysis records the version it was computed from, and is only used while
+/// that is still current, so analyses of the control flow graph survive edits to the other
+/// instructions of the function.
 struct IRAnalysis
 {
+    UInt cfgVersion = 0;
+
     RefPtr<RefObject> domTree;
+    UInt domTreeCFGVersion = 0;
+
+    /// Get the dominator tree, or nullptr if it hasn't been computed for the current CFG
     IRDominatorTree* getDominatorTree();
 };
 
@@ -2411,6 +2438,11 @@ public:
         m_obfuscatedSourceMap = sourceMap;
     }
 
+    /// Find the global instructions with linkage that have `mangledName`.
+    ///
+    /// Requires that `buildMangledNameToGlobalInstMap` has been called since the module
+    /// was last changed. The linker consults this index directly, so it should be
+    /// (re)built whenever a module that can take part in linking is finalized.
     ArrayView<IRInst*> findSymbolByMangledName(const ImmutableHashedString& mangledName) const
     {
         if (auto list = m_mapMangledNameToGlobalInst.tryGetValue(mangledName))
@@ -2420,6 +2452,13 @@ public:
 
     void buildMangledNameToGlobalInstMap();
 
+    /// Get the modules decoded from the `EmbeddedTargetIR` instructions of this module, keyed by
+    /// the instruction. They are decoded by the linker when first needed.
+    Dictionary<IRInst*, RefPtr<IRModule>>& getDecodedTargetIRSnapshots()
+    {
+        return m_decodedTargetIRSnapshots;
+    }
+
     IRDeduplicationContext* getDeduplicationContext() const { return &m_deduplicationContext; }
 
     IRDominatorTree* findDominatorTree(IRGlobalValueWithCode* func)
@@ -2430,9 +2469,40 @@ public:
         return nullptr;
     }
     IRDominatorTree* findOrCreateDominatorTree(IRGlobalValueWithCode* func);
-    void invalidateAnalysisForInst(IRGlobalValueWithCode* func)
+
+    /// Get the current version of the control flow graph of `func`.
+    ///
+    /// Two calls return the same version only if no block or terminator of `func` was added,
+    /// removed or retargeted in between, so it can be used to check that an analysis held
+    /// outside of the module is still valid.
+    UInt getCFGVersion(IRGlobalValueWithCode* func);
+
+    /// Record that the control flow graph of `func` has changed. This is called by the IR
+    /// itself when blocks and terminators are edited, so passes don't need to call it.
+    void notifyCFGChanged(IRGlobalValueWithCode* func)
     {
-        m_mapInstToAnalysis.remove(func);
+        if (IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func))
+            analysis->cfgVersion = ++m_cfgVersionCounter;
+    }
+
+    /// Drop the analyses of `func`, other than the kinds in `preserved`.
+    ///
+    /// A pass calls this after it has changed `func` in a way that the CFG version doesn't
+    /// capture. Preserved analyses are still only used while the CFG version is unchanged, so
+    /// a pass that only edits the control flow graph through the IR can preserve
+    /// `IRAnalysisKind::CFGOnly`.
+    void invalidateAnalysisForInst(
+        IRGlobalValueWithCode* func,
+        IRAnalysisKinds preserved = IRAnalysisKind::None)
+    {
+        if (preserved == IRAnalysisKind::None)
+        {
+            m_mapInstToAnalysis.remove(func);
+            return;
+        }
+        IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
+        if (analysis && !(preserved & IRAnalysisKind::DominatorTree))
+            analysis->domTree = nullptr;
     }
     void invalidateAllAnalysis() { m_mapInstToAnalysis.clear(); }
 
@@ -2512,7 +2582,13 @@ private:
 
     Dictionary<IRInst*, IRAnalysis> m_mapInstToAnalysis;
 
+    /// Source of CFG versions. Versions are unique across the module, so a function whose
+    /// analyses were dropped and recreated never repeats a version handed out earlier.
+    UInt m_cfgVersionCounter = 0;
+
     Dictionary<ImmutableHashedString, List<IRInst*>> m_mapMangledNameToGlobalInst;
+
+    Dictionary<IRInst*, RefPtr<IRModule>> m_decodedTargetIRSnapshots;
 };
 
 
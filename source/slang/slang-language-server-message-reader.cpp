@@ -0,0 +1,215 @@
+#include "slang-language-server-message-reader.h"
+
+#include "../compiler-core/slang-json-lexer.h"
+#include "../compiler-core/slang-json-rpc.h"
+#include "../compiler-core/slang-language-server-protocol.h"
+
+namespace Slang
+{
+using namespace LanguageServerProtocol;
+
+static const UnownedStringSlice g_cancelRequestMethod =
+    UnownedStringSlice::fromLiteral("$/cancelRequest");
+
+static UnownedStringSlice _findString(
+    JSONContainer& container,
+    const JSONValue& obj,
+    const char* key)
+{
+    if (!obj.isObjectLike())
+    {
+        return UnownedStringSlice();
+    }
+    const JSONValue value =
+        container.findObjectValue(obj, container.getKey(UnownedStringSlice(key)));
+    return (value.getKind() == JSONValue::Kind::String) ? container.getString(value)
+                                                        : UnownedStringSlice();
+}
+
+SlangResult LanguageServerMessageReader::start(HTTPPacketConnection* connection)
+{
+    SLANG_ASSERT(!m_thread.joinable());
+
+    m_connection = connection;
+    m_stop = false;
+    m_isConnectionActive = true;
+    m_thread = std::thread([this]() { _run(); });
+    return SLANG_OK;
+}
+
+void LanguageServerMessageReader::stop()
+{
+    if (m_thread.joinable())
+    {
+        m_stop = true;
+        m_thread.join();
+    }
+}
+
+void LanguageServerMessageReader::_run()
+{
+    while (!m_stop && m_connection->isActive())
+    {
+        // Wake up periodically, to see if we have been asked to stop
+        if (SLANG_FAILED(m_connection->waitForResult(100)))
+        {
+            break;
+        }
+        if (!m_connection->hasContent())
+        {
+            continue;
+        }
+
+        auto content = m_connection->getContent();
+        UnownedStringSlice text((const char*)content.begin(), content.getCount());
+
+        _inspect(text);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_messages.add(text);
+        }
+        m_connection->consumeContent();
+        m_condition.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isConnectionActive = false;
+    }
+    m_condition.notify_all();
+}
+
+void LanguageServerMessageReader::_inspect(const UnownedStringSlice& content)
+{
+    // Only parse messages that could cancel something. Cancellations are always recorded, as they
+    // may be for a request that hasn't run yet.
+    bool mayCancel = content.indexOf(g_cancelRequestMethod) >= 0;
+    if (!mayCancel)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        mayCancel = m_runningDocumentURI.getLength() &&
+                    (content.indexOf(DidChangeTextDocumentParams::methodName) >= 0 ||
+                     content.indexOf(DidCloseTextDocumentParams::methodName) >= 0);
+    }
+    if (!mayCancel)
+    {
+        return;
+    }
+
+    // The server's own JSON container can't be used from this thread, so parse into our own
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink;
+    sink.init(&sourceManager, &JSONLexer::calcLexemeLocation);
+    JSONContainer container(&sourceManager);
+
+    JSONValue root;
+    if (SLANG_FAILED(JSONRPCUtil::parseJSON(content, &container, &sink, root)) ||
+        !root.isObjectLike())
+    {
+        return;
+    }
+
+    const UnownedStringSlice method = _findString(container, root, "method");
+    const JSONValue params = container.findObjectValue(root, container.getKey(toSlice("params")));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (method == g_cancelRequestMethod)
+    {
+        if (!params.isObjectLike())
+        {
+            return;
+        }
+        const JSONValue idValue =
+            container.findObjectValue(params, container.getKey(toSlice("id")));
+        if (idValue.getKind() != JSONValue::Kind::Integer)
+        {
+            return;
+        }
+
+        const int64_t id = container.asInteger(idValue);
+        m_cancelledIDs.add(id);
+        if (id == m_runningID && m_runningCancelFlag)
+        {
+            m_runningCancelFlag->store(true);
+        }
+    }
+    else if (
+        method == DidChangeTextDocumentParams::methodName ||
+        method == DidCloseTextDocumentParams::methodName)
+    {
+        const JSONValue textDocument =
+            params.isObjectLike()
+                ? container.findObjectValue(params, container.getKey(toSlice("textDocument")))
+                : JSONValue();
+        const UnownedStringSlice uri = _findString(container, textDocument, "uri");
+        if (m_runningCancelFlag && m_runningDocumentURI.getLength() &&
+            uri == m_runningDocumentURI.getUnownedSlice())
+        {
+            m_runningCancelFlag->store(true);
+        }
+    }
+}
+
+void LanguageServerMessageReader::waitForMessages(Int timeOutInMs)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto hasResult = [this]() { return m_messages.getCount() > 0 || !m_isConnectionActive; };
+    if (timeOutInMs < 0)
+    {
+        m_condition.wait(lock, hasResult);
+    }
+    else
+    {
+        m_condition.wait_for(lock, std::chrono::milliseconds(timeOutInMs), hasResult);
+    }
+}
+
+void LanguageServerMessageReader::takeMessages(List<String>& ioMessages)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ioMessages.addRange(m_messages);
+    m_messages.clear();
+}
+
+bool LanguageServerMessageReader::isActive()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isConnectionActive || m_messages.getCount() > 0;
+}
+
+bool LanguageServerMessageReader::isCancelled(int64_t id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cancelledIDs.contains(id);
+}
+
+void LanguageServerMessageReader::removeCancelled(int64_t id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cancelledIDs.remove(id);
+}
+
+void LanguageServerMessageReader::beginRequest(
+    int64_t id,
+    const String& documentURI,
+    std::atomic<bool>* cancelFlag)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_runningID = id;
+    m_runningDocumentURI = documentURI;
+    m_runningCancelFlag = cancelFlag;
+
+    // It may have been cancelled before it started
+    cancelFlag->store(id >= 0 && m_cancelledIDs.contains(id));
+}
+
+void LanguageServerMessageReader::endRequest()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_runningID = -1;
+    m_runningDocumentURI = String();
+    m_runningCancelFlag = nullptr;
+}
+
+} // namespace Slang
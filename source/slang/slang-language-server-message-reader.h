@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../core/slang-http.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/// Reads messages from the language server client on a thread of its own.
+///
+/// The compiler can only be used from one thread at a time, so the language server runs requests
+/// one after another. Reading on a separate thread means that a `$/cancelRequest`, or a change to
+/// the document a request is about, is seen while that request is still running. The reader then
+/// sets the request's cancellation flag, which semantic checking polls, so the request can be
+/// abandoned instead of holding up everything queued behind it.
+class LanguageServerMessageReader : public RefObject
+{
+public:
+    /// Start reading from connection. Only the read side of the connection is used, so the
+    /// server can keep writing to it from its own thread.
+    SlangResult start(HTTPPacketConnection* connection);
+    /// Stop reading, and wait for the reading thread to finish.
+    void stop();
+
+    /// Block until there is a message to take, the connection closes, or timeOutInMs elapses.
+    void waitForMessages(Int timeOutInMs);
+    /// Append all the messages read so far to ioMessages.
+    void takeMessages(List<String>& ioMessages);
+    /// True until the connection has closed and all messages have been taken.
+    bool isActive();
+
+    /// True if the client has asked for request id to be cancelled.
+    bool isCancelled(int64_t id);
+    /// Forget a cancellation once the request it is for has been handled.
+    void removeCancelled(int64_t id);
+
+    /// Note the request with id is being run. cancelFlag is set if the client cancels it, or if
+    /// documentURI isn't empty and that document is changed or closed.
+    void beginRequest(int64_t id, const String& documentURI, std::atomic<bool>* cancelFlag);
+    /// The request has finished, so its cancelFlag will no longer be set.
+    void endRequest();
+
+    ~LanguageServerMessageReader() { stop(); }
+
+protected:
+    void _run();
+    /// Look at a message as it arrives, to see if it cancels the running request.
+    void _inspect(const UnownedStringSlice& content);
+
+    RefPtr<HTTPPacketConnection> m_connection;
+    std::thread m_thread;
+    std::atomic<bool> m_stop = false;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    // All of the following are protected by m_mutex
+    List<String> m_messages;
+    bool m_isConnectionActive = false;
+    HashSet<int64_t> m_cancelledIDs;
+
+    int64_t m_runningID = -1;
+    String m_runningDocumentURI;
+    std::atomic<bool>* m_runningCancelFlag = nullptr;
+};
+
+} // namespace Slang
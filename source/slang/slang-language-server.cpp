@@ -70,11 +70,11 @@ SlangResult LanguageServerCore::init(const InitializeParams& args)
 
 SlangResult LanguageServer::init(const InitializeParams& args)
 {
-    SLANG_RETURN_ON_FAIL(m_connection->initWithStdStreams(JSONRPCConnection::CallStyle::Object));
-
     m_typeMap = JSONNativeUtil::getTypeFuncsMap();
 
-    return m_core.init(args);
+    SLANG_RETURN_ON_FAIL(m_core.init(args));
+    m_core.m_workspace->cancelRequested = &m_requestCancelled;
+    return SLANG_OK;
 }
 
 slang::IGlobalSession* LanguageServerCore::getOrCreateGlobalSession()
@@ -550,10 +550,10 @@ SlangResult LanguageServer::hover(
     auto result = m_core.hover(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -930,10 +930,10 @@ SlangResult LanguageServer::gotoDefinition(
     auto result = m_core.gotoDefinition(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -1090,11 +1090,11 @@ SlangResult LanguageServer::completion(
 {
     auto result = m_core.completion(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
     else if (result.result.items.getCount())
-        m_connection->sendResult(&result.result.items, responseId);
+        sendRequestResult(&result.result.items, responseId);
     else
-        m_connection->sendResult(&result.result.textEditItems, responseId);
+        sendRequestResult(&result.result.textEditItems, responseId);
     return SLANG_OK;
 }
 
@@ -1232,10 +1232,10 @@ SlangResult LanguageServer::completionResolve(
     auto result = m_core.completionResolve(args, editItem);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -1280,10 +1280,10 @@ SlangResult LanguageServer::semanticTokens(
     auto result = m_core.semanticTokens(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -1453,10 +1453,10 @@ SlangResult LanguageServer::signatureHelp(
     auto result = m_core.signatureHelp(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -1693,10 +1693,10 @@ SlangResult LanguageServer::documentSymbol(
     auto result = m_core.documentSymbol(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -1732,10 +1732,10 @@ SlangResult LanguageServer::inlayHint(
     auto result = m_core.inlayHint(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -1795,10 +1795,10 @@ SlangResult LanguageServer::formatting(
     auto result = m_core.formatting(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -1830,10 +1830,10 @@ SlangResult LanguageServer::rangeFormatting(
     auto result = m_core.rangeFormatting(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -1878,10 +1878,10 @@ SlangResult LanguageServer::onTypeFormatting(
     auto result = m_core.onTypeFormatting(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
     {
-        m_connection->sendResult(NullResponse::get(), responseId);
+        sendRequestResult(NullResponse::get(), responseId);
         return SLANG_OK;
     }
-    m_connection->sendResult(&result.result, responseId);
+    sendRequestResult(&result.result, responseId);
     return SLANG_OK;
 }
 
@@ -2506,6 +2506,52 @@ SlangResult LanguageServer::runCommand(Command& call)
     return m_connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
 }
 
+// Requests that clients make again whenever a document changes. On a large document they can
+// take a while, so they are run after other requests, and abandoned when they are out of date.
+static bool _getBackgroundRequestURI(Command& cmd, String& outURI)
+{
+    if (cmd.method == SemanticTokensParams::methodName)
+    {
+        outURI = cmd.semanticTokenArgs.get().textDocument.uri;
+        return true;
+    }
+    else if (cmd.method == InlayHintParams::methodName)
+    {
+        outURI = cmd.inlayHintArgs.get().textDocument.uri;
+        return true;
+    }
+    else if (cmd.method == DocumentSymbolParams::methodName)
+    {
+        outURI = cmd.documentSymbolArgs.get().textDocument.uri;
+        return true;
+    }
+    return false;
+}
+
+// Notifications that change the documents in the workspace. Requests are never reordered across
+// these, so each request sees the documents as they were when it was made.
+static bool _isDocumentNotification(Command& cmd)
+{
+    return cmd.method == DidOpenTextDocumentParams::methodName ||
+           cmd.method == DidChangeTextDocumentParams::methodName ||
+           cmd.method == DidCloseTextDocumentParams::methodName;
+}
+
+static bool _getChangedDocumentURI(Command& cmd, String& outURI)
+{
+    if (cmd.method == DidChangeTextDocumentParams::methodName)
+    {
+        outURI = cmd.changeDocArgs.get().textDocument.uri;
+        return true;
+    }
+    else if (cmd.method == DidCloseTextDocumentParams::methodName)
+    {
+        outURI = cmd.closeDocArgs.get().textDocument.uri;
+        return true;
+    }
+    return false;
+}
+
 void LanguageServer::processCommands()
 {
     HashSet<int64_t> canceledIDs;
@@ -2520,19 +2566,103 @@ void LanguageServer::processCommands()
             }
         }
     }
-    const int kErrorRequestCanceled = -32800;
-    for (auto& cmd : commands)
+
+    const Index count = commands.getCount();
+
+    // A background request is out of date before it starts if its document changes later in the
+    // batch, or if the same request is made again. The client will ask again if it needs to.
+    List<int> supersededErrors;
+    supersededErrors.setCount(count);
+    {
+        HashSet<String> changedURIs;
+        HashSet<String> laterRequests;
+        for (Index i = count - 1; i >= 0; --i)
+        {
+            auto& cmd = commands[i];
+            supersededErrors[i] = 0;
+
+            String uri;
+            if (_getChangedDocumentURI(cmd, uri))
+            {
+                changedURIs.add(uri);
+            }
+            else if (_getBackgroundRequestURI(cmd, uri))
+            {
+                if (changedURIs.contains(uri))
+                    supersededErrors[i] = kErrorContentModified;
+                else if (!laterRequests.add(cmd.method + " " + uri))
+                    supersededErrors[i] = kErrorRequestCanceled;
+            }
+        }
+    }
+
+    // Run background requests after the others that arrived with them, so a slow request doesn't
+    // hold up completion or hover.
+    List<Index> order;
     {
-        if (cmd.id.getKind() == JSONValue::Kind::Integer &&
-            canceledIDs.contains(cmd.id.asInteger()))
+        Index segmentStart = 0;
+        auto addSegment = [&](Index segmentEnd)
+        {
+            for (Index background = 0; background < 2; ++background)
+            {
+                for (Index i = segmentStart; i < segmentEnd; ++i)
+                {
+                    String uri;
+                    if (_getBackgroundRequestURI(commands[i], uri) == (background != 0))
+                        order.add(i);
+                }
+            }
+        };
+        for (Index i = 0; i < count; ++i)
+        {
+            if (_isDocumentNotification(commands[i]))
+            {
+                addSegment(i);
+                order.add(i);
+                segmentStart = i + 1;
+            }
+        }
+        addSegment(count);
+    }
+
+    for (auto index : order)
+    {
+        auto& cmd = commands[index];
+        const bool hasIntegerID = cmd.id.getKind() == JSONValue::Kind::Integer;
+        const int64_t id = hasIntegerID ? cmd.id.asInteger() : -1;
+
+        if (hasIntegerID && (canceledIDs.contains(id) || m_reader->isCancelled(id)))
         {
             m_connection->sendError((JSONRPC::ErrorCode)kErrorRequestCanceled, cmd.id);
         }
+        else if (supersededErrors[index])
+        {
+            m_connection->sendError((JSONRPC::ErrorCode)supersededErrors[index], cmd.id);
+        }
         else
         {
+            // Let the reader cancel the request while it runs
+            String uri;
+            _getBackgroundRequestURI(cmd, uri);
+            m_reader->beginRequest(id, uri, &m_requestCancelled);
+
             runCommand(cmd);
+
+            m_reader->endRequest();
+            m_requestCancelled = false;
+
+            if (m_core.m_workspace)
+            {
+                m_core.m_workspace->invalidateCancelledVersions();
+            }
         }
     }
+
+    // Every request a cancellation in this batch can refer to has now been handled
+    for (auto id : canceledIDs)
+    {
+        m_reader->removeCancelled(id);
+    }
 }
 
 SlangResult LanguageServer::didCloseTextDocument(const DidCloseTextDocumentParams& args)
@@ -2644,18 +2774,24 @@ void LanguageServer::updateConfigFromJSON(const JSONValue& jsonVal)
 SlangResult LanguageServer::execute()
 {
     m_connection = new JSONRPCConnection();
-    m_connection->initWithStdStreams();
+    SLANG_RETURN_ON_FAIL(m_connection->initWithStdStreams(JSONRPCConnection::CallStyle::Object));
+
+    // Messages are read on another thread, so requests can be cancelled while they run
+    m_reader = new LanguageServerMessageReader();
+    SLANG_RETURN_ON_FAIL(m_reader->start(m_connection->getUnderlyingConnection()));
 
-    while (m_connection->isActive() && !m_quit)
+    List<String> messages;
+    while (m_reader->isActive() && !m_quit)
     {
         // Consume all messages first.
         commands.clear();
-        while (true)
+        messages.clear();
+        m_reader->takeMessages(messages);
+        for (const auto& message : messages)
         {
-            m_connection->tryReadMessage();
-            if (!m_connection->hasMessage())
-                break;
-            parseNextMessage();
+            m_connection->readMessage(message.getUnownedSlice());
+            if (m_connection->hasMessage())
+                parseNextMessage();
         }
 
         auto workStart = platform::PerformanceCounter::now();
@@ -2675,9 +2811,10 @@ SlangResult LanguageServer::execute()
             logMessage(3, msgBuilder.produceString());
         }
 
-        m_connection->getUnderlyingConnection()->waitForResult(1000);
+        m_reader->waitForMessages(1000);
     }
 
+    m_reader->stop();
     return SLANG_OK;
 }
 
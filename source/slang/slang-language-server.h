@@ -5,9 +5,11 @@
 #include "slang-language-server-auto-format.h"
 #include "slang-language-server-completion.h"
 #include "slang-language-server-inlay-hints.h"
+#include "slang-language-server-message-reader.h"
 #include "slang-workspace-version.h"
 #include "slang.h"
 
+#include <atomic>
 #include <chrono>
 
 namespace Slang
@@ -171,6 +173,8 @@ class LanguageServer
 {
 private:
     static const int kConfigResponseId = 0x1213;
+    static const int kErrorRequestCanceled = -32800;
+    static const int kErrorContentModified = -32801;
 
 public:
     enum class TraceOptions
@@ -259,10 +263,25 @@ private:
     void registerCapability(const char* methodName);
     void logMessage(int type, String message);
 
+    /// Send the result of a request, or an error if the request was cancelled while it ran.
+    template<typename T>
+    SlangResult sendRequestResult(const T* result, const JSONValue& responseId)
+    {
+        if (m_requestCancelled.load())
+        {
+            return m_connection->sendError((JSONRPC::ErrorCode)kErrorRequestCanceled, responseId);
+        }
+        return m_connection->sendResult(result, responseId);
+    }
+
     List<Command> commands;
     SlangResult queueJSONCall(JSONRPCCall call);
     SlangResult runCommand(Command& cmd);
     void processCommands();
+
+    RefPtr<LanguageServerMessageReader> m_reader;
+    /// Set while a request runs if it is cancelled, or the document it is for changes.
+    std::atomic<bool> m_requestCancelled = false;
 };
 
 inline bool _isIdentifierChar(char ch)
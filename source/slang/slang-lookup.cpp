@@ -2,6 +2,7 @@
 #include "slang-lookup.h"
 
 #include "../compiler-core/slang-name.h"
+#include "../core/slang-performance-profiler.h"
 #include "slang-check-impl.h"
 
 // TODO(tfoley): The implementation of lookup still involves
@@ -296,6 +297,8 @@ LookupRequest initLookupRequest(
     return request;
 }
 
+SLANG_PROFILE_HOT_SITE(lookUpDirectAndTransparentMembers);
+
 /// Perform "direct" lookup in a container declaration
 LookupResult lookUpDirectAndTransparentMembers(
     ASTBuilder* astBuilder,
@@ -306,6 +309,7 @@ LookupResult lookUpDirectAndTransparentMembers(
     LookupMask mask,
     Decl* declToExclude)
 {
+    SLANG_PROFILE_HOT(lookUpDirectAndTransparentMembers);
     LookupRequest request =
         initLookupRequest(semantics, name, mask, LookupOptions::None, nullptr, declToExclude);
     LookupResult result;
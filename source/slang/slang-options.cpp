@@ -392,6 +392,13 @@ void initCommandOptions(CommandOptions& options)
          "-minimum-slang-optimization",
          nullptr,
          "Perform minimum code optimization in Slang to favor compilation time."},
+        {OptionKind::CompactEmittedSource,
+         "-compact-emitted-source",
+         nullptr,
+         "When generating source code, compute a value used in several places once, and fold "
+         "single-use values that don't depend on memory into the expression that uses them, "
+         "rather than declaring temporaries. This reduces the amount of source downstream "
+         "compilers have to parse."},
         {OptionKind::DisableNonEssentialValidations,
          "-disable-non-essential-validations",
          nullptr,
@@ -473,11 +480,73 @@ void initCommandOptions(CommandOptions& options)
          "-report-perf-benchmark",
          nullptr,
          "Reports compiler performance benchmark results."},
+        {OptionKind::ReportPerfBenchmarkAllThreads,
+         "-report-perf-benchmark-all-threads",
+         nullptr,
+         "Performance benchmark results (from -report-perf-benchmark or getCompileTimeProfile) "
+         "combine the results of all threads that have compiled, rather than only the calling "
+         "thread. The report also lists the results of each thread."},
+        {OptionKind::ReportPerfBenchmarkHotFunctions,
+         "-report-perf-benchmark-hot-functions",
+         "-report-perf-benchmark-hot-functions <interval>",
+         "Include the compiler's most frequently called functions in performance benchmark "
+         "results (from -report-perf-benchmark or getCompileTimeProfile), timing one in every "
+         "<interval> calls of each. Call counts are exact, and times are estimated from the calls "
+         "that were timed. Only calls made by the compiling thread are recorded."},
         {OptionKind::ReportCheckpointIntermediates,
          "-report-checkpoint-intermediates",
          nullptr,
          "Reports information about checkpoint contexts used for reverse-mode automatic "
          "differentiation."},
+        {OptionKind::MinCutCheckpointPolicy,
+         "-min-cut-checkpoint-policy",
+         nullptr,
+         "Decide which intermediate values reverse-mode automatic differentiation stores, and "
+         "which it recomputes, by weighing the bytes stored against the estimated cost of "
+         "recomputing them, scaled by loop trip counts. With -report-checkpoint-intermediates "
+         "the totals chosen for each function are reported."},
+        {OptionKind::ReportEmittedSourceStats,
+         "-report-emitted-source-stats",
+         nullptr,
+         "Reports the number of lines and temporaries in generated source code."},
+        {OptionKind::ReportIRInstCounts,
+         "-report-ir-inst-counts",
+         nullptr,
+         "Reports the number of IR instructions in the module after each major stage of code "
+         "generation: linking, specialization, dead code elimination and optimization."},
+        {OptionKind::ReduceRegisterPressure,
+         "-reduce-register-pressure",
+         nullptr,
+         "Before taking generated code out of SSA form, compute cheap values again inside the "
+         "loops that use them, rather than holding them in registers across every iteration. "
+         "This trades a little arithmetic for fewer values live at once in downstream compilers. "
+         "Only the loops where a function has the most values live at once are changed."},
+        {OptionKind::ReportRegisterPressure,
+         "-report-register-pressure",
+         nullptr,
+         "Reports the largest number of values live at once in each function of the generated "
+         "code."},
+        {OptionKind::VectorizeScalarOps,
+         "-vectorize-scalar-ops",
+         nullptr,
+         "Pack scalar arithmetic and loads that compute each component of a vector into vector "
+         "operations, when that takes fewer instructions. This applies to Metal and CPU targets, "
+         "and to 16-bit floating-point values on SPIR-V and GLSL targets. Other targets are "
+         "unaffected."},
+        {OptionKind::HeuristicUnrollAndInline,
+         "-heuristic-unroll-and-inline",
+         nullptr,
+         "Inline calls and unroll loops with a known maximum number of iterations when a cost "
+         "model finds it worthwhile, weighing the growth in code against the work saved and how "
+         "hot the code is. Without -profile-feedback, all code is treated as equally warm."},
+        {OptionKind::ProfileFeedbackFile,
+         "-profile-feedback",
+         "-profile-feedback <path>",
+         "Read how hot functions and loops are from a file, for -heuristic-unroll-and-inline. "
+         "Each line holds a source location and a non-negative hotness, as 'path:line hotness', "
+         "where the location is a function declaration or a loop statement. Hotness is relative "
+         "to the hottest entry, and code that isn't listed is treated as cold. Lines starting "
+         "with '#' are ignored."},
         {OptionKind::SkipSPIRVValidation,
          "-skip-spirv-validation",
          nullptr,
@@ -520,7 +589,12 @@ void initCommandOptions(CommandOptions& options)
         {OptionKind::EmitReflectionJSON,
          "-reflection-json",
          "reflection-json <path>",
-         "Emit reflection data in JSON format to a file."}};
+         "Emit reflection data in JSON format to a file."},
+        {OptionKind::EmitReflectionBinary,
+         "-reflection-binary",
+         "reflection-binary <path>",
+         "Emit reflection data in a compact binary format to a file. The format can be memory "
+         "mapped and queried in place, see slang-reflection-binary.h."}};
 
     _addOptions(makeConstArrayView(generalOpts), options);
 
@@ -845,6 +919,12 @@ void initCommandOptions(CommandOptions& options)
          "-embed-downstream-ir",
          nullptr,
          "Embed downstream IR into emitted slang IR"},
+        {OptionKind::EmbedTargetIR,
+         "-embed-target-ir",
+         nullptr,
+         "Embed the IR of the module's functions, linked and simplified for the target, into "
+         "emitted slang IR. Linking the module for the same target and optimization options, "
+         "without debug information, then uses that IR."},
     };
     _addOptions(makeConstArrayView(experimentalOpts), options);
 
@@ -896,6 +976,11 @@ void initCommandOptions(CommandOptions& options)
          "-loop-inversion",
          nullptr,
          "Enable loop inversion in the code-gen optimization. Default is off"},
+        {OptionKind::WorkingDirectory,
+         "-working-directory",
+         "-working-directory <path>",
+         "Resolve relative paths in the options that follow against <path>, rather than the "
+         "current directory."},
     };
     _addOptions(makeConstArrayView(internalOpts), options);
 
@@ -1119,6 +1204,12 @@ struct OptionsParser
     SlangResult _expectValue(ValueCategory valueCategory, CommandOptions::UserValue& outValue);
     SlangResult _expectInt(const CommandLineArg& arg, Int& outInt);
 
+    /// Get the path to use for `path` from the command line. A relative path is relative to the
+    /// directory set with -working-directory, if there is one, else the current directory.
+    String _resolvePath(const String& path);
+    /// Read the next argument as a path, resolved with `_resolvePath`
+    SlangResult _expectPathArg(CommandLineArg& outArg);
+
     template<typename T>
     SlangResult _expectValue(T& ioValue)
     {
@@ -1178,6 +1269,9 @@ struct OptionsParser
 
     SlangArchiveType m_archiveType = SLANG_ARCHIVE_TYPE_RIFF_LZ4;
 
+    /// Set by -working-directory
+    String m_workingDirectory;
+
     List<RawOutput> m_rawOutputs;
 
     DiagnosticSink m_parseSink;
@@ -1327,7 +1421,7 @@ SlangResult OptionsParser::addInputPath(char const* inPath, SourceLanguage langO
 {
     // look at the extension on the file name to determine
     // how we should handle it.
-    String path = String(inPath);
+    String path = _resolvePath(String(inPath));
 
     if (path.endsWith(".slang-module") || path.endsWith(".slang-lib"))
     {
@@ -1734,6 +1828,22 @@ SlangResult OptionsParser::_expectValue(
     return SLANG_OK;
 }
 
+String OptionsParser::_resolvePath(const String& path)
+{
+    if (m_workingDirectory.getLength() == 0 || path.getLength() == 0 || Path::isAbsolute(path))
+    {
+        return path;
+    }
+    return Path::combine(m_workingDirectory, path);
+}
+
+SlangResult OptionsParser::_expectPathArg(CommandLineArg& outArg)
+{
+    SLANG_RETURN_ON_FAIL(m_reader.expectArg(outArg));
+    outArg.value = _resolvePath(outArg.value);
+    return SLANG_OK;
+}
+
 SlangResult OptionsParser::_expectInt(const CommandLineArg& initArg, Int& outInt)
 {
     SLANG_UNUSED(initArg);
@@ -1843,7 +1953,7 @@ SlangResult OptionsParser::_parseReferenceModule(const CommandLineArg& arg)
     SLANG_UNUSED(arg);
 
     CommandLineArg referenceModuleName;
-    SLANG_RETURN_ON_FAIL(m_reader.expectArg(referenceModuleName));
+    SLANG_RETURN_ON_FAIL(_expectPathArg(referenceModuleName));
 
     // Add the module to the request
     SLANG_RETURN_ON_FAIL(
@@ -1866,7 +1976,7 @@ SlangResult OptionsParser::_parseReproFileSystem(const CommandLineArg& arg)
     SLANG_UNUSED(arg);
 
     CommandLineArg reproName;
-    SLANG_RETURN_ON_FAIL(m_reader.expectArg(reproName));
+    SLANG_RETURN_ON_FAIL(_expectPathArg(reproName));
 
     List<uint8_t> buffer;
     {
@@ -1979,7 +2089,7 @@ SlangResult OptionsParser::_parseLoadRepro(const CommandLineArg& arg)
     SLANG_UNUSED(arg);
 
     CommandLineArg reproName;
-    SLANG_RETURN_ON_FAIL(m_reader.expectArg(reproName));
+    SLANG_RETURN_ON_FAIL(_expectPathArg(reproName));
 
     if (SLANG_FAILED(_loadRepro(reproName.value, m_sink, m_requestImpl)))
     {
@@ -2151,7 +2261,16 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::DumpReproOnError:
         case OptionKind::ReportDownstreamTime:
         case OptionKind::ReportPerfBenchmark:
+        case OptionKind::ReportPerfBenchmarkAllThreads:
         case OptionKind::ReportCheckpointIntermediates:
+        case OptionKind::MinCutCheckpointPolicy:
+        case OptionKind::CompactEmittedSource:
+        case OptionKind::ReportEmittedSourceStats:
+        case OptionKind::ReportIRInstCounts:
+        case OptionKind::ReduceRegisterPressure:
+        case OptionKind::ReportRegisterPressure:
+        case OptionKind::VectorizeScalarOps:
+        case OptionKind::HeuristicUnrollAndInline:
         case OptionKind::SkipSPIRVValidation:
         case OptionKind::DisableSpecialization:
         case OptionKind::DisableDynamicDispatch:
@@ -2197,7 +2316,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::LoadCoreModule:
             {
                 CommandLineArg fileName;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(fileName));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(fileName));
 
                 // Load the file
                 ScopedAllocation contents;
@@ -2214,6 +2333,13 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::CompileCoreModule:
             m_compileCoreModule = true;
             break;
+        case OptionKind::WorkingDirectory:
+            {
+                CommandLineArg workingDirectory;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(workingDirectory));
+                m_workingDirectory = workingDirectory.value;
+                break;
+            }
         case OptionKind::ArchiveType:
             {
                 SLANG_RETURN_ON_FAIL(_expectValue(m_archiveType));
@@ -2222,7 +2348,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::SaveCoreModule:
             {
                 CommandLineArg fileName;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(fileName));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(fileName));
 
                 ComPtr<ISlangBlob> blob;
 
@@ -2237,7 +2363,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::SaveGLSLModuleBinSource:
             {
                 CommandLineArg fileName;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(fileName));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(fileName));
 
                 ComPtr<ISlangBlob> blob;
 
@@ -2272,7 +2398,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::DumpIntermediatePrefix:
             {
                 CommandLineArg prefix;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(prefix));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(prefix));
                 linkage->m_optionSet.set(CompilerOptionName::DumpIntermediatePrefix, prefix.value);
                 break;
             }
@@ -2288,7 +2414,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::DumpRepro:
             {
                 CommandLineArg dumpRepro;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(dumpRepro));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(dumpRepro));
                 linkage->m_optionSet.set(OptionKind::DumpRepro, dumpRepro.value);
                 m_compileRequest->enableReproCapture();
                 break;
@@ -2296,7 +2422,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::ExtractRepro:
             {
                 CommandLineArg reproName;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(reproName));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(reproName));
 
                 {
                     const Result res = ReproUtil::extractFilesToDirectory(reproName.value, m_sink);
@@ -2325,7 +2451,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::LoadReproDirectory:
             {
                 CommandLineArg reproDirectory;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(reproDirectory));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(reproDirectory));
 
                 SLANG_RETURN_ON_FAIL(
                     _compileReproDirectory(m_session, m_requestImpl, reproDirectory.value));
@@ -2348,6 +2474,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 }
                 else
                 {
+                    reproDirectory.value = _resolvePath(reproDirectory.value);
                     auto osFileSystem = OSFileSystem::getExtSingleton();
 
                     SlangPathType pathType;
@@ -2432,6 +2559,11 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 getCurrentTarget()->optionSet.add(CompilerOptionName::EmbedDownstreamIR, true);
                 break;
             }
+        case OptionKind::EmbedTargetIR:
+            {
+                getCurrentTarget()->optionSet.add(CompilerOptionName::EmbedTargetIR, true);
+                break;
+            }
         case OptionKind::Target:
             {
                 CommandLineArg name;
@@ -2697,7 +2829,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                     slice = nextArg.value.getUnownedSlice();
                 }
 
-                m_compileRequest->addSearchPath(String(slice).getBuffer());
+                m_compileRequest->addSearchPath(_resolvePath(String(slice)).getBuffer());
                 break;
             }
         case OptionKind::Output:
@@ -2705,7 +2837,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 //
                 // A `-o` option is used to specify a desired output file.
                 CommandLineArg outputPath;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(outputPath));
 
                 addOutputPath(outputPath.value.getBuffer());
                 break;
@@ -2713,15 +2845,33 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::EmitReflectionJSON:
             {
                 CommandLineArg outputPath;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(outputPath));
 
                 linkage->m_optionSet.set(CompilerOptionName::EmitReflectionJSON, outputPath.value);
                 break;
             }
+        case OptionKind::EmitReflectionBinary:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(_expectPathArg(outputPath));
+
+                linkage->m_optionSet.set(CompilerOptionName::EmitReflectionBinary, outputPath.value);
+                break;
+            }
+        case OptionKind::ProfileFeedbackFile:
+            {
+                CommandLineArg profilePath;
+                SLANG_RETURN_ON_FAIL(_expectPathArg(profilePath));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::ProfileFeedbackFile,
+                    profilePath.value);
+                break;
+            }
         case OptionKind::DepFile:
             {
                 CommandLineArg dependencyPath;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(dependencyPath));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(dependencyPath));
 
                 if (m_requestImpl->m_dependencyOutputPath.getLength() == 0)
                 {
@@ -2875,7 +3025,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 if (index >= 0)
                 {
                     CommandLineArg name;
-                    SLANG_RETURN_ON_FAIL(m_reader.expectArg(name));
+                    SLANG_RETURN_ON_FAIL(_expectPathArg(name));
 
                     UnownedStringSlice passThroughSlice =
                         argValue.getUnownedSlice().head(index).tail(1);
@@ -2939,6 +3089,15 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.add(OptionKind::DisableShortCircuit, true);
                 break;
             }
+        case OptionKind::ReportPerfBenchmarkHotFunctions:
+            {
+                Int interval = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, interval));
+                linkage->m_optionSet.set(
+                    OptionKind::ReportPerfBenchmarkHotFunctions,
+                    CompilerOptionValue::fromInt(int(Math::Max(interval, Int(1)))));
+                break;
+            }
         case OptionKind::BindlessSpaceIndex:
             {
                 Int index = 0;
@@ -2949,7 +3108,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::DumpModule:
             {
                 CommandLineArg fileName;
-                SLANG_RETURN_ON_FAIL(m_reader.expectArg(fileName));
+                SLANG_RETURN_ON_FAIL(_expectPathArg(fileName));
                 auto desc = slang::SessionDesc();
                 ComPtr<slang::ISession> session;
                 m_session->createSession(desc, session.writeRef());
@@ -3497,6 +3656,13 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
             {
                 m_compileRequest->setTargetEmbedDownstreamIR(targetID, true);
             }
+
+            if (rawTarget.optionSet.getBoolOption(CompilerOptionName::EmbedTargetIR))
+            {
+                m_requestImpl->getTargetOptionSet(targetID).set(
+                    CompilerOptionName::EmbedTargetIR,
+                    true);
+            }
         }
 
         // Next we need to sort out the output files specified with `-o`, and
@@ -0,0 +1,398 @@
+// slang-reflection-binary-writer.cpp
+#include "slang-reflection-binary-writer.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-dictionary.h"
+#include "../core/slang-string.h"
+
+namespace Slang
+{
+
+using namespace slang;
+
+namespace
+{ // anonymous
+
+/* Builds up binary reflection data.
+
+Records are written into a single byte buffer and refer to each other by offset. As the buffer can
+move when it grows, a pointer into it is only valid until the next allocation - so values that
+allocate are gathered before a record is written.
+
+The type layout table has to be contiguous, but writing a type layout allocates its sizes, fields
+and so on. So type layout records are built up separately and the table is appended at the end,
+followed by the string table. */
+struct BinaryReflectionWriter
+{
+    static uint32_t _toUInt32(size_t value)
+    {
+        return (value >= size_t(kBinaryReflectionUnbounded)) ? kBinaryReflectionUnbounded
+                                                             : uint32_t(value);
+    }
+    static uint32_t _toIndex(SlangInt value)
+    {
+        return (value < 0 || uint64_t(value) >= uint64_t(kBinaryReflectionInvalidIndex))
+                   ? kBinaryReflectionInvalidIndex
+                   : uint32_t(value);
+    }
+
+    template<typename T>
+    T* _get(uint32_t offset)
+    {
+        return (T*)(m_data.getBuffer() + offset);
+    }
+
+    template<typename T>
+    BinaryReflectionArray<T> _allocateArray(Index count)
+    {
+        // All records are made of 32 bit values, so the buffer stays 4 byte aligned
+        SLANG_COMPILE_TIME_ASSERT(sizeof(T) % 4 == 0);
+
+        BinaryReflectionArray<T> array = {};
+        if (count <= 0)
+            return array;
+
+        array.offset = uint32_t(m_data.getCount());
+        array.count = uint32_t(count);
+        m_data.growToCount(m_data.getCount() + Index(sizeof(T)) * count);
+        ::memset(m_data.getBuffer() + array.offset, 0, sizeof(T) * count);
+        return array;
+    }
+
+    BinaryReflectionString _addString(const char* text)
+    {
+        if (!text || text[0] == 0)
+            return 0;
+
+        String string(text);
+        if (auto found = m_stringMap.tryGetValue(string))
+            return *found;
+
+        const auto offset = BinaryReflectionString(m_strings.getCount());
+        m_strings.addRange((const uint8_t*)string.getBuffer(), string.getLength());
+        m_strings.add(0);
+        m_stringMap.add(string, offset);
+        return offset;
+    }
+
+    /// Get the index of `typeLayout` in the type layout table, adding it if it's not there yet.
+    uint32_t _getTypeLayoutIndex(TypeLayoutReflection* typeLayout)
+    {
+        if (!typeLayout)
+            return kBinaryReflectionInvalidIndex;
+        if (auto found = m_typeLayoutMap.tryGetValue(typeLayout))
+            return *found;
+
+        const auto index = uint32_t(m_typeLayouts.getCount());
+        m_typeLayouts.add(typeLayout);
+        m_typeLayoutMap.add(typeLayout, index);
+        return index;
+    }
+
+    static TypeLayoutReflection* _getElementTypeLayout(TypeLayoutReflection* typeLayout)
+    {
+        switch (typeLayout->getKind())
+        {
+        case TypeReflection::Kind::Array:
+        case TypeReflection::Kind::ConstantBuffer:
+        case TypeReflection::Kind::ParameterBlock:
+        case TypeReflection::Kind::TextureBuffer:
+        case TypeReflection::Kind::ShaderStorageBuffer:
+            return typeLayout->getElementTypeLayout();
+        case TypeReflection::Kind::Resource:
+            {
+                auto type = typeLayout->getType();
+                const auto baseShape =
+                    type ? (type->getResourceShape() & SLANG_RESOURCE_BASE_SHAPE_MASK)
+                         : SLANG_RESOURCE_NONE;
+                return (baseShape == SLANG_STRUCTURED_BUFFER) ? typeLayout->getElementTypeLayout()
+                                                              : nullptr;
+            }
+        default:
+            // Pointers are not followed, as the pointed to type can refer back to the pointer.
+            return nullptr;
+        }
+    }
+
+    void _writeVarLayout(uint32_t offset, VariableLayoutReflection* varLayout)
+    {
+        auto typeLayout = varLayout->getTypeLayout();
+
+        const auto name = _addString(varLayout->getVariable() ? varLayout->getName() : nullptr);
+        const auto semanticName = _addString(varLayout->getSemanticName());
+        const auto typeLayoutIndex = _getTypeLayoutIndex(typeLayout);
+
+        const auto categoryCount = typeLayout ? Index(typeLayout->getCategoryCount()) : 0;
+        auto bindings = _allocateArray<BinaryReflectionBinding>(categoryCount);
+        for (Index i = 0; i < categoryCount; ++i)
+        {
+            const auto category =
+                SlangParameterCategory(typeLayout->getCategoryByIndex(unsigned(i)));
+
+            auto& binding = _get<BinaryReflectionBinding>(bindings.offset)[i];
+            binding.category = uint32_t(category);
+            binding.space = _toUInt32(varLayout->getBindingSpace(category));
+            binding.index = _toUInt32(varLayout->getOffset(category));
+            binding.count = _toUInt32(typeLayout->getSize(category));
+        }
+
+        auto dst = _get<BinaryReflectionVarLayout>(offset);
+        dst->name = name;
+        dst->typeLayoutIndex = typeLayoutIndex;
+        dst->semanticName = semanticName;
+        dst->semanticIndex = _toUInt32(varLayout->getSemanticIndex());
+        dst->stage = uint32_t(varLayout->getStage());
+        dst->imageFormat = uint32_t(varLayout->getImageFormat());
+        dst->bindings = bindings;
+    }
+
+    BinaryReflectionArray<BinaryReflectionVarLayout> _writeVarLayouts(
+        const List<VariableLayoutReflection*>& varLayouts)
+    {
+        auto array = _allocateArray<BinaryReflectionVarLayout>(varLayouts.getCount());
+        for (Index i = 0; i < varLayouts.getCount(); ++i)
+        {
+            _writeVarLayout(
+                array.offset + uint32_t(i * sizeof(BinaryReflectionVarLayout)),
+                varLayouts[i]);
+        }
+        return array;
+    }
+
+    void _writeTypeLayout(TypeLayoutReflection* typeLayout, BinaryReflectionTypeLayout& dst)
+    {
+        auto type = typeLayout->getType();
+        const auto kind = typeLayout->getKind();
+
+        dst = BinaryReflectionTypeLayout{};
+        dst.kind = uint32_t(kind);
+        dst.name = _addString(type ? type->getName() : nullptr);
+        dst.elementTypeLayoutIndex = _getTypeLayoutIndex(_getElementTypeLayout(typeLayout));
+        dst.resourceShape = SLANG_RESOURCE_NONE;
+        dst.resourceAccess = SLANG_RESOURCE_ACCESS_NONE;
+        if (type)
+        {
+            dst.scalarType = uint32_t(type->getScalarType());
+            dst.rowCount = type->getRowCount();
+            dst.columnCount = type->getColumnCount();
+            switch (kind)
+            {
+            case TypeReflection::Kind::Array:
+            case TypeReflection::Kind::Vector:
+                dst.elementCount = _toUInt32(type->getElementCount());
+                break;
+            case TypeReflection::Kind::Resource:
+                dst.resourceShape = uint32_t(type->getResourceShape());
+                dst.resourceAccess = uint32_t(type->getResourceAccess());
+                break;
+            default:
+                break;
+            }
+        }
+
+        // Sizes
+        const auto categoryCount = Index(typeLayout->getCategoryCount());
+        dst.sizes = _allocateArray<BinaryReflectionSize>(categoryCount);
+        for (Index i = 0; i < categoryCount; ++i)
+        {
+            const auto category =
+                SlangParameterCategory(typeLayout->getCategoryByIndex(unsigned(i)));
+
+            auto& size = _get<BinaryReflectionSize>(dst.sizes.offset)[i];
+            size.category = uint32_t(category);
+            size.size = _toUInt32(typeLayout->getSize(category));
+            size.alignment = uint32_t(typeLayout->getAlignment(category));
+            size.stride = _toUInt32(typeLayout->getStride(category));
+        }
+
+        // Fields
+        if (kind == TypeReflection::Kind::Struct)
+        {
+            List<VariableLayoutReflection*> fieldLayouts;
+            const auto fieldCount = typeLayout->getFieldCount();
+            for (unsigned i = 0; i < fieldCount; ++i)
+                fieldLayouts.add(typeLayout->getFieldByIndex(i));
+            dst.fields = _writeVarLayouts(fieldLayouts);
+        }
+
+        // Binding ranges
+        const auto bindingRangeCount = Index(typeLayout->getBindingRangeCount());
+        dst.bindingRanges = _allocateArray<BinaryReflectionBindingRange>(bindingRangeCount);
+        for (Index i = 0; i < bindingRangeCount; ++i)
+        {
+            const auto leafTypeLayoutIndex =
+                _getTypeLayoutIndex(typeLayout->getBindingRangeLeafTypeLayout(i));
+
+            auto& range = _get<BinaryReflectionBindingRange>(dst.bindingRanges.offset)[i];
+            range.bindingType = uint32_t(typeLayout->getBindingRangeType(i));
+            range.bindingCount = _toUInt32(size_t(typeLayout->getBindingRangeBindingCount(i)));
+            range.leafTypeLayoutIndex = leafTypeLayoutIndex;
+            range.descriptorSetIndex = _toIndex(typeLayout->getBindingRangeDescriptorSetIndex(i));
+            range.firstDescriptorRangeIndex =
+                _toIndex(typeLayout->getBindingRangeFirstDescriptorRangeIndex(i));
+            range.descriptorRangeCount =
+                _toIndex(typeLayout->getBindingRangeDescriptorRangeCount(i));
+        }
+
+        // Descriptor sets
+        const auto descriptorSetCount = Index(typeLayout->getDescriptorSetCount());
+        dst.descriptorSets = _allocateArray<BinaryReflectionDescriptorSet>(descriptorSetCount);
+        for (Index i = 0; i < descriptorSetCount; ++i)
+        {
+            const auto rangeCount = Index(typeLayout->getDescriptorSetDescriptorRangeCount(i));
+            auto ranges = _allocateArray<BinaryReflectionDescriptorRange>(rangeCount);
+            for (Index j = 0; j < rangeCount; ++j)
+            {
+                auto& range = _get<BinaryReflectionDescriptorRange>(ranges.offset)[j];
+                range.indexOffset =
+                    _toIndex(typeLayout->getDescriptorSetDescriptorRangeIndexOffset(i, j));
+                range.descriptorCount = _toUInt32(
+                    size_t(typeLayout->getDescriptorSetDescriptorRangeDescriptorCount(i, j)));
+                range.bindingType = uint32_t(typeLayout->getDescriptorSetDescriptorRangeType(i, j));
+                range.category =
+                    uint32_t(typeLayout->getDescriptorSetDescriptorRangeCategory(i, j));
+            }
+
+            auto& set = _get<BinaryReflectionDescriptorSet>(dst.descriptorSets.offset)[i];
+            set.spaceOffset = _toIndex(typeLayout->getDescriptorSetSpaceOffset(i));
+            set.descriptorRanges = ranges;
+        }
+    }
+
+    void _writeEntryPoint(uint32_t offset, EntryPointReflection* entryPoint)
+    {
+        List<VariableLayoutReflection*> paramLayouts;
+        const auto paramCount = entryPoint->getParameterCount();
+        for (unsigned i = 0; i < paramCount; ++i)
+            paramLayouts.add(entryPoint->getParameterByIndex(i));
+        const auto parameters = _writeVarLayouts(paramLayouts);
+
+        const auto name = _addString(entryPoint->getName());
+        const auto nameOverride = _addString(entryPoint->getNameOverride());
+
+        const uint32_t resultOffset =
+            offset + uint32_t(SLANG_OFFSET_OF(BinaryReflectionEntryPoint, result));
+        auto resultVarLayout = entryPoint->getResultVarLayout();
+        if (resultVarLayout && resultVarLayout->getTypeLayout())
+            _writeVarLayout(resultOffset, resultVarLayout);
+        else
+            _get<BinaryReflectionVarLayout>(resultOffset)->typeLayoutIndex =
+                kBinaryReflectionInvalidIndex;
+
+        SlangUInt threadGroupSize[3] = {0, 0, 0};
+        if (entryPoint->getStage() == SLANG_STAGE_COMPUTE)
+            entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+
+        auto dst = _get<BinaryReflectionEntryPoint>(offset);
+        dst->name = name;
+        dst->nameOverride = nameOverride;
+        dst->stage = uint32_t(entryPoint->getStage());
+        for (Index i = 0; i < 3; ++i)
+            dst->threadGroupSize[i] = _toUInt32(size_t(threadGroupSize[i]));
+        dst->parameters = parameters;
+    }
+
+    SlangResult write(ShaderReflection* program, List<uint8_t>& outData)
+    {
+        m_data.setCount(Index(sizeof(BinaryReflectionHeader)));
+        ::memset(m_data.getBuffer(), 0, sizeof(BinaryReflectionHeader));
+
+        // Offset 0 is the empty string
+        m_strings.add(0);
+
+        BinaryReflectionProgram dstProgram = {};
+
+        {
+            List<VariableLayoutReflection*> paramLayouts;
+            const auto paramCount = program->getParameterCount();
+            for (unsigned i = 0; i < paramCount; ++i)
+                paramLayouts.add(program->getParameterByIndex(i));
+            dstProgram.parameters = _writeVarLayouts(paramLayouts);
+        }
+
+        const auto entryPointCount = Index(program->getEntryPointCount());
+        dstProgram.entryPoints = _allocateArray<BinaryReflectionEntryPoint>(entryPointCount);
+        for (Index i = 0; i < entryPointCount; ++i)
+        {
+            _writeEntryPoint(
+                dstProgram.entryPoints.offset + uint32_t(i * sizeof(BinaryReflectionEntryPoint)),
+                program->getEntryPointByIndex(SlangUInt(i)));
+        }
+
+        // Writing a type layout can add more type layouts, so the count can grow as we go
+        List<BinaryReflectionTypeLayout> typeLayoutRecords;
+        for (Index i = 0; i < m_typeLayouts.getCount(); ++i)
+        {
+            BinaryReflectionTypeLayout record;
+            _writeTypeLayout(m_typeLayouts[i], record);
+            typeLayoutRecords.add(record);
+        }
+
+        dstProgram.typeLayouts =
+            _allocateArray<BinaryReflectionTypeLayout>(typeLayoutRecords.getCount());
+        if (typeLayoutRecords.getCount())
+        {
+            ::memcpy(
+                m_data.getBuffer() + dstProgram.typeLayouts.offset,
+                typeLayoutRecords.getBuffer(),
+                sizeof(BinaryReflectionTypeLayout) * typeLayoutRecords.getCount());
+        }
+
+        dstProgram.globalConstantBufferBinding =
+            _toIndex(SlangInt(program->getGlobalConstantBufferBinding()));
+        dstProgram.globalConstantBufferSize = _toUInt32(program->getGlobalConstantBufferSize());
+
+        // The string table goes last, padded so the total size stays a multiple of 4
+        const auto stringTableOffset = m_data.getCount();
+        m_data.addRange(m_strings.getBuffer(), m_strings.getCount());
+        while (m_data.getCount() & 3)
+            m_data.add(0);
+
+        if (uint64_t(m_data.getCount()) >= uint64_t(kBinaryReflectionUnbounded))
+            return SLANG_E_BUFFER_TOO_SMALL;
+
+        auto header = _get<BinaryReflectionHeader>(0);
+        header->magic = kBinaryReflectionMagic;
+        header->version = kBinaryReflectionVersion;
+        header->dataSize = uint32_t(m_data.getCount());
+        header->stringTableOffset = uint32_t(stringTableOffset);
+        header->stringTableSize = uint32_t(m_strings.getCount());
+        header->program = dstProgram;
+
+        outData.swapWith(m_data);
+        return SLANG_OK;
+    }
+
+    List<uint8_t> m_data;
+
+    List<uint8_t> m_strings;
+    Dictionary<String, BinaryReflectionString> m_stringMap;
+
+    List<TypeLayoutReflection*> m_typeLayouts;
+    Dictionary<TypeLayoutReflection*, uint32_t> m_typeLayoutMap;
+};
+
+} // namespace
+
+SlangResult emitReflectionBinary(SlangReflection* reflection, List<uint8_t>& outData)
+{
+    BinaryReflectionWriter writer;
+    return writer.write((ShaderReflection*)reflection, outData);
+}
+
+} // namespace Slang
+
+extern "C"
+{
+    SLANG_API SlangResult spReflection_ToBinary(SlangReflection* reflection, ISlangBlob** outBlob)
+    {
+        using namespace Slang;
+        if (!reflection || !outBlob)
+            return SLANG_E_INVALID_ARG;
+
+        List<uint8_t> data;
+        SLANG_RETURN_ON_FAIL(emitReflectionBinary(reflection, data));
+        *outBlob = ListBlob::moveCreate(data).detach();
+        return SLANG_OK;
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef SLANG_REFLECTION_BINARY_WRITER_H
+#define SLANG_REFLECTION_BINARY_WRITER_H
+
+#include "../core/slang-list.h"
+#include "slang-reflection-binary.h"
+#include "slang.h"
+
+namespace Slang
+{
+
+/// Serialize `reflection` into the binary reflection format described in
+/// `slang-reflection-binary.h`, which can be read in place with `slang::BinaryReflectionView`.
+SlangResult emitReflectionBinary(SlangReflection* reflection, List<uint8_t>& outData);
+
+} // namespace Slang
+
+#endif
@@ -137,14 +137,34 @@ public:
         IRModule* irModule = targetProgram->getOrCreateIRModuleForLayout(sink);
 
         // Okay, we need to serialize this target program and its IR too...
+        return encodeIRModule(irModule);
+    }
+
+    SlangResult encodeIRModule(IRModule* irModule)
+    {
+        // The chunked format allows function bodies to be encoded in parallel, and decoded
+        // independently. If the module has references between bodies it can't be used, so we
+        // fall back to the monolithic format.
+        {
+            IRSerialChunkedData chunkedData;
+            IRSerialWriter writer;
+            const SlangResult res =
+                writer.writeChunked(irModule, _sourceLocWriter, _options.optionFlags, &chunkedData);
+            if (SLANG_SUCCEEDED(res))
+            {
+                return IRSerialWriter::writeTo(chunkedData, _encoder);
+            }
+            if (res != SLANG_E_NOT_AVAILABLE)
+            {
+                return res;
+            }
+        }
+
         IRSerialData serialData;
         IRSerialWriter writer;
-
         SLANG_RETURN_ON_FAIL(
             writer.write(irModule, _sourceLocWriter, _options.optionFlags, &serialData));
-        SLANG_RETURN_ON_FAIL(IRSerialWriter::writeTo(serialData, _encoder));
-
-        return SLANG_OK;
+        return IRSerialWriter::writeTo(serialData, _encoder);
     }
 
     void encode(Name* name) { _encoder.encode(name->text); }
@@ -208,6 +228,12 @@ public:
             // files that the compiled result depended on.
             //
             encodeModuleDependencyPaths(module);
+
+            // The header also includes what is needed to check the module
+            // is up to date without depending on the implementation of the
+            // modules it imports.
+            //
+            encodeModuleInterfaceDigests(module);
         }
 
         // If serialization of Slang IR modules is enabled, and there
@@ -217,11 +243,7 @@ public:
         {
             if (auto irModule = module->getIRModule())
             {
-                IRSerialData serialData;
-                IRSerialWriter writer;
-                SLANG_RETURN_ON_FAIL(
-                    writer.write(irModule, _sourceLocWriter, _options.optionFlags, &serialData));
-                SLANG_RETURN_ON_FAIL(IRSerialWriter::writeTo(serialData, _encoder));
+                SLANG_RETURN_ON_FAIL(encodeIRModule(irModule));
             }
         }
 
@@ -241,6 +263,55 @@ public:
         return SLANG_OK;
     }
 
+    SlangResult encodeModuleInterfaceDigests(Module* module)
+    {
+        auto interfaceDigest = module->computeInterfaceDigest();
+        _encoder.encodeData(
+            PropertyKeys<Module>::InterfaceDigest,
+            interfaceDigest.data,
+            sizeof(interfaceDigest.data));
+
+        // The digest of the module's own files, along with which of the
+        // file dependencies they are.
+        //
+        auto sourceDigest = module->computeSourceDigest();
+        _encoder.encodeData(
+            PropertyKeys<Module>::SourceDigest,
+            sourceDigest.data,
+            sizeof(sourceDigest.data));
+        {
+            Encoder::WithObject withProperty(&_encoder, PropertyKeys<Module>::SourceFileIndices);
+            Encoder::WithArray withArray(&_encoder);
+            for (auto index : module->getSourceFileDependencyIndices())
+            {
+                _encoder.encodeUInt(UInt64(index));
+            }
+        }
+
+        // The interface of every module it depends on, apart from builtin
+        // modules which are versioned with the compiler.
+        //
+        Encoder::WithObject withProperty(&_encoder, PropertyKeys<Module>::ImportedInterfaces);
+        Encoder::WithArray withArray(&_encoder);
+        for (auto importedModule : module->getModuleDependencyList())
+        {
+            auto importedModuleDecl = importedModule->getModuleDecl();
+            if (importedModule == module || !importedModuleDecl ||
+                isFromCoreModule(importedModuleDecl))
+            {
+                continue;
+            }
+
+            Encoder::WithObject withObject(&_encoder);
+            _encoder.encodeString(importedModule->getNameObj()->text);
+
+            auto importedDigest = importedModule->computeInterfaceDigest();
+            _encoder.encodeData(importedDigest.data, sizeof(importedDigest.data));
+        }
+
+        return SLANG_OK;
+    }
+
     SlangResult encodeModuleDependencyPaths(Module* module)
     {
         Encoder::WithObject withProperty(&_encoder, PropertyKeys<Module>::FileDependencies);
@@ -451,6 +522,67 @@ SHA1::Digest ModuleChunk::getDigest() const
     return foundChunk->readPayloadAs<SHA1::Digest>();
 }
 
+bool ModuleChunk::hasImportedInterfaces() const
+{
+    return findListChunk(PropertyKeys<Module>::ImportedInterfaces) != nullptr;
+}
+
+SHA1::Digest ModuleChunk::getInterfaceDigest() const
+{
+    auto foundChunk = findDataChunk(PropertyKeys<Module>::InterfaceDigest);
+    if (!foundChunk)
+    {
+        return SHA1::Digest();
+    }
+    return foundChunk->readPayloadAs<SHA1::Digest>();
+}
+
+SHA1::Digest ModuleChunk::getSourceDigest() const
+{
+    auto foundChunk = findDataChunk(PropertyKeys<Module>::SourceDigest);
+    if (!foundChunk)
+    {
+        SLANG_UNEXPECTED("module chunk had no source digest");
+    }
+    return foundChunk->readPayloadAs<SHA1::Digest>();
+}
+
+List<Index> ModuleChunk::getSourceFileIndices() const
+{
+    List<Index> indices;
+
+    Decoder decoder(this);
+    Decoder::WithProperty withProperty(decoder, PropertyKeys<Module>::SourceFileIndices);
+    Decoder::WithArray withArray(decoder);
+    while (decoder.hasElements())
+    {
+        indices.add(Index(decoder.decodeUInt()));
+    }
+    return indices;
+}
+
+List<ModuleChunk::ImportedModuleInterface> ModuleChunk::getImportedInterfaces() const
+{
+    List<ImportedModuleInterface> importedInterfaces;
+
+    Decoder decoder(this);
+    Decoder::WithProperty withProperty(decoder, PropertyKeys<Module>::ImportedInterfaces);
+    Decoder::WithArray withArray(decoder);
+    while (decoder.hasElements())
+    {
+        Decoder::WithObject withObject(decoder);
+
+        ImportedModuleInterface importedInterface;
+        importedInterface.name = decoder.decodeString();
+        decoder.decodeData(
+            SerialBinary::kDataFourCC,
+            importedInterface.interfaceDigest.data,
+            sizeof(importedInterface.interfaceDigest.data));
+        importedInterfaces.add(importedInterface);
+    }
+    return importedInterfaces;
+}
+
 String ModuleChunk::getName() const
 {
     // TODO(tfoley): This kind of logic needs a way
@@ -606,13 +738,14 @@ SlangResult decodeModuleIR(
     // in-memory structures are created based on the intermediate.
     //
     // Thus we start by running the `IRSerialReader::readContainer`
-    // logic to get the `IRSerialData` representation.
+    // logic to get the `IRSerialChunkedData` representation. This
+    // reads both the chunked and the monolithic formats.
     //
     // TODO(tfoley): This should all get streamlined so that we
     // are deserializing IR nodes directly from the format written
     // into the RIFF.
     //
-    IRSerialData serialData;
+    IRSerialChunkedData serialData;
     SLANG_RETURN_ON_FAIL(IRSerialReader::readFrom(chunk, &serialData));
 
     // Next we read the actual IR representation out from the
@@ -625,6 +758,46 @@ SlangResult decodeModuleIR(
     return SLANG_OK;
 }
 
+SlangResult encodeModuleIRToBlob(IRModule* irModule, ISlangBlob** outBlob)
+{
+    IRSerialData serialData;
+    IRSerialWriter writer;
+    SLANG_RETURN_ON_FAIL(writer.write(irModule, nullptr, SerialOptionFlag::IRModule, &serialData));
+
+    RIFF::Builder builder;
+    RIFF::BuildCursor cursor(builder);
+    {
+        SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, SerialBinary::kModuleFourCC);
+        SLANG_RETURN_ON_FAIL(IRSerialWriter::writeTo(serialData, cursor));
+    }
+    return builder.writeToBlob(outBlob);
+}
+
+SlangResult decodeModuleIRFromBlob(
+    RefPtr<IRModule>& outIRModule,
+    UnownedStringSlice data,
+    Session* session)
+{
+    // The data may be embedded in an IR blob literal, which doesn't guarantee the alignment
+    // that reading the RIFF needs, so we read from a copy.
+    //
+    auto blob = RawBlob::create(data.begin(), data.getLength());
+
+    auto rootChunk = RIFF::RootChunk::getFromBlob(blob);
+    if (!rootChunk)
+        return SLANG_FAIL;
+
+    auto moduleChunk = ModuleChunk::find(rootChunk);
+    if (!moduleChunk)
+        return SLANG_FAIL;
+
+    auto irChunk = moduleChunk->findIR();
+    if (!irChunk)
+        return SLANG_FAIL;
+
+    return decodeModuleIR(outIRModule, irChunk, session, nullptr);
+}
+
 /* static */ SlangResult SerialContainerUtil::verifyIRSerialize(
     IRModule* module,
     Session* session,
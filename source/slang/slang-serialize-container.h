@@ -81,6 +81,22 @@ public:
     SHA1::Digest getDigest() const;
 
     RIFF::ChunkList<StringChunk> getFileDependencies() const;
+
+    struct ImportedModuleInterface
+    {
+        String name;
+        SHA1::Digest interfaceDigest;
+    };
+
+    /// True if the module was written with the interface digests of the modules it imports, and
+    /// so can be checked to be up to date with `getSourceDigest` and `getImportedInterfaces`.
+    bool hasImportedInterfaces() const;
+
+    /// Get the digest of the module's own interface. Zero if it wasn't written.
+    SHA1::Digest getInterfaceDigest() const;
+    SHA1::Digest getSourceDigest() const;
+    List<Index> getSourceFileIndices() const;
+    List<ImportedModuleInterface> getImportedInterfaces() const;
 };
 
 struct EntryPointChunk : RIFF::ListChunk
@@ -129,6 +145,16 @@ SlangResult decodeModuleIR(
     Session* session,
     SerialSourceLocReader* sourceLocReader);
 
+/// Write `irModule` to a standalone blob, without source locations. Used for IR that is
+/// embedded in the IR of another module.
+SlangResult encodeModuleIRToBlob(IRModule* irModule, ISlangBlob** outBlob);
+
+/// Read an IR module written by `encodeModuleIRToBlob`.
+SlangResult decodeModuleIRFromBlob(
+    RefPtr<IRModule>& outIRModule,
+    UnownedStringSlice data,
+    Session* session);
+
 } // namespace Slang
 
 #endif
@@ -34,6 +34,12 @@ struct IRSerialBinary
     /// Debug information is held elsewhere, but if this optional section exists, it maps
     /// instructions to locs
     static const FourCC::RawValue kDebugSourceLocRunFourCc = SLANG_FOUR_CC('S', 'd', 's', 'r');
+
+    /// In the chunked format the IR module list holds a list of this type for each segment. The
+    /// first is the header segment, followed by a segment for each global function or generic.
+    static const FourCC::RawValue kSegmentFourCc = SLANG_FOUR_CC('S', 'i', 's', 'g');
+    /// Holds the IRSerialData::SegmentInfo of a segment
+    static const FourCC::RawValue kSegmentInfoFourCc = SLANG_FOUR_CC('S', 'L', 's', 'i');
 };
 
 struct IRSerialData
@@ -89,6 +95,26 @@ struct IRSerialData
         uint8_t m_numStrings;
     };
 
+    /// Describes a segment of the chunked format.
+    ///
+    /// The header segment holds every instruction that isn't in the body of a global function
+    /// or generic, indexed as in the monolithic format. Every other segment holds the
+    /// decorations and children of one global function or generic, which is itself in the
+    /// header. Instruction indices below `m_headerInstCount` refer to header instructions, and
+    /// `m_headerInstCount + i` refers to the i-th instruction of the segment.
+    struct SegmentInfo
+    {
+        typedef SegmentInfo ThisType;
+        bool operator==(const ThisType& rhs) const
+        {
+            return m_parentIndex == rhs.m_parentIndex && m_headerInstCount == rhs.m_headerInstCount;
+        }
+        bool operator!=(const ThisType& rhs) const { return !(*this == rhs); }
+
+        InstIndex m_parentIndex;    ///< The header instruction the segment is the body of
+        SizeType m_headerInstCount; ///< The count of instructions in the header, including null
+    };
+
 
     // Instruction...
     // We can store SourceLoc values separately. Just store per index information.
@@ -199,6 +225,44 @@ struct IRSerialData
     static const PayloadInfo s_payloadInfos[int(Inst::PayloadType::CountOf)];
 };
 
+/// IR serialized as a header segment, and segments for the bodies of global functions and
+/// generics. The segments are encoded independently of each other (so can be written in
+/// parallel), and only depend on the header to be decoded.
+///
+/// Data read from the monolithic format just has a header.
+struct IRSerialChunkedData
+{
+    typedef IRSerialChunkedData ThisType;
+
+    struct Segment
+    {
+        typedef Segment ThisType;
+        bool operator==(const ThisType& rhs) const
+        {
+            return m_info == rhs.m_info && m_data == rhs.m_data;
+        }
+        bool operator!=(const ThisType& rhs) const { return !(*this == rhs); }
+
+        IRSerialData::SegmentInfo m_info;
+        IRSerialData m_data;
+    };
+
+    void clear()
+    {
+        m_header.clear();
+        m_segments.clear();
+    }
+
+    bool operator==(const ThisType& rhs) const
+    {
+        return m_header == rhs.m_header && m_segments == rhs.m_segments;
+    }
+    bool operator!=(const ThisType& rhs) const { return !(*this == rhs); }
+
+    IRSerialData m_header;
+    List<Segment> m_segments;
+};
+
 // --------------------------------------------------------------------------
 SLANG_FORCE_INLINE int IRSerialData::Inst::getNumOperands() const
 {
@@ -23,11 +23,112 @@ void IRSerialWriter::_addInstruction(IRInst* inst)
     SLANG_ASSERT(!m_instMap.containsKey(inst));
 
     // Add to the map
-    m_instMap.add(inst, Ser::InstIndex(m_insts.getCount()));
+    m_instMap.add(inst, Ser::InstIndex(m_indexBase + m_insts.getCount()));
     m_insts.add(inst);
 }
 
-Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
+IRSerialData::InstIndex IRSerialWriter::_getOperandIndex(IRInst* inst)
+{
+    if (!inst)
+    {
+        return Ser::InstIndex(0);
+    }
+    if (auto index = m_instMap.tryGetValue(inst))
+    {
+        return *index;
+    }
+    if (m_headerWriter)
+    {
+        if (auto index = m_headerWriter->m_instMap.tryGetValue(inst))
+        {
+            return *index;
+        }
+    }
+    // The instruction isn't part of what is being written. This can only be represented if it is
+    // in the header, so the chunked format can't be used.
+    m_hasUnresolvedOperand = true;
+    return Ser::InstIndex(0);
+}
+
+static bool _isSegmentRoot(IRInst* inst)
+{
+    // The body of a global function or generic is written as a segment
+    return (as<IRFunc>(inst) || as<IRGeneric>(inst)) && inst->getFirstChild();
+}
+
+void IRSerialWriter::_reset(IRSerialData* serialData)
+{
+    m_serialData = serialData;
+    serialData->clear();
+
+    m_insts.clear();
+    m_instMap.clear();
+    m_decorations.clear();
+    m_stringSlicePool.clear();
+
+    m_headerWriter = nullptr;
+    m_indexBase = 0;
+    m_hasUnresolvedOperand = false;
+}
+
+void IRSerialWriter::_addDescendants(IRInst* rootInst, List<IRInst*>* outSegmentRoots)
+{
+    // Stack for parentInst
+    List<IRInst*> parentInstStack;
+    parentInstStack.add(rootInst);
+
+    // Traverse all of the instructions
+    while (parentInstStack.getCount())
+    {
+        // If it's in the stack it is assumed it is already in the inst map (or the header's)
+        IRInst* parentInst = parentInstStack.getLast();
+        parentInstStack.removeLast();
+
+        // Okay we go through each of the children in order. If they are IRInstParent derived, we
+        // add to stack to process later cos we want breadth first so the order of children is the
+        // same as their index order, meaning we don't need to store explicit indices
+        const Ser::InstIndex startChildInstIndex =
+            Ser::InstIndex(m_indexBase + m_insts.getCount());
+
+        IRInstListBase childrenList = parentInst->getDecorationsAndChildren();
+        if (m_headerWriter && parentInst == rootInst)
+        {
+            // The decorations of a segment root are written in the header
+            childrenList = parentInst->getChildren();
+        }
+        else if (
+            outSegmentRoots && parentInst->getParent() == rootInst && _isSegmentRoot(parentInst))
+        {
+            // Only the decorations go in the header, the children are written as a segment
+            childrenList = parentInst->getDecorations();
+            outSegmentRoots->add(parentInst);
+        }
+
+        for (IRInst* child : childrenList)
+        {
+            // This instruction can't be in the map...
+            SLANG_ASSERT(!m_instMap.containsKey(child));
+
+            _addInstruction(child);
+
+            parentInstStack.add(child);
+        }
+
+        // If it had any children, then store the information about it
+        const Ser::InstIndex endChildInstIndex = Ser::InstIndex(m_indexBase + m_insts.getCount());
+        if (endChildInstIndex != startChildInstIndex)
+        {
+            Ser::InstRun run;
+            run.m_parentIndex = _getOperandIndex(parentInst);
+            run.m_startInstIndex = startChildInstIndex;
+            run.m_numChildren = Ser::SizeType(int(endChildInstIndex) - int(startChildInstIndex));
+
+            m_serialData->m_childRuns.add(run);
+        }
+    }
+}
+
+void IRSerialWriter::_calcDebugInfo()
 {
     // We need to find the unique source Locs
     // We are not going to store SourceLocs directly, because there may be multiple views mapping
@@ -51,7 +152,7 @@ Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
     // Find all of the source locations and their associated instructions
     List<InstLoc> instLocs;
     const Index numInsts = m_insts.getCount();
-    for (Index i = 1; i < numInsts; i++)
+    for (Index i = _getFirstInstIndex(); i < numInsts; i++)
     {
         IRInst* srcInst = m_insts[i];
         if (!srcInst->sourceLoc.isValid())
@@ -59,7 +160,7 @@ Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
             continue;
         }
         InstLoc instLoc;
-        instLoc.instIndex = uint32_t(i);
+        instLoc.instIndex = uint32_t(m_indexBase + i);
         instLoc.sourceLoc = uint32_t(srcInst->sourceLoc.getRaw());
         instLocs.add(instLoc);
     }
@@ -87,100 +188,35 @@ Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
         {
         }
 
-        // Add the run
+        // Add the run. The raw source loc is converted later by _addDebugSourceLocs, so that
+        // segments only depend on the SerialSourceLocWriter once they have all been encoded.
 
         IRSerialData::SourceLocRun sourceLocRun;
         sourceLocRun.m_numInst = curInstIndex - startInstLoc->instIndex;
-        ;
         sourceLocRun.m_startInstIndex = IRSerialData::InstIndex(startInstLoc->instIndex);
-        sourceLocRun.m_sourceLoc =
-            sourceLocWriter->addSourceLoc(SourceLoc::fromRaw(startSourceLoc));
+        sourceLocRun.m_sourceLoc = startSourceLoc;
 
         m_serialData->m_debugSourceLocRuns.add(sourceLocRun);
 
         // Next
         startInstLoc = curInstLoc;
     }
-
-    return SLANG_OK;
 }
 
-Result IRSerialWriter::write(
-    IRModule* module,
+/* static */ void IRSerialWriter::_addDebugSourceLocs(
     SerialSourceLocWriter* sourceLocWriter,
-    SerialOptionFlags options,
-    IRSerialData* serialData)
+    IRSerialData* data)
 {
-    typedef Ser::Inst::PayloadType PayloadType;
-
-    m_serialData = serialData;
-
-    serialData->clear();
-
-    // We reserve 0 for null
-    m_insts.clear();
-    m_insts.add(nullptr);
-
-    // Reset
-    m_instMap.clear();
-    m_decorations.clear();
-
-    // Stack for parentInst
-    List<IRInst*> parentInstStack;
-
-    IRModuleInst* moduleInst = module->getModuleInst();
-    parentInstStack.add(moduleInst);
-
-    // Add to the map
-    _addInstruction(moduleInst);
-
-    // Traverse all of the instructions
-    while (parentInstStack.getCount())
+    for (auto& sourceLocRun : data->m_debugSourceLocRuns)
     {
-        // If it's in the stack it is assumed it is already in the inst map
-        IRInst* parentInst = parentInstStack.getLast();
-        parentInstStack.removeLast();
-        SLANG_ASSERT(m_instMap.containsKey(parentInst));
-
-        // Okay we go through each of the children in order. If they are IRInstParent derived, we
-        // add to stack to process later cos we want breadth first so the order of children is the
-        // same as their index order, meaning we don't need to store explicit indices
-        const Ser::InstIndex startChildInstIndex = Ser::InstIndex(m_insts.getCount());
-
-        IRInstListBase childrenList = parentInst->getDecorationsAndChildren();
-        for (IRInst* child : childrenList)
-        {
-            // This instruction can't be in the map...
-            SLANG_ASSERT(!m_instMap.containsKey(child));
-
-            _addInstruction(child);
-
-            parentInstStack.add(child);
-        }
-
-        // If it had any children, then store the information about it
-        if (Ser::InstIndex(m_insts.getCount()) != startChildInstIndex)
-        {
-            Ser::InstRun run;
-            run.m_parentIndex = m_instMap[parentInst];
-            run.m_startInstIndex = startChildInstIndex;
-            run.m_numChildren = Ser::SizeType(m_insts.getCount() - int(startChildInstIndex));
-
-            m_serialData->m_childRuns.add(run);
-        }
+        sourceLocRun.m_sourceLoc = sourceLocWriter->addSourceLoc(
+            SourceLoc::fromRaw(SourceLoc::RawValue(sourceLocRun.m_sourceLoc)));
     }
+}
 
-#if 0
-    {
-        List<IRInst*> workInsts;
-        calcInstructionList(module, workInsts);
-        SLANG_ASSERT(workInsts.getCount() == m_insts.getCount());
-        for (UInt i = 0; i < workInsts.getCount(); ++i)
-        {
-            SLANG_ASSERT(workInsts[i] == m_insts[i]);
-        }
-    }
-#endif
+Result IRSerialWriter::_writeInstructions(SerialOptionFlags options)
+{
+    typedef Ser::Inst::PayloadType PayloadType;
 
     // Set to the right size
     m_serialData->m_insts.setCount(m_insts.getCount());
@@ -191,7 +227,7 @@ Result IRSerialWriter::write(
     {
         const Index numInsts = m_insts.getCount();
 
-        for (Index i = 1; i < numInsts; ++i)
+        for (Index i = _getFirstInstIndex(); i < numInsts; ++i)
         {
             IRInst* srcInst = m_insts[i];
             Ser::Inst& dstInst = m_serialData->m_insts[i];
@@ -199,7 +235,7 @@ Result IRSerialWriter::write(
             dstInst.m_op = uint16_t(srcInst->getOp() & kIROpMask_OpMask);
             dstInst.m_payloadType = PayloadType::Empty;
 
-            dstInst.m_resultTypeIndex = getInstIndex(srcInst->getFullType());
+            dstInst.m_resultTypeIndex = _getOperandIndex(srcInst->getFullType());
 
             IRConstant* irConst = as<IRConstant>(srcInst);
             if (irConst)
@@ -295,7 +331,7 @@ Result IRSerialWriter::write(
 
             for (int j = 0; j < numOperands; ++j)
             {
-                const Ser::InstIndex dstInstIndex = getInstIndex(srcInst->getOperand(j));
+                const Ser::InstIndex dstInstIndex = _getOperandIndex(srcInst->getOperand(j));
                 dstOperands[j] = dstInstIndex;
             }
         }
@@ -303,34 +339,159 @@ Result IRSerialWriter::write(
 
     // Convert strings into a string table
     {
-        SerialStringTableUtil::encodeStringTable(m_stringSlicePool, serialData->m_stringTable);
+        SerialStringTableUtil::encodeStringTable(m_stringSlicePool, m_serialData->m_stringTable);
     }
 
     // If the option to use RawSourceLocations is enabled, serialize out as is
     if (options & SerialOptionFlag::RawSourceLocation)
     {
         const Index numInsts = m_insts.getCount();
-        serialData->m_rawSourceLocs.setCount(numInsts);
+        m_serialData->m_rawSourceLocs.setCount(numInsts);
 
-        Ser::RawSourceLoc* dstLocs = serialData->m_rawSourceLocs.begin();
-        // 0 is null, just mark as no location
-        dstLocs[0] = Ser::RawSourceLoc(0);
-        for (Index i = 1; i < numInsts; ++i)
+        Ser::RawSourceLoc* dstLocs = m_serialData->m_rawSourceLocs.begin();
+        for (Index i = 0; i < numInsts; ++i)
         {
+            // null is just marked as no location
             IRInst* srcInst = m_insts[i];
-            dstLocs[i] = Ser::RawSourceLoc(srcInst->sourceLoc.getRaw());
+            dstLocs[i] = srcInst ? Ser::RawSourceLoc(srcInst->sourceLoc.getRaw())
+                                 : Ser::RawSourceLoc(0);
         }
     }
 
+    return SLANG_OK;
+}
+
+Result IRSerialWriter::write(
+    IRModule* module,
+    SerialSourceLocWriter* sourceLocWriter,
+    SerialOptionFlags options,
+    IRSerialData* serialData)
+{
+    _reset(serialData);
+
+    // We reserve 0 for null
+    m_insts.add(nullptr);
+
+    IRModuleInst* moduleInst = module->getModuleInst();
+
+    // Add to the map
+    _addInstruction(moduleInst);
+
+    // Traverse all of the instructions
+    _addDescendants(moduleInst, nullptr);
+
+#if 0
+    {
+        List<IRInst*> workInsts;
+        calcInstructionList(module, workInsts);
+        SLANG_ASSERT(workInsts.getCount() == m_insts.getCount());
+        for (UInt i = 0; i < workInsts.getCount(); ++i)
+        {
+            SLANG_ASSERT(workInsts[i] == m_insts[i]);
+        }
+    }
+#endif
+
+    SLANG_RETURN_ON_FAIL(_writeInstructions(options));
+
     if ((options & SerialOptionFlag::SourceLocation) && sourceLocWriter)
     {
-        _calcDebugInfo(sourceLocWriter);
+        _calcDebugInfo();
+        _addDebugSourceLocs(sourceLocWriter, serialData);
     }
 
     m_serialData = nullptr;
     return SLANG_OK;
 }
 
+Result IRSerialWriter::_writeSegment(
+    const IRSerialWriter* headerWriter,
+    IRInst* rootInst,
+    SerialOptionFlags options,
+    IRSerialChunkedData::Segment* outSegment)
+{
+    _reset(&outSegment->m_data);
+
+    // Indices below the header's instruction count refer to the header
+    m_headerWriter = headerWriter;
+    m_indexBase = headerWriter->m_insts.getCount();
+
+    outSegment->m_info.m_parentIndex = headerWriter->getInstIndex(rootInst);
+    outSegment->m_info.m_headerInstCount = Ser::SizeType(m_indexBase);
+
+    _addDescendants(rootInst, nullptr);
+    SLANG_RETURN_ON_FAIL(_writeInstructions(options));
+
+    if (options & SerialOptionFlag::SourceLocation)
+    {
+        _calcDebugInfo();
+    }
+
+    m_serialData = nullptr;
+    return m_hasUnresolvedOperand ? SLANG_E_NOT_AVAILABLE : SLANG_OK;
+}
+
+Result IRSerialWriter::writeChunked(
+    IRModule* module,
+    SerialSourceLocWriter* sourceLocWriter,
+    SerialOptionFlags options,
+    IRSerialChunkedData* outData)
+{
+    outData->clear();
+
+    if (!sourceLocWriter)
+    {
+        options &= ~SerialOptionFlags(SerialOptionFlag::SourceLocation);
+    }
+
+    // Write the header, which holds everything apart from the segments
+    _reset(&outData->m_header);
+
+    // We reserve 0 for null
+    m_insts.add(nullptr);
+
+    IRModuleInst* moduleInst = module->getModuleInst();
+    _addInstruction(moduleInst);
+
+    List<IRInst*> segmentRoots;
+    _addDescendants(moduleInst, &segmentRoots);
+
+    SLANG_RETURN_ON_FAIL(_writeInstructions(options));
+    if (options & SerialOptionFlag::SourceLocation)
+    {
+        _calcDebugInfo();
+    }
+    m_serialData = nullptr;
+
+    if (m_hasUnresolvedOperand)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // Write the segments. Each only reads the IR and the header writer, so is encoded on its
+    // own, with a writer (and so a string pool) of its own.
+    const Index segmentCount = segmentRoots.getCount();
+    outData->m_segments.setCount(segmentCount);
+    for (Index i = 0; i < segmentCount; ++i)
+    {
+        IRSerialWriter segmentWriter;
+        SLANG_RETURN_ON_FAIL(
+            segmentWriter._writeSegment(this, segmentRoots[i], options, &outData->m_segments[i]));
+    }
+
+    // The source locs are added once all segments are encoded, in the order of the segments
+    if (options & SerialOptionFlag::SourceLocation)
+    {
+        _addDebugSourceLocs(sourceLocWriter, &outData->m_header);
+        for (auto& segment : outData->m_segments)
+        {
+            _addDebugSourceLocs(sourceLocWriter, &segment.m_data);
+        }
+    }
+
+    return SLANG_OK;
+}
+
 Result _writeInstArrayChunk(
     FourCC chunkId,
     const List<IRSerialData::Inst>& array,
@@ -344,9 +505,9 @@ Result _writeInstArrayChunk(
     return SerialRiffUtil::writeArrayChunk(chunkId, array, cursor);
 }
 
-/* static */ Result IRSerialWriter::writeTo(const IRSerialData& data, RIFF::BuildCursor& cursor)
+static Result _writeDataChunks(const IRSerialData& data, RIFF::BuildCursor& cursor)
 {
-    SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, Bin::kIRModuleFourCc);
+    typedef IRSerialBinary Bin;
 
     SLANG_RETURN_ON_FAIL(_writeInstArrayChunk(Bin::kInstFourCc, data.m_insts, cursor));
     SLANG_RETURN_ON_FAIL(
@@ -376,6 +537,47 @@ Result _writeInstArrayChunk(
     return SLANG_OK;
 }
 
+static Result _writeSegmentChunk(
+    const IRSerialData::SegmentInfo& info,
+    const IRSerialData& data,
+    RIFF::BuildCursor& cursor)
+{
+    SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, IRSerialBinary::kSegmentFourCc);
+
+    SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(
+        IRSerialBinary::kSegmentInfoFourCc,
+        &info,
+        1,
+        sizeof(info),
+        cursor));
+    return _writeDataChunks(data, cursor);
+}
+
+/* static */ Result IRSerialWriter::writeTo(const IRSerialData& data, RIFF::BuildCursor& cursor)
+{
+    SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, Bin::kIRModuleFourCc);
+    return _writeDataChunks(data, cursor);
+}
+
+/* static */ Result IRSerialWriter::writeTo(
+    const IRSerialChunkedData& data,
+    RIFF::BuildCursor& cursor)
+{
+    SLANG_SCOPED_RIFF_BUILDER_LIST_CHUNK(cursor, Bin::kIRModuleFourCc);
+
+    // The header has no parent
+    IRSerialData::SegmentInfo headerInfo;
+    headerInfo.m_parentIndex = Ser::InstIndex(0);
+    headerInfo.m_headerInstCount = 0;
+    SLANG_RETURN_ON_FAIL(_writeSegmentChunk(headerInfo, data.m_header, cursor));
+
+    for (const auto& segment : data.m_segments)
+    {
+        SLANG_RETURN_ON_FAIL(_writeSegmentChunk(segment.m_info, segment.m_data, cursor));
+    }
+    return SLANG_OK;
+}
+
 /* static */ void IRSerialWriter::calcInstructionList(IRModule* module, List<IRInst*>& instsOut)
 {
     // We reserve 0 for null
@@ -415,15 +617,13 @@ static Result _readInstArrayChunk(RIFF::DataChunk const* chunk, List<IRSerialDat
     return SerialRiffUtil::readArrayChunk(chunk, resizer);
 }
 
-/* static */ Result IRSerialReader::readFrom(
-    IRModuleChunk const* irModuleChunk,
-    IRSerialData* outData)
+static Result _readDataChunks(RIFF::ListChunk const* listChunk, IRSerialData* outData)
 {
     typedef IRSerialBinary Bin;
 
     outData->clear();
 
-    for (auto chunk : irModuleChunk->getChildren())
+    for (auto chunk : listChunk->getChildren())
     {
         auto dataChunk = as<RIFF::DataChunk>(chunk);
         if (!dataChunk)
@@ -478,21 +678,135 @@ static Result _readInstArrayChunk(RIFF::DataChunk const* chunk, List<IRSerialDat
     return SLANG_OK;
 }
 
+/* static */ Result IRSerialReader::readFrom(
+    IRModuleChunk const* irModuleChunk,
+    IRSerialData* outData)
+{
+    return _readDataChunks(irModuleChunk, outData);
+}
+
+/* static */ Result IRSerialReader::readFrom(
+    IRModuleChunk const* irModuleChunk,
+    IRSerialChunkedData* outData)
+{
+    typedef IRSerialBinary Bin;
+
+    outData->clear();
+
+    // If there are no segments, it's the monolithic format
+    if (!irModuleChunk->findListChunk(Bin::kSegmentFourCc))
+    {
+        return _readDataChunks(irModuleChunk, &outData->m_header);
+    }
+
+    bool hasHeader = false;
+    for (auto chunk : irModuleChunk->getChildren())
+    {
+        auto segmentChunk = as<RIFF::ListChunk>(chunk);
+        if (!segmentChunk || segmentChunk->getType() != Bin::kSegmentFourCc)
+        {
+            continue;
+        }
+
+        List<IRSerialData::SegmentInfo> infos;
+        auto infoChunk = segmentChunk->findDataChunk(Bin::kSegmentInfoFourCc);
+        if (!infoChunk)
+        {
+            return SLANG_FAIL;
+        }
+        SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(infoChunk, infos));
+        if (infos.getCount() != 1)
+        {
+            return SLANG_FAIL;
+        }
+
+        // The first segment is the header
+        if (!hasHeader)
+        {
+            hasHeader = true;
+            SLANG_RETURN_ON_FAIL(_readDataChunks(segmentChunk, &outData->m_header));
+            continue;
+        }
+
+        outData->m_segments.add(IRSerialChunkedData::Segment());
+        auto& segment = outData->m_segments.getLast();
+        segment.m_info = infos[0];
+        SLANG_RETURN_ON_FAIL(_readDataChunks(segmentChunk, &segment.m_data));
+    }
+
+    return SLANG_OK;
+}
+
 Result IRSerialReader::read(
     const IRSerialData& data,
     Session* session,
     SerialSourceLocReader* sourceLocReader,
     RefPtr<IRModule>& outModule)
 {
-    // Only used in debug builds
-    [[maybe_unused]] typedef Ser::Inst::PayloadType PayloadType;
-
     m_serialData = &data;
 
     auto module = IRModule::create(session);
     outModule = module;
     m_module = module;
 
+    List<IRInst*> insts;
+    SLANG_RETURN_ON_FAIL(_readInsts(data, 0, sourceLocReader, insts));
+
+    outModule->buildMangledNameToGlobalInstMap();
+
+    return SLANG_OK;
+}
+
+Result IRSerialReader::read(
+    const IRSerialChunkedData& data,
+    Session* session,
+    SerialSourceLocReader* sourceLocReader,
+    RefPtr<IRModule>& outModule)
+{
+    m_serialData = &data.m_header;
+
+    auto module = IRModule::create(session);
+    outModule = module;
+    m_module = module;
+
+    m_headerInsts.clear();
+    SLANG_RETURN_ON_FAIL(_readInsts(data.m_header, 0, sourceLocReader, m_headerInsts));
+
+    // Each segment only refers to its own instructions and the header, so the segments could be
+    // decoded in any order.
+    const Index headerInstCount = m_headerInsts.getCount();
+    for (const auto& segment : data.m_segments)
+    {
+        // The segment must have been written against this header
+        if (Index(segment.m_info.m_headerInstCount) != headerInstCount ||
+            Index(segment.m_info.m_parentIndex) >= headerInstCount)
+        {
+            return SLANG_FAIL;
+        }
+
+        m_serialData = &segment.m_data;
+
+        List<IRInst*> insts;
+        SLANG_RETURN_ON_FAIL(_readInsts(segment.m_data, headerInstCount, sourceLocReader, insts));
+    }
+
+    // All the global instructions (and so their decorations) are in the header
+    outModule->buildMangledNameToGlobalInstMap();
+
+    return SLANG_OK;
+}
+
+Result IRSerialReader::_readInsts(
+    const IRSerialData& data,
+    Index indexBase,
+    SerialSourceLocReader* sourceLocReader,
+    List<IRInst*>& outInsts)
+{
+    // Only used in debug builds
+    [[maybe_unused]] typedef Ser::Inst::PayloadType PayloadType;
+
+    IRModule* module = m_module;
+
     // Convert m_stringTable into StringSlicePool.
     SerialStringTableUtil::decodeStringTable(
         data.m_stringTable.getBuffer(),
@@ -533,33 +847,46 @@ Result IRSerialReader::read(
     // plan for how to handle forward and/or circular references in the IR module.
 
     // Add all the instructions
-    List<IRInst*> insts;
+    List<IRInst*>& insts = outInsts;
 
     const Index numInsts = data.m_insts.getCount();
+    insts.setCount(numInsts);
 
-    SLANG_ASSERT(numInsts > 0);
+    // Instructions before indexBase were created when reading the header
+    auto getInst = [&](Ser::InstIndex instIndex) -> IRInst*
+    {
+        const Index index = Index(instIndex);
+        return index < indexBase ? m_headerInsts[index] : insts[index - indexBase];
+    };
 
-    insts.setCount(numInsts);
-    insts[0] = nullptr;
+    // The index of the first instruction that is encoded in data
+    Index firstInstIndex = 0;
 
     // 0 holds null
     // 1 holds the IRModuleInst
+    // Unless this is a segment, which only holds instructions within a function or generic
+    if (indexBase == 0)
     {
+        SLANG_ASSERT(numInsts > 1);
+        insts[0] = nullptr;
+
         // Check that insts[1] is the module inst
         const Ser::Inst& srcInst = data.m_insts[1];
         SLANG_RELEASE_ASSERT(srcInst.m_op == kIROp_Module);
         SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
 
         // The root IR instruction for the module will already have
-        // been created as part of creating `module` above.
+        // been created as part of creating `module`.
         //
         auto moduleInst = module->getModuleInst();
 
         // Set the IRModuleInst
         insts[1] = moduleInst;
+
+        firstInstIndex = 1;
     }
 
-    for (Index i = 2; i < numInsts; ++i)
+    for (Index i = (indexBase == 0) ? 2 : 0; i < numInsts; ++i)
     {
         const Ser::Inst& srcInst = data.m_insts[i];
 
@@ -668,7 +995,7 @@ Result IRSerialReader::read(
     }
 
     // Patch up the operands
-    for (Index i = 1; i < numInsts; ++i)
+    for (Index i = firstInstIndex; i < numInsts; ++i)
     {
         const Ser::Inst& srcInst = data.m_insts[i];
         const IROp op((IROp)srcInst.m_op);
@@ -679,7 +1006,7 @@ Result IRSerialReader::read(
         // Set the result type
         if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
         {
-            IRInst* resultInst = insts[int(srcInst.m_resultTypeIndex)];
+            IRInst* resultInst = getInst(srcInst.m_resultTypeIndex);
             // NOTE! Counter intuitively the IRType* paramter may not be IRType* derived for example
             // IRGlobalGenericParam is valid, but isn't IRType* derived
 
@@ -696,7 +1023,7 @@ Result IRSerialReader::read(
 
             for (int j = 0; j < numOperands; j++)
             {
-                dstOperands[j].init(dstInst, insts[int(srcOperandIndices[j])]);
+                dstOperands[j].init(dstInst, getInst(srcOperandIndices[j]));
             }
         }
     }
@@ -708,11 +1035,11 @@ Result IRSerialReader::read(
         {
             const auto& run = data.m_childRuns[i];
 
-            IRInst* inst = insts[int(run.m_parentIndex)];
+            IRInst* inst = getInst(run.m_parentIndex);
 
             for (int j = 0; j < int(run.m_numChildren); ++j)
             {
-                IRInst* child = insts[j + int(run.m_startInstIndex)];
+                IRInst* child = getInst(Ser::InstIndex(j + int(run.m_startInstIndex)));
                 SLANG_ASSERT(child->parent == nullptr);
                 child->insertAtEnd(inst);
             }
@@ -720,10 +1047,10 @@ Result IRSerialReader::read(
     }
 
     // Re-add source locations, if they are defined
-    if (m_serialData->m_rawSourceLocs.getCount() == numInsts)
+    if (data.m_rawSourceLocs.getCount() == numInsts)
     {
-        const Ser::RawSourceLoc* srcLocs = m_serialData->m_rawSourceLocs.begin();
-        for (Index i = 1; i < numInsts; ++i)
+        const Ser::RawSourceLoc* srcLocs = data.m_rawSourceLocs.begin();
+        for (Index i = firstInstIndex; i < numInsts; ++i)
         {
             IRInst* dstInst = insts[i];
 
@@ -732,9 +1059,9 @@ Result IRSerialReader::read(
     }
 
     // We now need to apply the runs
-    if (sourceLocReader && m_serialData->m_debugSourceLocRuns.getCount())
+    if (sourceLocReader && data.m_debugSourceLocRuns.getCount())
     {
-        List<IRSerialData::SourceLocRun> sourceRuns(m_serialData->m_debugSourceLocRuns);
+        List<IRSerialData::SourceLocRun> sourceRuns(data.m_debugSourceLocRuns);
         // They are now in source location order
         sourceRuns.sort();
 
@@ -759,8 +1086,9 @@ Result IRSerialReader::read(
             }
 
             // Write to all the instructions
-            SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= insts.getCount());
-            IRInst** dstInsts = insts.getBuffer() + int(run.m_startInstIndex);
+            const Index startIndex = Index(run.m_startInstIndex) - indexBase;
+            SLANG_ASSERT(startIndex >= 0 && startIndex + Index(run.m_numInst) <= insts.getCount());
+            IRInst** dstInsts = insts.getBuffer() + startIndex;
 
             const int runSize = int(run.m_numInst);
             for (int j = 0; j < runSize; ++j)
@@ -770,8 +1098,6 @@ Result IRSerialReader::read(
         }
     }
 
-    outModule->buildMangledNameToGlobalInstMap();
-
     return SLANG_OK;
 }
 
@@ -28,8 +28,19 @@ struct IRSerialWriter
         SerialOptionFlags flags,
         IRSerialData* serialData);
 
+    /// Write `module` in the chunked format, where the body of each global function and generic
+    /// is encoded separately.
+    /// Returns SLANG_E_NOT_AVAILABLE if the module has a reference between bodies (or from
+    /// outside a body into one), which the chunked format can't represent.
+    Result writeChunked(
+        IRModule* module,
+        SerialSourceLocWriter* sourceLocWriter,
+        SerialOptionFlags flags,
+        IRSerialChunkedData* outData);
+
     /// Write to a container
     static Result writeTo(const IRSerialData& data, RIFF::BuildCursor& cursor);
+    static Result writeTo(const IRSerialChunkedData& data, RIFF::BuildCursor& cursor);
 
     /// Get an instruction index from an instruction
     Ser::InstIndex getInstIndex(IRInst* inst) const
@@ -75,8 +86,27 @@ struct IRSerialWriter
     static void calcInstructionList(IRModule* module, List<IRInst*>& instsOut);
 
 protected:
+    void _reset(IRSerialData* serialData);
     void _addInstruction(IRInst* inst);
-    Result _calcDebugInfo(SerialSourceLocWriter* sourceLocWriter);
+    /// Add the decorations and children of `rootInst` (which must already have an index),
+    /// recursively. If `outSegmentRoots` is set, the descendants of global functions and
+    /// generics are not added, and the functions and generics are added to `outSegmentRoots`.
+    void _addDescendants(IRInst* rootInst, List<IRInst*>* outSegmentRoots);
+    /// Encode the added instructions into m_serialData
+    Result _writeInstructions(SerialOptionFlags flags);
+    Result _writeSegment(
+        const IRSerialWriter* headerWriter,
+        IRInst* rootInst,
+        SerialOptionFlags flags,
+        IRSerialChunkedData::Segment* outSegment);
+    Ser::InstIndex _getOperandIndex(IRInst* inst);
+    /// Finds runs of instructions with the same source loc. The runs hold the raw SourceLoc, and
+    /// are converted with `_addDebugSourceLocs`.
+    void _calcDebugInfo();
+    static void _addDebugSourceLocs(SerialSourceLocWriter* sourceLocWriter, IRSerialData* data);
+
+    /// The index of the first instruction in m_insts that is encoded
+    Index _getFirstInstIndex() const { return m_headerWriter ? 0 : 1; }
 
     List<IRInst*> m_insts; ///< Instructions in same order as stored in the
 
@@ -89,6 +119,12 @@ protected:
 
     StringSlicePool m_stringSlicePool;
     IRSerialData* m_serialData; ///< Where the data is stored
+
+    /// Set when writing a segment of the chunked format. Instructions not in the segment are
+    /// looked up in the header.
+    const IRSerialWriter* m_headerWriter = nullptr;
+    Index m_indexBase = 0; ///< The instruction index of m_insts[0]
+    bool m_hasUnresolvedOperand = false;
 };
 
 struct IRSerialReader
@@ -97,6 +133,8 @@ struct IRSerialReader
 
     /// Read a stream to fill in dataOut IRSerialData
     static Result readFrom(IRModuleChunk const* irModuleChunk, IRSerialData* outData);
+    /// Read a stream in either format. The monolithic format is read as just a header.
+    static Result readFrom(IRModuleChunk const* irModuleChunk, IRSerialChunkedData* outData);
 
     /// Read a module from serial data
     Result read(
@@ -104,6 +142,12 @@ struct IRSerialReader
         Session* session,
         SerialSourceLocReader* sourceLocReader,
         RefPtr<IRModule>& outModule);
+    /// Read a module from chunked data, including all the segments
+    Result read(
+        const IRSerialChunkedData& data,
+        Session* session,
+        SerialSourceLocReader* sourceLocReader,
+        RefPtr<IRModule>& outModule);
 
     IRSerialReader()
         : m_serialData(nullptr), m_module(nullptr), m_stringTable(StringSlicePool::Style::Default)
@@ -111,10 +155,21 @@ struct IRSerialReader
     }
 
 protected:
+    /// Create the instructions in `data` and set up their operands, children and source locs.
+    /// Instruction indices below `indexBase` refer to m_headerInsts, others to the instruction at
+    /// `index - indexBase` in `data`. The created instructions are added to `outInsts`.
+    Result _readInsts(
+        const IRSerialData& data,
+        Index indexBase,
+        SerialSourceLocReader* sourceLocReader,
+        List<IRInst*>& outInsts);
+
     StringSlicePool m_stringTable;
 
     const IRSerialData* m_serialData;
     IRModule* m_module;
+
+    List<IRInst*> m_headerInsts; ///< The instructions created from the header, indexed as in it
 };
 
 } // namespace Slang
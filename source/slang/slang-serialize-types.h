@@ -126,6 +126,15 @@ struct PropertyKeys<Module>
     static const FourCC::RawValue Digest = SLANG_FOUR_CC('S', 'H', 'A', '1');
     static const FourCC::RawValue ASTModule = SLANG_FOUR_CC('a', 's', 't', ' ');
     static const FourCC::RawValue FileDependencies = SLANG_FOUR_CC('f', 'd', 'e', 'p');
+
+    /// Digest of the declarations of the module that importers can depend on
+    static const FourCC::RawValue InterfaceDigest = SLANG_FOUR_CC('S', 'H', 'A', 'i');
+    /// Digest of the compile options, and the files that belong to the module itself
+    static const FourCC::RawValue SourceDigest = SLANG_FOUR_CC('S', 'H', 'A', 's');
+    /// Indices into FileDependencies of the files that belong to the module itself
+    static const FourCC::RawValue SourceFileIndices = SLANG_FOUR_CC('s', 'r', 'c', 'i');
+    /// The name and interface digest of each module imported (directly or indirectly)
+    static const FourCC::RawValue ImportedInterfaces = SLANG_FOUR_CC('i', 'm', 'p', 'i');
 };
 
 // For types/FourCC that work for serializing in general (not just IR).
@@ -587,6 +587,9 @@ RequirementWitness tryLookUpRequirementWitness(
     SubtypeWitness* subtypeWitness,
     Decl* requirementKey)
 {
+    // Witness tables are filled in as conformances are checked, which increments the epoch
+    markValResolveDependsOnEpoch();
+
     if (auto declaredSubtypeWitness = as<DeclaredSubtypeWitness>(subtypeWitness))
     {
         if (auto inheritanceDeclRef = declaredSubtypeWitness->getDeclRef().as<InheritanceDecl>())
@@ -777,6 +780,8 @@ Type* DeclRefType::create(ASTBuilder* astBuilder, DeclRef<Decl> declRef)
         if (typedefDecl->type.type)
             return as<Type>(
                 typedefDecl->type.type->substitute(astBuilder, SubstitutionSet(declRef)));
+        // The typedef hasn't been checked yet
+        markValResolveDependsOnEpoch();
         return astBuilder->getErrorType();
     }
 
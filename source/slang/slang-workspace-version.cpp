@@ -199,6 +199,15 @@ void Workspace::invalidate()
     currentVersion = nullptr;
 }
 
+void Workspace::invalidateCancelledVersions()
+{
+    if (currentVersion && currentVersion->linkage->contentAssistInfo.checkingCancelled)
+        currentVersion = nullptr;
+    if (currentCompletionVersion &&
+        currentCompletionVersion->linkage->contentAssistInfo.checkingCancelled)
+        currentCompletionVersion = nullptr;
+}
+
 void WorkspaceVersion::parseDiagnostics(String compilerOutput)
 {
     List<UnownedStringSlice> lines;
@@ -352,6 +361,7 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
     slangGlobalSession->createSession(desc, session.writeRef());
     version->linkage = static_cast<Linkage*>(session.get());
     version->linkage->contentAssistInfo.checkingMode = ContentAssistCheckingMode::General;
+    version->linkage->contentAssistInfo.cancelRequested = cancelRequested;
     return version;
 }
 
@@ -172,6 +172,8 @@ public:
     OrderedHashSet<String> workspaceSearchPaths;
     List<OwnedPreprocessorMacroDefinition> predefinedMacros;
     bool searchInWorkspace = true;
+    /// Checking for requests stops early once this is set. See ContentAssistInfo.
+    const std::atomic<bool>* cancelRequested = nullptr;
 
     slang::IGlobalSession* slangGlobalSession;
     Dictionary<String, RefPtr<DocumentVersion>> openedDocuments;
@@ -189,6 +191,9 @@ public:
 
     void init(List<URI> rootDirURI, slang::IGlobalSession* globalSession);
     void invalidate();
+    /// Drop versions whose checking was cut short by a cancelled request, as their modules are
+    /// incomplete.
+    void invalidateCancelledVersions();
     WorkspaceVersion* getCurrentVersion();
     WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
     WorkspaceVersion* createVersionForCompletion();
@@ -20,10 +20,12 @@
 #include "../core/slang-writer.h"
 #include "core/slang-shared-library.h"
 #include "slang-ast-dump.h"
+#include "slang-ast-print.h"
 #include "slang-check-impl.h"
 #include "slang-check.h"
 #include "slang-doc-ast.h"
 #include "slang-doc-markdown-writer.h"
+#include "slang-ir-unroll-inline-heuristics.h"
 #include "slang-lookup.h"
 #include "slang-lower-to-ir.h"
 #include "slang-mangle.h"
@@ -32,6 +34,7 @@
 #include "slang-parameter-binding.h"
 #include "slang-parser.h"
 #include "slang-preprocessor.h"
+#include "slang-reflection-binary-writer.h"
 #include "slang-reflection-json.h"
 #include "slang-repro.h"
 #include "slang-serialize-ast.h"
@@ -1438,6 +1441,26 @@ TypeCheckingCache* Linkage::getTypeCheckingCache()
     return static_cast<TypeCheckingCache*>(m_typeCheckingCache.get());
 }
 
+ProfileFeedback* Linkage::getProfileFeedback(String const& path, DiagnosticSink* sink)
+{
+    if (auto found = m_profileFeedbacks.tryGetValue(path))
+    {
+        return static_cast<ProfileFeedback*>(found->get());
+    }
+
+    String text;
+    if (SLANG_FAILED(File::readAllText(path, text)))
+    {
+        sink->diagnose(SourceLoc(), Diagnostics::cannotOpenFile, path);
+        return nullptr;
+    }
+
+    RefPtr<ProfileFeedback> profile = new ProfileFeedback();
+    profile->parse(text.getUnownedSlice(), path, sink);
+    m_profileFeedbacks.add(path, profile);
+    return profile;
+}
+
 void Linkage::destroyTypeCheckingCache()
 {
     m_typeCheckingCache = nullptr;
@@ -3845,6 +3868,15 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
     // language(s) and stash the result blobs in IR.
     for (auto target : getLinkage()->targets)
     {
+        if (target->getOptionSet().getBoolOption(CompilerOptionName::EmbedTargetIR))
+        {
+            for (auto translationUnit : getFrontEndReq()->translationUnits)
+            {
+                SLANG_RETURN_ON_FAIL(
+                    translationUnit->getModule()->precompileTargetIR(target, getSink()));
+            }
+        }
+
         SlangCompileTarget targetEnum = SlangCompileTarget(target->getTarget());
         if (target->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
         {
@@ -4771,7 +4803,21 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* bas
     if (!moduleChunk)
         return false;
 
-    SHA1::Digest existingDigest = moduleChunk->getDigest();
+    // If the module was written with the interface digests of the modules it imports, only its
+    // own files are checked, along with those interfaces. So a change to the implementation of an
+    // imported module doesn't require the module to be recompiled, just linked again.
+    const bool checkImportedInterfaces = moduleChunk->hasImportedInterfaces();
+    HashSet<Index> sourceFileIndices;
+    if (checkImportedInterfaces)
+    {
+        for (auto index : moduleChunk->getSourceFileIndices())
+        {
+            sourceFileIndices.add(index);
+        }
+    }
+
+    SHA1::Digest existingDigest =
+        checkImportedInterfaces ? moduleChunk->getSourceDigest() : moduleChunk->getDigest();
 
     DigestBuilder<SHA1> digestBuilder;
     auto version = String(getBuildTagString());
@@ -4798,8 +4844,12 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* bas
         }
     }
 
+    Index dependencyIndex = 0;
     for (auto dependencyChunk : dependencyChunks)
     {
+        if (checkImportedInterfaces && !sourceFileIndices.contains(dependencyIndex++))
+            continue;
+
         auto file = dependencyChunk->getValue();
         auto sourceFile = loadSourceFile(fromPath, file);
         if (!sourceFile)
@@ -4813,7 +4863,38 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RIFF::ListChunk const* bas
             return false;
         digestBuilder.append(sourceFile->getDigest());
     }
-    return digestBuilder.finalize() == existingDigest;
+    if (digestBuilder.finalize() != existingDigest)
+        return false;
+
+    return !checkImportedInterfaces || _areImportedModuleInterfacesUpToDate(moduleChunk);
+}
+
+bool Linkage::_areImportedModuleInterfacesUpToDate(ModuleChunk const* moduleChunk)
+{
+    DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
+    for (const auto& importedInterface : moduleChunk->getImportedInterfaces())
+    {
+        // Importing the module will compile it if its own binary module is out of date
+        RefPtr<Module> importedModule;
+        try
+        {
+            importedModule = findOrImportModule(
+                getNamePool()->getName(importedInterface.name),
+                SourceLoc(),
+                &sink);
+        }
+        catch (const AbortCompilationException&)
+        {
+            return false;
+        }
+
+        if (!importedModule ||
+            importedModule->computeInterfaceDigest() != importedInterface.interfaceDigest)
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 SLANG_NO_THROW bool SLANG_MCALL
@@ -5066,6 +5147,188 @@ SHA1::Digest Module::computeDigest()
     return m_digest;
 }
 
+/// Add the parts of `decl` and its members that modules importing it can depend on to `printer`.
+/// Returns false if the bodies of functions can be part of the interface, because they are
+/// inlined into importers.
+static bool _addDeclInterface(ASTPrinter& printer, Decl* decl)
+{
+    auto& sb = printer.getStringBuilder();
+
+    sb << decl->getClass().getName();
+    if (auto name = decl->getName())
+    {
+        sb << " " << name->text;
+    }
+
+    for (auto modifier : decl->modifiers)
+    {
+        if (as<UnsafeForceInlineEarlyAttribute>(modifier))
+        {
+            return false;
+        }
+        sb << " " << modifier->getClass().getName();
+        if (auto attribute = as<AttributeBase>(modifier))
+        {
+            for (auto arg : attribute->args)
+            {
+                sb << " ";
+                printer.addExpr(arg);
+            }
+        }
+    }
+
+    if (auto varDecl = as<VarDeclBase>(decl))
+    {
+        sb << " : ";
+        printer.addType(varDecl->getType());
+
+        // Constant values are folded, and default arguments and field initializers are lowered,
+        // by importers
+        if (varDecl->val)
+        {
+            sb << " = ";
+            printer.addVal(varDecl->val);
+        }
+        else if (varDecl->initExpr)
+        {
+            sb << " = ";
+            printer.addExpr(varDecl->initExpr);
+        }
+    }
+    else if (auto callableDecl = as<CallableDecl>(decl))
+    {
+        sb << " -> ";
+        printer.addType(callableDecl->returnType.type);
+        if (callableDecl->errorType.type)
+        {
+            sb << " throws ";
+            printer.addType(callableDecl->errorType.type);
+        }
+    }
+    else if (auto typeDefDecl = as<TypeDefDecl>(decl))
+    {
+        sb << " = ";
+        printer.addType(typeDefDecl->type.type);
+    }
+    else if (auto extensionDecl = as<ExtensionDecl>(decl))
+    {
+        sb << " ";
+        printer.addType(extensionDecl->targetType.type);
+    }
+    else if (auto enumCaseDecl = as<EnumCaseDecl>(decl))
+    {
+        if (enumCaseDecl->tagVal)
+        {
+            sb << " = ";
+            printer.addVal(enumCaseDecl->tagVal);
+        }
+    }
+    else if (auto constraintDecl = as<TypeConstraintDecl>(decl))
+    {
+        if (auto genericConstraintDecl = as<GenericTypeConstraintDecl>(decl))
+        {
+            sb << " ";
+            printer.addType(genericConstraintDecl->sub.type);
+        }
+        sb << " : ";
+        printer.addType(constraintDecl->getSup().type);
+    }
+    else if (auto importDecl = as<ImportDecl>(decl))
+    {
+        if (auto importedModuleDecl = importDecl->importedModuleDecl)
+        {
+            if (auto importedName = importedModuleDecl->getName())
+            {
+                sb << " " << importedName->text;
+            }
+        }
+    }
+    sb << "\n";
+
+    // The members of a function are its parameters, its body is held elsewhere
+    if (auto containerDecl = as<ContainerDecl>(decl))
+    {
+        for (auto member : containerDecl->members)
+        {
+            if (!_addDeclInterface(printer, member))
+            {
+                return false;
+            }
+        }
+    }
+    if (auto genericDecl = as<GenericDecl>(decl))
+    {
+        if (genericDecl->inner && !_addDeclInterface(printer, genericDecl->inner))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+SHA1::Digest Module::computeInterfaceDigest()
+{
+    if (m_interfaceDigest == SHA1::Digest())
+    {
+        DigestBuilder<SHA1> digestBuilder;
+        auto version = String(getBuildTagString());
+        digestBuilder.append(version);
+
+        ASTPrinter printer(getASTBuilder());
+        if (m_moduleDecl && _addDeclInterface(printer, m_moduleDecl))
+        {
+            digestBuilder.append(printer.getSlice());
+        }
+        else
+        {
+            // Importers can depend on the implementation, so it is part of the interface
+            digestBuilder.append(computeDigest());
+        }
+        m_interfaceDigest = digestBuilder.finalize();
+    }
+    return m_interfaceDigest;
+}
+
+List<Index> Module::getSourceFileDependencyIndices()
+{
+    HashSet<SourceFile*> importedFiles;
+    for (auto module : getModuleDependencyList())
+    {
+        if (module == this)
+            continue;
+        for (auto file : module->getFileDependencyList())
+        {
+            importedFiles.add(file);
+        }
+    }
+
+    List<Index> indices;
+    auto fileDependencies = getFileDependencies();
+    for (Index i = 0; i < fileDependencies.getCount(); ++i)
+    {
+        if (!importedFiles.contains(fileDependencies[i]))
+        {
+            indices.add(i);
+        }
+    }
+    return indices;
+}
+
+SHA1::Digest Module::computeSourceDigest()
+{
+    DigestBuilder<SHA1> digestBuilder;
+    auto version = String(getBuildTagString());
+    digestBuilder.append(version);
+    getOptionSet().buildHash(digestBuilder);
+
+    auto fileDependencies = getFileDependencies();
+    for (auto index : getSourceFileDependencyIndices())
+    {
+        digestBuilder.append(fileDependencies[index]->getDigest());
+    }
+    return digestBuilder.finalize();
+}
+
 void Module::addModuleDependency(Module* module)
 {
     m_moduleDependencyList.addDependency(module);
@@ -6690,6 +6953,7 @@ SlangResult Linkage::loadSerializedModuleContents(
     }
     module->setPathInfo(moduleFilePathInfo);
     module->setDigest(moduleChunk->getDigest());
+    module->setInterfaceDigest(moduleChunk->getInterfaceDigest());
     module->_collectShaderParams();
     module->_discoverEntryPoints(sink, targets);
 
@@ -7465,6 +7729,14 @@ void EndToEndCompileRequest::setAllowGLSLInput(bool value)
     getOptionSet().set(CompilerOptionName::AllowGLSL, value);
 }
 
+/// Get the profiler that results should be reported from, based on `optionSet`
+static PerformanceProfiler* _getReportingProfiler(CompilerOptionSet& optionSet)
+{
+    return optionSet.getBoolOption(CompilerOptionName::ReportPerfBenchmarkAllThreads)
+               ? PerformanceProfiler::getAllThreadsProfiler()
+               : PerformanceProfiler::getProfiler();
+}
+
 SlangResult EndToEndCompileRequest::compile()
 {
     SlangResult res = SLANG_FAIL;
@@ -7474,7 +7746,24 @@ SlangResult EndToEndCompileRequest::compile()
     if (getOptionSet().getBoolOption(CompilerOptionName::ReportDownstreamTime))
     {
         getSession()->getCompilerElapsedTime(&totalStartTime, &downstreamStartTime);
-        PerformanceProfiler::getProfiler()->clear();
+        _getReportingProfiler(getOptionSet())->clear();
+    }
+    else if (getOptionSet().getBoolOption(CompilerOptionName::ReportPerfBenchmarkAllThreads))
+    {
+        // Other threads may have results left from earlier compiles, which would otherwise be
+        // combined into the report of this one.
+        _getReportingProfiler(getOptionSet())->clear();
+    }
+
+    // Hot functions are only profiled on this thread, whilst compiling, so compiles on other
+    // threads are unaffected
+    PerformanceProfiler* threadProfiler = PerformanceProfiler::getProfiler();
+    const uint32_t hotSiteSampleInterval = uint32_t(
+        getOptionSet().getIntOption(CompilerOptionName::ReportPerfBenchmarkHotFunctions));
+    const uint32_t prevHotSiteSampleInterval = threadProfiler->getHotSiteSampleInterval();
+    if (hotSiteSampleInterval)
+    {
+        threadProfiler->setHotSiteSampleInterval(hotSiteSampleInterval);
     }
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
@@ -7538,6 +7827,11 @@ SlangResult EndToEndCompileRequest::compile()
     }
 #endif
 
+    if (hotSiteSampleInterval)
+    {
+        threadProfiler->setHotSiteSampleInterval(prevHotSiteSampleInterval);
+    }
+
     if (getOptionSet().getBoolOption(CompilerOptionName::ReportDownstreamTime))
     {
         double downstreamEndTime = 0;
@@ -7550,8 +7844,16 @@ SlangResult EndToEndCompileRequest::compile()
     if (getOptionSet().getBoolOption(CompilerOptionName::ReportPerfBenchmark))
     {
         StringBuilder perfResult;
-        PerformanceProfiler::getProfiler()->getResult(perfResult);
+        _getReportingProfiler(getOptionSet())->getResult(perfResult);
         perfResult << "\nType Dictionary Size: " << getSession()->m_typeDictionarySize << "\n";
+
+        const auto& resolveStats = getSession()->m_sharedASTBuilder->getValResolveStats();
+        perfResult << "Val Resolve: calls: " << resolveStats.resolveCount
+                   << ", hits: " << resolveStats.hitCount
+                   << ", stable hits: " << resolveStats.stableHitCount
+                   << ", resolved: " << resolveStats.resolveImplCount << ", average chain depth: "
+                   << String(resolveStats.getAverageChainDepth(), "%.2f")
+                   << ", max chain depth: " << resolveStats.maxChainDepth << "\n";
         getSink()->diagnose(
             SourceLoc(),
             Diagnostics::performanceBenchmarkResult,
@@ -7601,7 +7903,7 @@ SlangResult EndToEndCompileRequest::compile()
         if (reflectionPath == "-")
         {
             auto builder = bufferWriter.getBuilder();
-            StdWriters::getOut().write(builder.getBuffer(), builder.getLength());
+            getWriter(WriterChannel::StdOutput)->write(builder.getBuffer(), builder.getLength());
         }
         else if (SLANG_FAILED(File::writeAllText(reflectionPath, bufferWriter.getBuilder())))
         {
@@ -7609,6 +7911,19 @@ SlangResult EndToEndCompileRequest::compile()
         }
     }
 
+    auto reflectionBinaryPath =
+        getOptionSet().getStringOption(CompilerOptionName::EmitReflectionBinary);
+    if (reflectionBinaryPath.getLength() != 0)
+    {
+        List<uint8_t> data;
+        if (SLANG_FAILED(emitReflectionBinary(this->getReflection(), data)) ||
+            SLANG_FAILED(
+                File::writeAllBytes(reflectionBinaryPath, data.getBuffer(), data.getCount())))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, reflectionBinaryPath);
+        }
+    }
+
     return res;
 }
 
@@ -7688,11 +8003,12 @@ SlangResult EndToEndCompileRequest::getCompileTimeProfile(
         return SLANG_E_INVALID_ARG;
     }
 
-    SlangProfiler* profiler = new SlangProfiler(PerformanceProfiler::getProfiler());
+    PerformanceProfiler* performanceProfiler = _getReportingProfiler(getOptionSet());
+    SlangProfiler* profiler = new SlangProfiler(performanceProfiler);
 
     if (shouldClear)
     {
-        PerformanceProfiler::getProfiler()->clear();
+        performanceProfiler->clear();
     }
 
     ComPtr<ISlangProfiler> result(profiler);
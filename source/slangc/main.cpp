@@ -4,9 +4,13 @@
 
 SLANG_API void spSetCommandLineCompilerMode(SlangCompileRequest* request);
 
+#include "../compiler-core/slang-batch-compile.h"
 #include "../core/slang-io.h"
+#include "../core/slang-platform.h"
+#include "../core/slang-string-util.h"
 #include "../core/slang-test-tool-util.h"
 #include "../slang/slang-internal.h"
+#include "slang-compile-daemon.h"
 
 using namespace Slang;
 
@@ -18,16 +22,36 @@ using namespace Slang;
 #define MAIN main
 #endif
 
-static void _diagnosticCallback(char const* message, void* /*userData*/)
+/// `userData` is the StdWriters to output to, or nullptr for the singleton
+static void _diagnosticCallback(char const* message, void* userData)
 {
-    auto stdError = StdWriters::getError();
+    auto stdWriters = userData ? (StdWriters*)userData : StdWriters::getSingleton();
+    WriterHelper stdError(stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
     stdError.put(message);
     stdError.flush();
 }
 
-static SlangResult _compile(SlangCompileRequest* compileRequest, int argc, const char* const* argv)
+static SlangResult _compile(
+    SlangCompileRequest* compileRequest,
+    StdWriters* outputWriters,
+    int argc,
+    const char* const* argv)
 {
-    spSetDiagnosticCallback(compileRequest, &_diagnosticCallback, nullptr);
+    spSetDiagnosticCallback(compileRequest, &_diagnosticCallback, outputWriters);
+
+    // Output normally goes straight to the process stdout/stderr, but can be captured. Captured
+    // output mustn't go through the StdWriters singleton, as other compilations may be running.
+    if (outputWriters)
+    {
+        spSetWriter(
+            compileRequest,
+            SLANG_WRITER_CHANNEL_STD_OUTPUT,
+            outputWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT));
+        spSetWriter(
+            compileRequest,
+            SLANG_WRITER_CHANNEL_STD_ERROR,
+            outputWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
+    }
     spSetCommandLineCompilerMode(compileRequest);
 
     char const* appName = "slangc";
@@ -60,7 +84,10 @@ static SlangResult _compile(SlangCompileRequest* compileRequest, int argc, const
 #ifndef _DEBUG
     catch (const Exception& e)
     {
-        StdWriters::getOut().print("internal compiler error: %S\n", e.Message.toWString().begin());
+        WriterHelper stdOut(
+            outputWriters ? outputWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT)
+                          : StdWriters::getSingleton()->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT));
+        stdOut.print("internal compiler error: %S\n", e.Message.toWString().begin());
         res = SLANG_FAIL;
     }
 #endif
@@ -78,13 +105,28 @@ bool shouldEmbedPrelude(const char* const* argv, int argc)
     return false;
 }
 
-SLANG_TEST_TOOL_API SlangResult innerMain(
+static SlangResult _createGlobalSession(ComPtr<slang::IGlobalSession>& outSession)
+{
+    SlangGlobalSessionDesc desc = {};
+    desc.enableGLSL = true;
+    Slang::GlobalSessionInternalDesc internalDesc = {};
+#ifdef SLANG_BOOTSTRAP
+    internalDesc.isBootstrap = true;
+#endif
+    return slang_createGlobalSessionImpl(&desc, &internalDesc, outSession.writeRef());
+}
+
+static SlangResult _innerMain(
     StdWriters* stdWriters,
     slang::IGlobalSession* sharedSession,
+    bool captureOutput,
     int argc,
     const char* const* argv)
 {
-    StdWriters::setSingleton(stdWriters);
+    if (!captureOutput)
+    {
+        StdWriters::setSingleton(stdWriters);
+    }
 
     // Assume we will used the shared session
     ComPtr<slang::IGlobalSession> session(sharedSession);
@@ -101,14 +143,7 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
     else if (!session)
     {
         // Just create the global session in the regular way if there isn't one set
-        SlangGlobalSessionDesc desc = {};
-        desc.enableGLSL = true;
-        Slang::GlobalSessionInternalDesc internalDesc = {};
-#ifdef SLANG_BOOTSTRAP
-        internalDesc.isBootstrap = true;
-#endif
-        SLANG_RETURN_ON_FAIL(
-            slang_createGlobalSessionImpl(&desc, &internalDesc, session.writeRef()));
+        SLANG_RETURN_ON_FAIL(_createGlobalSession(session));
     }
 
     if (!shouldEmbedPrelude(argv, argc))
@@ -116,17 +151,105 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
 
     SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
     compileRequest->addSearchPath(Path::getParentDirectory(Path::getExecutablePath()).getBuffer());
-    SlangResult res = _compile(compileRequest, argc, argv);
+    SlangResult res =
+        _compile(compileRequest, captureOutput ? stdWriters : nullptr, argc, argv);
     // Now that we are done, clean up after ourselves
     spDestroyCompileRequest(compileRequest);
 
     return res;
 }
 
+SLANG_TEST_TOOL_API SlangResult innerMain(
+    StdWriters* stdWriters,
+    slang::IGlobalSession* sharedSession,
+    int argc,
+    const char* const* argv)
+{
+    return _innerMain(stdWriters, sharedSession, false, argc, argv);
+}
+
+/// Used by the daemon and batch compilation, where the output is captured
+static SlangResult _capturedInnerMain(
+    StdWriters* stdWriters,
+    slang::IGlobalSession* sharedSession,
+    int argc,
+    const char* const* argv)
+{
+    return _innerMain(stdWriters, sharedSession, true, argc, argv);
+}
+
+static SlangResult _main(int argc, char** argv)
+{
+    // `slangc -daemon <name>` serves compilations for other slangc invocations
+    // `slangc -daemon-quit <name>` stops it
+    if (argc >= 2)
+    {
+        const UnownedStringSlice option(argv[1]);
+        if (option == "-daemon" || option == "-daemon-quit")
+        {
+            if (argc != 3)
+            {
+                StdWriters::getError().print("error: expected '%s <name>'\n", argv[1]);
+                return SLANG_E_INVALID_ARG;
+            }
+            if (option == "-daemon-quit")
+            {
+                return CompileDaemon::quit(argv[2]);
+            }
+
+            ComPtr<slang::IGlobalSession> session;
+            SLANG_RETURN_ON_FAIL(_createGlobalSession(session));
+            return CompileDaemon::run(argv[2], session, &_capturedInnerMain, argv[0]);
+        }
+    }
+
+    // `slangc -batch <manifest> [-j <count>]` runs all the jobs in the manifest
+    if (argc >= 2 && UnownedStringSlice(argv[1]) == "-batch")
+    {
+        Index threadCount = 0;
+        bool validArgs = (argc == 3);
+        if (argc == 5 && UnownedStringSlice(argv[3]) == "-j")
+        {
+            Int value = 0;
+            validArgs = SLANG_SUCCEEDED(StringUtil::parseInt(UnownedStringSlice(argv[4]), value)) &&
+                        value >= 0;
+            threadCount = Index(value);
+        }
+        if (!validArgs)
+        {
+            StdWriters::getError().print("error: expected '-batch <manifest> [-j <count>]'\n");
+            return SLANG_E_INVALID_ARG;
+        }
+        return BatchCompile::run(
+            argv[2],
+            threadCount,
+            &_createGlobalSession,
+            &_capturedInnerMain,
+            argv[0],
+            StdWriters::getSingleton());
+    }
+
+    // If there is a daemon, let it do the work. If it can't be reached compile here.
+    StringBuilder daemonName;
+    if (SLANG_SUCCEEDED(PlatformUtil::getEnvironmentVariable(
+            UnownedStringSlice::fromLiteral("SLANGC_DAEMON"),
+            daemonName)) &&
+        daemonName.getLength())
+    {
+        SlangResult res = SLANG_OK;
+        if (SLANG_SUCCEEDED(CompileDaemon::forward(daemonName, argc, argv, res)))
+        {
+            return res;
+        }
+    }
+
+    return innerMain(StdWriters::getSingleton(), nullptr, argc, argv);
+}
+
 int MAIN(int argc, char** argv)
 {
     auto stdWriters = StdWriters::initDefaultSingleton();
-    SlangResult res = innerMain(stdWriters, nullptr, argc, argv);
+    SlangResult res = _main(argc, argv);
     slang::shutdown();
     return (int)TestToolUtil::getReturnCode(res);
 }
@@ -0,0 +1,218 @@
+// slang-compile-daemon.cpp
+#include "slang-compile-daemon.h"
+
+#include "../compiler-core/slang-compile-server-protocol.h"
+#include "../compiler-core/slang-json-rpc-connection.h"
+#include "../core/slang-io.h"
+#include "../core/slang-process.h"
+#include "../core/slang-std-writers.h"
+#include "../core/slang-writer.h"
+
+#if !SLANG_WINDOWS_FAMILY
+#include <signal.h>
+#endif
+
+namespace Slang
+{
+
+static SlangResult _createConnection(Stream* stream, RefPtr<JSONRPCConnection>& outConnection)
+{
+    RefPtr<BufferedReadStream> readStream(new BufferedReadStream(stream));
+    RefPtr<HTTPPacketConnection> packetConnection = new HTTPPacketConnection(readStream, stream);
+
+    RefPtr<JSONRPCConnection> connection(new JSONRPCConnection);
+    SLANG_RETURN_ON_FAIL(connection->init(packetConnection));
+    outConnection = connection;
+    return SLANG_OK;
+}
+
+namespace
+{ // anonymous
+
+struct DaemonServer
+{
+    SlangResult execute(const String& name);
+
+    SlangResult _executeSingle(JSONRPCConnection* connection);
+    SlangResult _compile(JSONRPCConnection* connection, const JSONRPCCall& call);
+
+    slang::IGlobalSession* m_session = nullptr;
+    CompileDaemon::InnerMainFunc m_func = nullptr;
+    String m_exePath;
+
+    bool m_quit = false;
+};
+
+} // namespace
+
+SlangResult DaemonServer::_compile(JSONRPCConnection* connection, const JSONRPCCall& call)
+{
+    using namespace CompileServerProtocol;
+
+    auto id = connection->getPersistentValue(call.id);
+
+    CompileArgs args;
+    SLANG_RETURN_ON_FAIL(connection->toNativeArgsOrSendError(call.params, &args, id));
+
+    StringBuilder stdOut;
+    StringBuilder stdError;
+
+    // Make writer/s act as if they are the console.
+    RefPtr<StringWriter> stdOutWriter(new StringWriter(&stdOut, WriterFlag::IsConsole));
+    RefPtr<StringWriter> stdErrorWriter(new StringWriter(&stdError, WriterFlag::IsConsole));
+
+    StdWriters stdWriters;
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_DIAGNOSTIC, stdErrorWriter);
+
+    CompileResult result;
+
+    // Relative paths on the command line are relative to the client. The compiler resolves them
+    // against its working directory, so the daemon's current directory is never changed.
+    List<const char*> toolArgs;
+    toolArgs.add(m_exePath.getBuffer());
+    toolArgs.add("-working-directory");
+    toolArgs.add(args.workingDirectory.getBuffer());
+    for (const auto& arg : args.args)
+    {
+        toolArgs.add(arg.getBuffer());
+    }
+
+    result.result = m_func(&stdWriters, m_session, int(toolArgs.getCount()), toolArgs.begin());
+
+    result.stdOut = stdOut;
+    result.stdError = stdError;
+    result.returnCode = int32_t(TestToolUtil::getReturnCode(result.result));
+    return connection->sendResult(&result, id);
+}
+
+SlangResult DaemonServer::_executeSingle(JSONRPCConnection* connection)
+{
+    // Block waiting for content (or error/closed)
+    SLANG_RETURN_ON_FAIL(connection->waitForResult());
+
+    // If we don't have a message, the client has gone
+    if (!connection->hasMessage())
+    {
+        return SLANG_OK;
+    }
+
+    if (connection->getMessageType() != JSONRPCMessageType::Call)
+    {
+        return connection->sendError(
+            JSONRPC::ErrorCode::InvalidRequest,
+            connection->getCurrentMessageId());
+    }
+
+    JSONRPCCall call;
+    SLANG_RETURN_ON_FAIL(connection->getRPCOrSendError(&call));
+
+    if (call.method == CompileServerProtocol::QuitArgs::g_methodName)
+    {
+        m_quit = true;
+        return SLANG_OK;
+    }
+    else if (call.method == CompileServerProtocol::CompileArgs::g_methodName)
+    {
+        return _compile(connection, call);
+    }
+    return connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
+}
+
+SlangResult DaemonServer::execute(const String& name)
+{
+#if !SLANG_WINDOWS_FAMILY
+    // A client that goes away mid response shouldn't take the daemon with it
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    RefPtr<LocalListener> listener;
+    SLANG_RETURN_ON_FAIL(LocalListener::create(name, listener));
+
+    while (!m_quit)
+    {
+        RefPtr<Stream> stream;
+        SLANG_RETURN_ON_FAIL(listener->accept(stream));
+
+        RefPtr<JSONRPCConnection> connection;
+        if (SLANG_FAILED(_createConnection(stream, connection)))
+        {
+            continue;
+        }
+
+        while (connection->isActive() && !m_quit)
+        {
+            // Failure doesn't make the execution terminate
+            [[maybe_unused]] const SlangResult res = _executeSingle(connection);
+        }
+    }
+
+    return SLANG_OK;
+}
+
+/* static */ SlangResult CompileDaemon::run(
+    const String& name,
+    slang::IGlobalSession* session,
+    InnerMainFunc func,
+    const char* exePath)
+{
+    DaemonServer server;
+    server.m_session = session;
+    server.m_func = func;
+    server.m_exePath = exePath;
+    return server.execute(name);
+}
+
+/* static */ SlangResult CompileDaemon::forward(
+    const String& name,
+    int argc,
+    const char* const* argv,
+    SlangResult& outResult)
+{
+    using namespace CompileServerProtocol;
+
+    RefPtr<Stream> stream;
+    SLANG_RETURN_ON_FAIL(LocalListener::connect(name, stream));
+
+    RefPtr<JSONRPCConnection> connection;
+    SLANG_RETURN_ON_FAIL(_createConnection(stream, connection));
+
+    CompileArgs args;
+    args.workingDirectory = Path::getCurrentPath();
+    for (int i = 1; i < argc; ++i)
+    {
+        args.args.add(argv[i]);
+    }
+
+    SLANG_RETURN_ON_FAIL(connection->sendCall(CompileArgs::g_methodName, &args));
+    SLANG_RETURN_ON_FAIL(connection->waitForResult());
+
+    if (!connection->hasMessage() ||
+        connection->getMessageType() != JSONRPCMessageType::Result)
+    {
+        return SLANG_FAIL;
+    }
+
+    CompileResult result;
+    SLANG_RETURN_ON_FAIL(connection->getMessage(&result));
+
+    StdWriters::getOut().write(result.stdOut.getBuffer(), result.stdOut.getLength());
+    StdWriters::getError().write(result.stdError.getBuffer(), result.stdError.getLength());
+    StdWriters::getSingleton()->flushWriters();
+
+    outResult = SlangResult(result.result);
+    return SLANG_OK;
+}
+
+/* static */ SlangResult CompileDaemon::quit(const String& name)
+{
+    RefPtr<Stream> stream;
+    SLANG_RETURN_ON_FAIL(LocalListener::connect(name, stream));
+
+    RefPtr<JSONRPCConnection> connection;
+    SLANG_RETURN_ON_FAIL(_createConnection(stream, connection));
+    return connection->sendCall(CompileServerProtocol::QuitArgs::g_methodName);
+}
+
+} // namespace Slang
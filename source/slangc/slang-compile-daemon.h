@@ -0,0 +1,52 @@
+// slang-compile-daemon.h
+#ifndef SLANG_COMPILE_DAEMON_H
+#define SLANG_COMPILE_DAEMON_H
+
+#include "../core/slang-test-tool-util.h"
+#include "slang.h"
+
+namespace Slang
+{
+
+/* Lets a resident slangc process serve compilations for other slangc invocations, so the cost of
+creating a global session and loading the core module is only paid once.
+
+The daemon is started with `slangc -daemon <name>`. When the `SLANGC_DAEMON` environment variable
+holds the same name, slangc forwards its command line and working directory to the daemon and
+replays the output and return code. If the daemon can't be reached slangc just compiles as usual.
+Relative paths on the command line are resolved against the forwarded working directory, with
+`-working-directory`, so the daemon never changes its own current directory.
+
+Only processes of the user that started the daemon can connect to it, so only they can request
+compilations or make it quit.
+
+Compilations are served one at a time, in the order clients connect. */
+struct CompileDaemon
+{
+    typedef TestToolUtil::InnerMainFunc InnerMainFunc;
+
+    /// Serve compilations on `name` until told to quit.
+    /// `func` performs a compilation using `session`, and must only write to the StdWriters it is
+    /// passed. `exePath` is passed to it as argv[0].
+    static SlangResult run(
+        const String& name,
+        slang::IGlobalSession* session,
+        InnerMainFunc func,
+        const char* exePath);
+
+    /// Compile via the daemon on `name`. Output is written to the StdWriters singleton.
+    /// Returns a failure if the daemon couldn't be reached or didn't respond, in which case
+    /// nothing will have been output. Otherwise `outResult` holds the result of the compilation.
+    static SlangResult forward(
+        const String& name,
+        int argc,
+        const char* const* argv,
+        SlangResult& outResult);
+
+    /// Make the daemon on `name` exit
+    static SlangResult quit(const String& name);
+};
+
+} // namespace Slang
+
+#endif
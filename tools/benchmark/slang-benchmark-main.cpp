@@ -0,0 +1,796 @@
+// slang-benchmark-main.cpp
+
+/* Benchmarks the compiler on a set of cases, writing the results as JSON so that they can be
+compared across commits.
+
+    slang-benchmark <manifest> [-o <results>] [-samples <count>]
+    slang-benchmark -compare <baseline-results> <results> [-threshold <percent>]
+
+The manifest lists the cases, each compiled for every one of its targets:
+
+    {
+        "cases": [
+            {
+                "name": "max-iters",
+                "files": ["../../tests/autodiff/max-iters.slang"],
+                "args": ["-stage", "compute", "-entry", "computeMain"],
+                "targets": ["spirv", "hlsl", "glsl", "metal"]
+            }
+        ]
+    }
+
+Files are relative to the directory holding the manifest, and args are passed to the compiler
+after the files, as they would be to slangc.
+
+For each case and target the results hold
+
+* the average wall clock time of a compile, and of each `SLANG_PROFILE` site hit during it
+* the peak memory used by the process compiling the case
+* the size of the output, and the number of instructions in it. For SPIR-V these are SPIR-V
+  instructions, and for source targets the number of statements.
+* the number of IR instructions after each major pass, from `-report-ir-inst-counts`
+
+Each case is compiled in a process of its own, so that the peak memory is that of the case
+alone.
+
+With -compare, each metric of the results is compared with that of the baseline, and any that
+has grown by more than the threshold (5% by default) is reported as a regression, in which case
+the tool fails.
+*/
+
+#include "../../source/compiler-core/slang-diagnostic-sink.h"
+#include "../../source/compiler-core/slang-json-lexer.h"
+#include "../../source/compiler-core/slang-json-native.h"
+#include "../../source/compiler-core/slang-json-parser.h"
+#include "../../source/compiler-core/slang-json-rpc.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-rtti-info.h"
+#include "../../source/core/slang-std-writers.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+#ifdef _WIN32
+// clang-format off
+// include ordering sensitive
+#include <windows.h>
+#include <psapi.h>
+// clang-format on
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Slang;
+
+namespace
+{ // anonymous
+
+struct BenchmarkCase
+{
+    String name;
+    List<String> files;   ///< Relative to the directory holding the manifest
+    List<String> args;    ///< Passed to the compiler after the files
+    List<String> targets; ///< The targets to compile the case for
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct BenchmarkManifest
+{
+    List<BenchmarkCase> cases;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+/// The time spent in a profiled function or section, averaged over the samples
+struct BenchmarkPhase
+{
+    String name;
+    double timeMs = 0;
+    double invocationCount = 0;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct BenchmarkPassInstCount
+{
+    String pass;
+    int64_t instCount = 0;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct BenchmarkResult
+{
+    String name;
+    String target;
+    int32_t sampleCount = 0;
+
+    double compileTimeMs = 0; ///< The average wall clock time of a compile
+    int64_t peakMemoryBytes = 0;
+    int64_t outputBytes = 0;
+    int64_t outputInstCount = 0; ///< SPIR-V instructions, or statements for source targets
+
+    List<BenchmarkPhase> phases;
+    List<BenchmarkPassInstCount> irInstCounts;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct BenchmarkResults
+{
+    List<BenchmarkResult> results;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+static const StructRttiInfo _makeBenchmarkCaseRtti()
+{
+    BenchmarkCase obj;
+    StructRttiBuilder builder(&obj, "BenchmarkCase", nullptr);
+    builder.addField("name", &obj.name);
+    builder.addField("files", &obj.files);
+    builder.addField("args", &obj.args, StructRttiInfo::Flag::Optional);
+    builder.addField("targets", &obj.targets);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchmarkCase::g_rttiInfo = _makeBenchmarkCaseRtti();
+
+static const StructRttiInfo _makeBenchmarkManifestRtti()
+{
+    BenchmarkManifest obj;
+    StructRttiBuilder builder(&obj, "BenchmarkManifest", nullptr);
+    builder.addField("cases", &obj.cases);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchmarkManifest::g_rttiInfo = _makeBenchmarkManifestRtti();
+
+static const StructRttiInfo _makeBenchmarkPhaseRtti()
+{
+    BenchmarkPhase obj;
+    StructRttiBuilder builder(&obj, "BenchmarkPhase", nullptr);
+    builder.addField("name", &obj.name);
+    builder.addField("timeMs", &obj.timeMs);
+    builder.addField("invocationCount", &obj.invocationCount);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchmarkPhase::g_rttiInfo = _makeBenchmarkPhaseRtti();
+
+static const StructRttiInfo _makeBenchmarkPassInstCountRtti()
+{
+    BenchmarkPassInstCount obj;
+    StructRttiBuilder builder(&obj, "BenchmarkPassInstCount", nullptr);
+    builder.addField("pass", &obj.pass);
+    builder.addField("instCount", &obj.instCount);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchmarkPassInstCount::g_rttiInfo =
+    _makeBenchmarkPassInstCountRtti();
+
+static const StructRttiInfo _makeBenchmarkResultRtti()
+{
+    BenchmarkResult obj;
+    StructRttiBuilder builder(&obj, "BenchmarkResult", nullptr);
+    builder.addField("name", &obj.name);
+    builder.addField("target", &obj.target);
+    builder.addField("sampleCount", &obj.sampleCount);
+    builder.addField("compileTimeMs", &obj.compileTimeMs);
+    builder.addField("peakMemoryBytes", &obj.peakMemoryBytes);
+    builder.addField("outputBytes", &obj.outputBytes);
+    builder.addField("outputInstCount", &obj.outputInstCount);
+    builder.addField("phases", &obj.phases, StructRttiInfo::Flag::Optional);
+    builder.addField("irInstCounts", &obj.irInstCounts, StructRttiInfo::Flag::Optional);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchmarkResult::g_rttiInfo = _makeBenchmarkResultRtti();
+
+static const StructRttiInfo _makeBenchmarkResultsRtti()
+{
+    BenchmarkResults obj;
+    StructRttiBuilder builder(&obj, "BenchmarkResults", nullptr);
+    builder.addField("results", &obj.results);
+    return builder.make();
+}
+/* static */ const StructRttiInfo BenchmarkResults::g_rttiInfo = _makeBenchmarkResultsRtti();
+
+} // namespace
+
+template<typename T>
+static SlangResult _parseJSON(const String& path, const String& contents, T& out)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, &JSONLexer::calcLexemeLocation);
+    sink.writer = StdWriters::getSingleton()->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR);
+
+    RefPtr<JSONContainer> container = new JSONContainer(&sourceManager);
+
+    SourceFile* sourceFile =
+        sourceManager.createSourceFileWithString(PathInfo::makePath(path), contents);
+    SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+    JSONLexer lexer;
+    lexer.init(sourceView, &sink);
+
+    JSONBuilder builder(container);
+
+    JSONParser parser;
+    SLANG_RETURN_ON_FAIL(parser.parse(&lexer, sourceView, &builder, &sink));
+
+    auto typeMap = JSONNativeUtil::getTypeFuncsMap();
+    JSONToNativeConverter converter(container, &typeMap, &sink);
+    if (SLANG_FAILED(converter.convert(builder.getRootValue(), &out)))
+    {
+        StdWriters::getError().print("error: unexpected contents in '%s'\n", path.getBuffer());
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+template<typename T>
+static SlangResult _readJSONFile(const String& path, T& out)
+{
+    String contents;
+    if (SLANG_FAILED(File::readAllText(path, contents)))
+    {
+        StdWriters::getError().print("error: unable to read '%s'\n", path.getBuffer());
+        return SLANG_E_NOT_FOUND;
+    }
+    return _parseJSON(path, contents, out);
+}
+
+template<typename T>
+static SlangResult _toJSON(const T& in, StringBuilder& out)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+    sink.writer = StdWriters::getSingleton()->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR);
+    return JSONRPCUtil::convertToJSON(&in, &sink, out);
+}
+
+/// Get the peak resident memory of this process, or 0 if it isn't known
+static int64_t _getPeakMemoryBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return int64_t(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if SLANG_APPLE_FAMILY
+    // Reported in bytes
+    return int64_t(usage.ru_maxrss);
+#else
+    // Reported in kilobytes
+    return int64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+static bool _isSourceTarget(const String& target)
+{
+    static const char* const sourceTargets[] = {"hlsl", "glsl", "metal", "wgsl", "cpp", "cuda"};
+    for (auto sourceTarget : sourceTargets)
+    {
+        if (target == sourceTarget)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _addOutput(ISlangBlob* blob, const String& target, BenchmarkResult& ioResult)
+{
+    const size_t size = blob->getBufferSize();
+    ioResult.outputBytes += int64_t(size);
+
+    if (target == "spirv")
+    {
+        // After the 5 word header, the high 16 bits of the first word of each instruction hold
+        // the number of words in it
+        const uint32_t* words = (const uint32_t*)blob->getBufferPointer();
+        const size_t wordCount = size / sizeof(uint32_t);
+        for (size_t i = 5; i < wordCount;)
+        {
+            const uint32_t instWordCount = words[i] >> 16;
+            if (instWordCount == 0)
+            {
+                break;
+            }
+            ioResult.outputInstCount++;
+            i += instWordCount;
+        }
+    }
+    else if (_isSourceTarget(target))
+    {
+        const char* text = (const char*)blob->getBufferPointer();
+        for (size_t i = 0; i < size; ++i)
+        {
+            ioResult.outputInstCount += int64_t(text[i] == ';');
+        }
+    }
+}
+
+/// Find the notes from -report-ir-inst-counts in diagnostics, and add them to ioResult.
+static void _addIRInstCounts(const UnownedStringSlice& diagnostics, BenchmarkResult& ioResult)
+{
+    const UnownedStringSlice prefix = toSlice("IR after '");
+    const UnownedStringSlice separator = toSlice("' has ");
+
+    Dictionary<String, Index> passCounts;
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(diagnostics, lines);
+    for (auto line : lines)
+    {
+        const Index prefixIndex = line.indexOf(prefix);
+        if (prefixIndex < 0)
+        {
+            continue;
+        }
+        UnownedStringSlice rest = line.tail(prefixIndex + prefix.getLength());
+        const Index separatorIndex = rest.indexOf(separator);
+        if (separatorIndex < 0)
+        {
+            continue;
+        }
+
+        const UnownedStringSlice countText = rest.tail(separatorIndex + separator.getLength());
+        Index pos = 0;
+        const int count = StringUtil::parseIntAndAdvancePos(countText, pos);
+        if (pos == 0)
+        {
+            continue;
+        }
+
+        // Some passes can be reached more than once, so number the repeats to keep each
+        // name unique
+        String pass = rest.head(separatorIndex);
+        Index& passCount = passCounts.getOrAddValue(pass, 0);
+        if (++passCount > 1)
+        {
+            pass = pass + " (" + String(int32_t(passCount)) + ")";
+        }
+
+        BenchmarkPassInstCount passInstCount;
+        passInstCount.pass = pass;
+        passInstCount.instCount = count;
+        ioResult.irInstCounts.add(passInstCount);
+    }
+}
+
+/// Compile a single case for target, and write the results to stdout
+static SlangResult _runCase(
+    const String& manifestPath,
+    Index caseIndex,
+    const String& target,
+    Index sampleCount)
+{
+    auto stdError = StdWriters::getError();
+
+    BenchmarkManifest manifest;
+    SLANG_RETURN_ON_FAIL(_readJSONFile(manifestPath, manifest));
+    if (caseIndex < 0 || caseIndex >= manifest.cases.getCount() || sampleCount <= 0)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    const auto& benchmarkCase = manifest.cases[caseIndex];
+
+    const String manifestDir = Path::getParentDirectory(manifestPath);
+    List<String> args;
+    for (const auto& file : benchmarkCase.files)
+    {
+        args.add(Path::combine(manifestDir, file));
+    }
+    args.addRange(benchmarkCase.args);
+    args.add("-target");
+    args.add(target);
+
+    List<const char*> argPtrs;
+    for (const auto& arg : args)
+    {
+        argPtrs.add(arg.getBuffer());
+    }
+    // Reporting the IR takes time of its own, so it's only done for the first compile
+    List<const char*> reportArgPtrs = argPtrs;
+    reportArgPtrs.add("-report-ir-inst-counts");
+
+    ComPtr<slang::IGlobalSession> session;
+    SLANG_RETURN_ON_FAIL(slang::createGlobalSession(session.writeRef()));
+
+    BenchmarkResult result;
+    result.name = benchmarkCase.name;
+    result.target = target;
+    result.sampleCount = int32_t(sampleCount);
+
+    // The first compile isn't timed, unless it is the only one
+    const Index timedCount = (sampleCount > 1) ? sampleCount - 1 : 1;
+
+    uint64_t totalTicks = 0;
+    ComPtr<ISlangProfiler> profiler;
+    for (Index i = 0; i < sampleCount; ++i)
+    {
+        const bool isFirst = (i == 0);
+        const bool isTimed = !isFirst || sampleCount == 1;
+        const auto& sampleArgPtrs = isFirst ? reportArgPtrs : argPtrs;
+
+        ComPtr<slang::ICompileRequest> request;
+        SLANG_RETURN_ON_FAIL(session->createCompileRequest(request.writeRef()));
+        SLANG_RETURN_ON_FAIL(request->processCommandLineArguments(
+            sampleArgPtrs.getBuffer(),
+            int(sampleArgPtrs.getCount())));
+
+        if (isTimed && i <= 1)
+        {
+            // Only count the profiled sites hit by the timed compiles
+            SLANG_RETURN_ON_FAIL(request->getCompileTimeProfile(profiler.writeRef(), true));
+        }
+
+        const uint64_t startTick = Process::getClockTick();
+        const SlangResult compileResult = request->compile();
+        const uint64_t endTick = Process::getClockTick();
+
+        if (isTimed)
+        {
+            totalTicks += endTick - startTick;
+        }
+
+        if (SLANG_FAILED(compileResult))
+        {
+            stdError.print(
+                "error: unable to compile '%s' for '%s'\n%s",
+                benchmarkCase.name.getBuffer(),
+                target.getBuffer(),
+                request->getDiagnosticOutput());
+            return compileResult;
+        }
+
+        if (isFirst)
+        {
+            _addIRInstCounts(UnownedStringSlice(request->getDiagnosticOutput()), result);
+
+            const auto entryPointCount =
+                spReflection_getEntryPointCount((SlangReflection*)request->getReflection());
+            for (SlangUInt j = 0; j < entryPointCount; ++j)
+            {
+                ComPtr<ISlangBlob> blob;
+                if (SLANG_SUCCEEDED(request->getEntryPointCodeBlob(int(j), 0, blob.writeRef())))
+                {
+                    _addOutput(blob, target, result);
+                }
+            }
+            if (entryPointCount == 0)
+            {
+                ComPtr<ISlangBlob> blob;
+                if (SLANG_SUCCEEDED(request->getTargetCodeBlob(0, blob.writeRef())))
+                {
+                    _addOutput(blob, target, result);
+                }
+            }
+        }
+
+        if (i == sampleCount - 1)
+        {
+            SLANG_RETURN_ON_FAIL(request->getCompileTimeProfile(profiler.writeRef(), false));
+        }
+    }
+
+    result.compileTimeMs =
+        double(totalTicks) * 1000.0 / double(Process::getClockFrequency()) / double(timedCount);
+
+    const uint32_t entryCount = uint32_t(profiler->getEntryCount());
+    for (uint32_t i = 0; i < entryCount; ++i)
+    {
+        BenchmarkPhase phase;
+        phase.name = profiler->getEntryName(i);
+        phase.timeMs = double(profiler->getEntryTimeMS(i)) / double(timedCount);
+        phase.invocationCount = double(profiler->getEntryInvocationTimes(i)) / double(timedCount);
+        result.phases.add(phase);
+    }
+
+    result.peakMemoryBytes = _getPeakMemoryBytes();
+
+    StringBuilder buf;
+    SLANG_RETURN_ON_FAIL(_toJSON(result, buf));
+    buf << "\n";
+
+    auto stdOut = StdWriters::getOut();
+    stdOut.write(buf.getBuffer(), buf.getLength());
+    stdOut.flush();
+    return SLANG_OK;
+}
+
+/// Run every case in the manifest, each in a process of its own, and write the results to
+/// outPath
+static SlangResult _runManifest(
+    const String& manifestPath,
+    const String& outPath,
+    Index sampleCount)
+{
+    auto stdOut = StdWriters::getOut();
+    auto stdError = StdWriters::getError();
+
+    BenchmarkManifest manifest;
+    SLANG_RETURN_ON_FAIL(_readJSONFile(manifestPath, manifest));
+
+    const String exePath = Path::getExecutablePath();
+
+    SlangResult res = SLANG_OK;
+    BenchmarkResults results;
+    for (Index caseIndex = 0; caseIndex < manifest.cases.getCount(); ++caseIndex)
+    {
+        const auto& benchmarkCase = manifest.cases[caseIndex];
+        for (const auto& target : benchmarkCase.targets)
+        {
+            CommandLine cmdLine;
+            cmdLine.setExecutableLocation(ExecutableLocation(exePath));
+            cmdLine.addArg("-run-case");
+            cmdLine.addArg(manifestPath);
+            cmdLine.addArg(String(int64_t(caseIndex)));
+            cmdLine.addArg(target);
+            cmdLine.addArg("-samples");
+            cmdLine.addArg(String(int64_t(sampleCount)));
+
+            ExecuteResult exeRes;
+            BenchmarkResult result;
+            if (SLANG_FAILED(ProcessUtil::execute(cmdLine, exeRes)) || exeRes.resultCode != 0 ||
+                SLANG_FAILED(_parseJSON(exePath, exeRes.standardOutput, result)))
+            {
+                stdError.print(
+                    "error: case '%s' failed for target '%s'\n%s",
+                    benchmarkCase.name.getBuffer(),
+                    target.getBuffer(),
+                    exeRes.standardError.getBuffer());
+                res = SLANG_FAIL;
+                continue;
+            }
+
+            stdOut.print(
+                "%s (%s): %.2f ms, %.1f MB peak, %d bytes, %d output instructions\n",
+                result.name.getBuffer(),
+                result.target.getBuffer(),
+                result.compileTimeMs,
+                double(result.peakMemoryBytes) / (1024.0 * 1024.0),
+                int(result.outputBytes),
+                int(result.outputInstCount));
+
+            results.results.add(result);
+        }
+    }
+
+    StringBuilder buf;
+    SLANG_RETURN_ON_FAIL(_toJSON(results, buf));
+    buf << "\n";
+    if (SLANG_FAILED(File::writeAllText(outPath, buf)))
+    {
+        stdError.print("error: unable to write '%s'\n", outPath.getBuffer());
+        return SLANG_FAIL;
+    }
+    return res;
+}
+
+namespace
+{ // anonymous
+
+struct RegressionChecker
+{
+    /// Compare a metric of a result with the baseline. Only changes are reported.
+    void check(const String& resultName, const char* metric, double baseline, double current)
+    {
+        if (baseline == current)
+        {
+            return;
+        }
+
+        // There's nothing to compare growth against when the baseline is zero
+        const double change = baseline > 0 ? (current - baseline) * 100.0 / baseline : 0.0;
+        const bool isRegression = change > threshold;
+        regressionCount += Index(isRegression);
+
+        StdWriters::getOut().print(
+            "%-32s %-40s %14.2f %14.2f %+8.1f%%%s\n",
+            resultName.getBuffer(),
+            metric,
+            baseline,
+            current,
+            change,
+            isRegression ? "  REGRESSION" : "");
+    }
+
+    double threshold = 5.0;
+    Index regressionCount = 0;
+};
+
+} // namespace
+
+static String _getResultName(const BenchmarkResult& result)
+{
+    return result.name + " (" + result.target + ")";
+}
+
+static SlangResult _compare(const String& baselinePath, const String& currentPath, double threshold)
+{
+    auto stdOut = StdWriters::getOut();
+
+    BenchmarkResults baselineResults;
+    BenchmarkResults currentResults;
+    SLANG_RETURN_ON_FAIL(_readJSONFile(baselinePath, baselineResults));
+    SLANG_RETURN_ON_FAIL(_readJSONFile(currentPath, currentResults));
+
+    Dictionary<String, const BenchmarkResult*> baselineByName;
+    for (const auto& result : baselineResults.results)
+    {
+        baselineByName[_getResultName(result)] = &result;
+    }
+
+    RegressionChecker checker;
+    checker.threshold = threshold;
+
+    stdOut.print("%-32s %-40s %14s %14s %9s\n", "case", "metric", "baseline", "current", "change");
+
+    HashSet<String> seenNames;
+    for (const auto& current : currentResults.results)
+    {
+        const String name = _getResultName(current);
+        seenNames.add(name);
+
+        const BenchmarkResult* baselinePtr = nullptr;
+        if (!baselineByName.tryGetValue(name, baselinePtr))
+        {
+            stdOut.print("%-32s not in baseline\n", name.getBuffer());
+            continue;
+        }
+        const BenchmarkResult& baseline = *baselinePtr;
+
+        checker.check(name, "compile time (ms)", baseline.compileTimeMs, current.compileTimeMs);
+        checker.check(
+            name,
+            "peak memory (bytes)",
+            double(baseline.peakMemoryBytes),
+            double(current.peakMemoryBytes));
+        checker.check(
+            name,
+            "output size (bytes)",
+            double(baseline.outputBytes),
+            double(current.outputBytes));
+        checker.check(
+            name,
+            "output instructions",
+            double(baseline.outputInstCount),
+            double(current.outputInstCount));
+
+        Dictionary<String, int64_t> baselineInstCounts;
+        for (const auto& passInstCount : baseline.irInstCounts)
+        {
+            baselineInstCounts[passInstCount.pass] = passInstCount.instCount;
+        }
+        for (const auto& passInstCount : current.irInstCounts)
+        {
+            int64_t baselineInstCount = 0;
+            if (baselineInstCounts.tryGetValue(passInstCount.pass, baselineInstCount))
+            {
+                const String metric = "IR after '" + passInstCount.pass + "'";
+                checker.check(
+                    name,
+                    metric.getBuffer(),
+                    double(baselineInstCount),
+                    double(passInstCount.instCount));
+            }
+        }
+    }
+
+    // A case that no longer produces results has most likely failed to compile
+    for (const auto& baseline : baselineResults.results)
+    {
+        const String name = _getResultName(baseline);
+        if (!seenNames.contains(name))
+        {
+            stdOut.print("%-32s missing from results  REGRESSION\n", name.getBuffer());
+            checker.regressionCount++;
+        }
+    }
+
+    if (checker.regressionCount)
+    {
+        stdOut.print(
+            "%d regression(s) beyond %g%%\n",
+            int(checker.regressionCount),
+            checker.threshold);
+        return SLANG_FAIL;
+    }
+    stdOut.print("no regressions beyond %g%%\n", checker.threshold);
+    return SLANG_OK;
+}
+
+static SlangResult _parseCount(const char* text, Index& outCount)
+{
+    Int value = 0;
+    SLANG_RETURN_ON_FAIL(StringUtil::parseInt(UnownedStringSlice(text), value));
+    outCount = Index(value);
+    return SLANG_OK;
+}
+
+SlangResult innerMain(int argc, char** argv)
+{
+    StdWriters::initDefaultSingleton();
+    auto stdError = StdWriters::getError();
+
+    List<String> positionalArgs;
+    String outPath = "slang-benchmark-results.json";
+    Index sampleCount = 5;
+    double threshold = 5.0;
+    bool isCompare = false;
+    bool isRunCase = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-compare")
+        {
+            isCompare = true;
+        }
+        else if (arg == "-run-case")
+        {
+            isRunCase = true;
+        }
+        else if (arg == "-o" && hasValue)
+        {
+            outPath = argv[++i];
+        }
+        else if (arg == "-samples" && hasValue)
+        {
+            SLANG_RETURN_ON_FAIL(_parseCount(argv[++i], sampleCount));
+        }
+        else if (arg == "-threshold" && hasValue)
+        {
+            threshold = atof(argv[++i]);
+        }
+        else if (arg.startsWith("-"))
+        {
+            stdError.print("error: unknown option '%s'\n", argv[i]);
+            return SLANG_E_INVALID_ARG;
+        }
+        else
+        {
+            positionalArgs.add(arg);
+        }
+    }
+
+    if (isCompare && positionalArgs.getCount() == 2)
+    {
+        return _compare(positionalArgs[0], positionalArgs[1], threshold);
+    }
+    if (isRunCase && positionalArgs.getCount() == 3)
+    {
+        Index caseIndex = 0;
+        SLANG_RETURN_ON_FAIL(_parseCount(positionalArgs[1].getBuffer(), caseIndex));
+        return _runCase(positionalArgs[0], caseIndex, positionalArgs[2], sampleCount);
+    }
+    if (!isCompare && !isRunCase && positionalArgs.getCount() == 1)
+    {
+        return _runManifest(positionalArgs[0], outPath, sampleCount);
+    }
+
+    stdError.print("usage: slang-benchmark <manifest> [-o <results>] [-samples <count>]\n"
+                   "       slang-benchmark -compare <baseline-results> <results> "
+                   "[-threshold <percent>]\n");
+    return SLANG_E_INVALID_ARG;
+}
+
+int main(int argc, char** argv)
+{
+    const SlangResult res = innerMain(argc, argv);
+    return SLANG_SUCCEEDED(res) ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+// unit-test-batch-compile.cpp
+
+#include "../../source/compiler-core/slang-batch-compile.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-std-writers.h"
+#include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-writer.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Slang;
+
+static const Index kJobCount = 8;
+
+// Jobs that fail, and the result they return
+static const Index kFirstFailingJob = 3;
+static const Index kSecondFailingJob = 6;
+
+// The job with a profiling option, which must run on its own
+static const Index kProfilingJob = 4;
+
+static slang::IGlobalSession* s_session = nullptr;
+
+static std::atomic<int> s_runningJobCount{0};
+static std::atomic<int> s_maxRunningJobCount{0};
+static std::atomic<bool> s_profilingJobRanAlone{false};
+
+static SlangResult _createSession(ComPtr<slang::IGlobalSession>& outSession)
+{
+    // The jobs don't compile anything, so they can all use the same session
+    outSession = s_session;
+    return SLANG_OK;
+}
+
+/// Stands in for slangc. The command line is `<exe> <job index> [-report-perf-benchmark]`
+static SlangResult _jobMain(
+    StdWriters* stdWriters,
+    slang::IGlobalSession* session,
+    int argc,
+    const char* const* argv)
+{
+    if (!session || argc < 2)
+    {
+        return SLANG_FAIL;
+    }
+
+    Int jobIndex = 0;
+    SLANG_RETURN_ON_FAIL(StringUtil::parseInt(UnownedStringSlice(argv[1]), jobIndex));
+
+    const int runningJobCount = ++s_runningJobCount;
+    int maxRunningJobCount = s_maxRunningJobCount.load();
+    while (runningJobCount > maxRunningJobCount &&
+           !s_maxRunningJobCount.compare_exchange_weak(maxRunningJobCount, runningJobCount))
+    {
+    }
+
+    // Earlier jobs take longer, so the jobs finish in a different order to the manifest
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * (kJobCount - jobIndex)));
+
+    if (argc > 2 && BatchCompile::isProfilingOption(UnownedStringSlice(argv[2])))
+    {
+        s_profilingJobRanAlone = (s_runningJobCount.load() == 1);
+    }
+    --s_runningJobCount;
+
+    WriterHelper(stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT))
+        .print("job %d\n", int(jobIndex));
+
+    if (jobIndex == kFirstFailingJob || jobIndex == kSecondFailingJob)
+    {
+        WriterHelper(stdWriters->getWriter(SLANG_WRITER_CHANNEL_DIAGNOSTIC))
+            .print("error: job %d failed\n", int(jobIndex));
+        return jobIndex == kFirstFailingJob ? SLANG_E_INVALID_ARG : SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+SLANG_UNIT_TEST(batchCompile)
+{
+    s_session = unitTestContext->slangGlobalSession;
+
+    StringBuilder manifest;
+    manifest << "{ \"jobs\": [\n";
+    for (Index i = 0; i < kJobCount; ++i)
+    {
+        manifest << "{ \"args\": [\"" << i << "\"";
+        if (i == kProfilingJob)
+        {
+            manifest << ", \"-report-perf-benchmark\"";
+        }
+        manifest << "] }" << (i + 1 < kJobCount ? ",\n" : "\n");
+    }
+    manifest << "] }\n";
+
+    String manifestPath;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-batch-compile"), manifestPath)));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(manifestPath, manifest)));
+
+    // The output is the same however many workers there are
+    for (Index threadCount : {1, 3, 8})
+    {
+        s_maxRunningJobCount = 0;
+        s_profilingJobRanAlone = false;
+
+        StringBuilder stdOut;
+        StringBuilder stdError;
+        RefPtr<StringWriter> stdOutWriter(new StringWriter(&stdOut, WriterFlag::IsConsole));
+        RefPtr<StringWriter> stdErrorWriter(new StringWriter(&stdError, WriterFlag::IsConsole));
+
+        StdWriters stdWriters;
+        stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+        stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+        stdWriters.setWriter(SLANG_WRITER_CHANNEL_DIAGNOSTIC, stdErrorWriter);
+
+        const SlangResult res = BatchCompile::run(
+            manifestPath,
+            threadCount,
+            &_createSession,
+            &_jobMain,
+            "slangc",
+            &stdWriters);
+
+        // The result is that of the first failing job in the manifest
+        SLANG_CHECK(res == SLANG_E_INVALID_ARG);
+
+        StringBuilder expectedOut;
+        for (Index i = 0; i < kJobCount; ++i)
+        {
+            expectedOut << "job " << i << "\n";
+        }
+        SLANG_CHECK(stdOut == expectedOut);
+
+        // Each job's diagnostics are kept with that job
+        StringBuilder expectedError;
+        expectedError << "error: job " << kFirstFailingJob << " failed\n";
+        expectedError << "error: job " << kSecondFailingJob << " failed\n";
+        SLANG_CHECK(stdError == expectedError);
+
+        SLANG_CHECK(s_maxRunningJobCount.load() <= int(threadCount));
+        SLANG_CHECK(s_profilingJobRanAlone.load());
+    }
+
+    File::remove(manifestPath);
+    s_session = nullptr;
+}
@@ -0,0 +1,161 @@
+// unit-test-capability-threads.cpp
+
+#include "../../tools/platform/performance-counter.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+#include <thread>
+
+using namespace Slang;
+
+// Uses many intrinsics with different capability requirements, so that checking it joins and
+// compares a lot of capability sets.
+static const char kCapabilitySource[] = R"(
+RWStructuredBuffer<uint> outputBuffer;
+groupshared uint sharedValues[64];
+
+uint waveTotal(uint value)
+{
+    return WaveActiveSum(value) + WavePrefixSum(value) + WaveReadLaneFirst(value);
+}
+
+uint bitTotal(uint value)
+{
+    return countbits(value) + firstbithigh(value) + firstbitlow(value) + reversebits(value);
+}
+
+float halfTotal(uint value)
+{
+    return f16tof32(value) + f16tof32(f32tof16(float(value)));
+}
+
+[shader("compute")]
+[numthreads(64, 1, 1)]
+void computeMain(uint3 tid : SV_DispatchThreadID, uint gi : SV_GroupIndex)
+{
+    sharedValues[gi] = tid.x;
+    GroupMemoryBarrierWithGroupSync();
+
+    uint value = sharedValues[63 - gi];
+    uint total = waveTotal(value) + bitTotal(value) + uint(halfTotal(value));
+    if (WaveIsFirstLane())
+        total += WaveActiveCountBits(value > 3);
+
+    uint previous;
+    InterlockedAdd(outputBuffer[0], total, previous);
+    InterlockedMax(outputBuffer[1], previous);
+    AllMemoryBarrierWithGroupSync();
+    outputBuffer[tid.x + 2] = total;
+}
+)";
+
+// Compile the source to SPIR-V in a global session of its own, and return the code and any
+// diagnostics.
+static SlangResult _compile(ComPtr<ISlangBlob>& outCode, String& outDiagnostics)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()));
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SPIRV;
+    targetDesc.profile = globalSession->findProfile("spirv_1_5");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "capabilities",
+        "capabilities.slang",
+        kCapabilitySource,
+        diagnosticBlob.writeRef());
+    if (diagnosticBlob)
+        outDiagnostics.append((const char*)diagnosticBlob->getBufferPointer());
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* componentTypes[2] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        componentTypes,
+        2,
+        composedProgram.writeRef(),
+        diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(
+        composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()));
+
+    diagnosticBlob.setNull();
+    const auto result =
+        linkedProgram->getEntryPointCode(0, 0, outCode.writeRef(), diagnosticBlob.writeRef());
+    if (diagnosticBlob)
+        outDiagnostics.append((const char*)diagnosticBlob->getBufferPointer());
+    return result;
+}
+
+static bool _isSameBlob(ISlangBlob* a, ISlangBlob* b)
+{
+    return a && b && a->getBufferSize() == b->getBufferSize() &&
+           memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+}
+
+// Capability sets are cached for the whole process, and checking them happens on every
+// compiling thread. Check that compiling on several threads at once gives the same results as
+// compiling on one, and record how long it takes.
+SLANG_UNIT_TEST(capabilityThreads)
+{
+    ComPtr<ISlangBlob> expectedCode;
+    String expectedDiagnostics;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compile(expectedCode, expectedDiagnostics)));
+
+    const Index kThreadCount = 4;
+    const Index kCompileCount = 4;
+
+    struct ThreadResult
+    {
+        bool matched = true;
+    };
+    ThreadResult results[kThreadCount];
+
+    auto start = platform::PerformanceCounter::now();
+
+    std::thread threads[kThreadCount];
+    for (Index i = 0; i < kThreadCount; ++i)
+    {
+        threads[i] = std::thread(
+            [&, i]()
+            {
+                for (Index j = 0; j < kCompileCount; ++j)
+                {
+                    ComPtr<ISlangBlob> code;
+                    String diagnostics;
+                    if (SLANG_FAILED(_compile(code, diagnostics)) ||
+                        !_isSameBlob(code, expectedCode) || diagnostics != expectedDiagnostics)
+                    {
+                        results[i].matched = false;
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto time = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+    getTestReporter()->addExecutionTime(time);
+
+    for (const auto& result : results)
+    {
+        SLANG_CHECK(result.matched);
+    }
+}
@@ -0,0 +1,176 @@
+// unit-test-module-interface-digest.cpp
+
+#include "core/slang-memory-file-system.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+static void _saveSource(ISlangMutableFileSystem* fileSystem, const char* path, const char* source)
+{
+    fileSystem->saveFile(path, source, strlen(source));
+}
+
+static bool _isUpToDate(
+    slang::IGlobalSession* globalSession,
+    const slang::SessionDesc& sessionDesc,
+    slang::IBlob* moduleBlob)
+{
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return false;
+    return session->isBinaryModuleUpToDate("user.slang", moduleBlob);
+}
+
+static SlangResult _serializeUserModule(
+    slang::IGlobalSession* globalSession,
+    const slang::SessionDesc& sessionDesc,
+    ComPtr<slang::IBlob>& outModuleBlob)
+{
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModule("user", diagnosticBlob.writeRef());
+    if (!module)
+        return SLANG_FAIL;
+    return module->serialize(outModuleBlob.writeRef());
+}
+
+// Check that a precompiled module only goes out of date when the interface of a module it
+// imports changes, rather than any change to the imported module's source.
+SLANG_UNIT_TEST(moduleInterfaceDigest)
+{
+    ComPtr<ISlangMutableFileSystem> memoryFileSystem =
+        ComPtr<ISlangMutableFileSystem>(new Slang::MemoryFileSystem());
+
+    _saveSource(memoryFileSystem, "lib.slang", R"(
+        module lib;
+        public int helper(int x) { return x + 1; }
+    )");
+    _saveSource(memoryFileSystem, "user.slang", R"(
+        module user;
+        import lib;
+        public int useHelper(int x) { return helper(x) * 2; }
+    )");
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SPIRV;
+    targetDesc.profile = globalSession->findProfile("spirv_1_5");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.fileSystem = memoryFileSystem;
+
+    ComPtr<slang::IBlob> moduleBlob;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(_serializeUserModule(globalSession, sessionDesc, moduleBlob)));
+
+    SLANG_CHECK(_isUpToDate(globalSession, sessionDesc, moduleBlob));
+
+    // Changing the body of an imported function doesn't change the interface
+    _saveSource(memoryFileSystem, "lib.slang", R"(
+        module lib;
+        public int helper(int x) { return x + 2; }
+    )");
+    SLANG_CHECK(_isUpToDate(globalSession, sessionDesc, moduleBlob));
+
+    // Changing its signature does
+    _saveSource(memoryFileSystem, "lib.slang", R"(
+        module lib;
+        public float helper(float x) { return x + 2; }
+    )");
+    SLANG_CHECK(!_isUpToDate(globalSession, sessionDesc, moduleBlob));
+
+    // As does changing the module's own source
+    _saveSource(memoryFileSystem, "lib.slang", R"(
+        module lib;
+        public int helper(int x) { return x + 1; }
+    )");
+    SLANG_CHECK(_isUpToDate(globalSession, sessionDesc, moduleBlob));
+    _saveSource(memoryFileSystem, "user.slang", R"(
+        module user;
+        import lib;
+        public int useHelper(int x) { return helper(x) * 3; }
+    )");
+    SLANG_CHECK(!_isUpToDate(globalSession, sessionDesc, moduleBlob));
+}
+
+// Importers lower the default values of the fields of imported structs into their own IR, so
+// changing a default must put them out of date.
+SLANG_UNIT_TEST(moduleInterfaceDigestFieldDefault)
+{
+    ComPtr<ISlangMutableFileSystem> memoryFileSystem =
+        ComPtr<ISlangMutableFileSystem>(new Slang::MemoryFileSystem());
+
+    _saveSource(memoryFileSystem, "lib.slang", R"(
+        module lib;
+        public struct Settings
+        {
+            public int count = 1;
+            public float scale = float(2);
+        }
+        public int helper(int x) { return x + 1; }
+    )");
+    _saveSource(memoryFileSystem, "user.slang", R"(
+        module user;
+        import lib;
+        public int useSettings() { Settings settings; return settings.count + helper(1); }
+    )");
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SPIRV;
+    targetDesc.profile = globalSession->findProfile("spirv_1_5");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.fileSystem = memoryFileSystem;
+
+    ComPtr<slang::IBlob> moduleBlob;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(_serializeUserModule(globalSession, sessionDesc, moduleBlob)));
+    SLANG_CHECK(_isUpToDate(globalSession, sessionDesc, moduleBlob));
+
+    // Changing the body of an imported function still doesn't change the interface
+    _saveSource(memoryFileSystem, "lib.slang", R"(
+        module lib;
+        public struct Settings
+        {
+            public int count = 1;
+            public float scale = float(2);
+        }
+        public int helper(int x) { return x + 2; }
+    )");
+    SLANG_CHECK(_isUpToDate(globalSession, sessionDesc, moduleBlob));
+
+    // Changing the default value of a field does
+    _saveSource(memoryFileSystem, "lib.slang", R"(
+        module lib;
+        public struct Settings
+        {
+            public int count = 2;
+            public float scale = float(2);
+        }
+        public int helper(int x) { return x + 2; }
+    )");
+    SLANG_CHECK(!_isUpToDate(globalSession, sessionDesc, moduleBlob));
+
+    // Including one that isn't a literal
+    _saveSource(memoryFileSystem, "lib.slang", R"(
+        module lib;
+        public struct Settings
+        {
+            public int count = 1;
+            public float scale = float(3);
+        }
+        public int helper(int x) { return x + 2; }
+    )");
+    SLANG_CHECK(!_isUpToDate(globalSession, sessionDesc, moduleBlob));
+}
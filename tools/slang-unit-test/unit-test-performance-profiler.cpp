@@ -0,0 +1,179 @@
+// unit-test-performance-profiler.cpp
+
+#include "../../source/core/slang-performance-profiler.h"
+#include "slang-com-ptr.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+static const FuncProfileSummary* _findSummary(
+    const List<FuncProfileSummary>& summaries,
+    const char* funcName)
+{
+    for (const auto& summary : summaries)
+    {
+        if (strcmp(summary.funcName, funcName) == 0)
+            return &summary;
+    }
+    return nullptr;
+}
+
+static void _profileSection(Index count)
+{
+    for (Index i = 0; i < count; ++i)
+    {
+        SLANG_PROFILE_SECTION(unitTestProfilerSection);
+    }
+}
+
+SLANG_UNIT_TEST(performanceProfiler)
+{
+    const char* funcName = "unitTestProfilerSection";
+
+    // Get the calling thread's profiler first, so it can't pick up the profiler of
+    // one of the threads below once that thread has exited.
+    auto threadProfiler = PerformanceProfiler::getProfiler();
+    auto allThreadsProfiler = PerformanceProfiler::getAllThreadsProfiler();
+    allThreadsProfiler->clear();
+
+    const Index kThreadCount = 4;
+    const Index kInvocationCount = 1000;
+
+    std::thread threads[kThreadCount];
+    for (auto& thread : threads)
+    {
+        thread = std::thread(_profileSection, kInvocationCount);
+    }
+    _profileSection(kInvocationCount);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // The calling thread only sees its own invocations
+    {
+        List<FuncProfileSummary> summaries;
+        threadProfiler->getSummaries(summaries);
+        auto summary = _findSummary(summaries, funcName);
+        SLANG_CHECK(summary && summary->invocationCount == uint64_t(kInvocationCount));
+    }
+
+    // Whilst all threads are combined, including threads that have since exited
+    {
+        List<FuncProfileSummary> summaries;
+        allThreadsProfiler->getSummaries(summaries);
+        auto summary = _findSummary(summaries, funcName);
+        SLANG_CHECK(
+            summary &&
+            summary->invocationCount == uint64_t(kInvocationCount * (kThreadCount + 1)));
+        if (summary)
+        {
+            SLANG_CHECK(summary->p50 <= summary->p95 && summary->p95 <= summary->p99);
+            SLANG_CHECK(summary->p99 <= summary->duration);
+        }
+
+        ComPtr<ISlangProfiler> profiler(new SlangProfiler(allThreadsProfiler));
+        bool found = false;
+        for (uint32_t i = 0; i < uint32_t(profiler->getEntryCount()); ++i)
+        {
+            if (strcmp(profiler->getEntryName(i), funcName) == 0)
+            {
+                found = true;
+                SLANG_CHECK(
+                    profiler->getEntryInvocationTimes(i) ==
+                    uint32_t(kInvocationCount * (kThreadCount + 1)));
+            }
+        }
+        SLANG_CHECK(found);
+    }
+
+    allThreadsProfiler->clear();
+    {
+        List<FuncProfileSummary> summaries;
+        allThreadsProfiler->getSummaries(summaries);
+        SLANG_CHECK(_findSummary(summaries, funcName) == nullptr);
+    }
+}
+
+namespace Slang
+{
+SLANG_PROFILE_HOT_SITE(unitTestProfilerHotSite);
+}
+
+static void _profileHotSite(Index count)
+{
+    for (Index i = 0; i < count; ++i)
+    {
+        SLANG_PROFILE_HOT(unitTestProfilerHotSite);
+    }
+}
+
+SLANG_UNIT_TEST(performanceProfilerHotSite)
+{
+    const char* funcName = "unitTestProfilerHotSite";
+    const Index kInvocationCount = 1000;
+
+    auto threadProfiler = PerformanceProfiler::getProfiler();
+    threadProfiler->clear();
+    const uint32_t prevSampleInterval = threadProfiler->getHotSiteSampleInterval();
+
+    // Nothing is recorded until hot sites are enabled
+    threadProfiler->setHotSiteSampleInterval(0);
+    _profileHotSite(kInvocationCount);
+    {
+        List<FuncProfileSummary> summaries;
+        threadProfiler->getSummaries(summaries);
+        SLANG_CHECK(_findSummary(summaries, funcName) == nullptr);
+    }
+
+    // When only some invocations are timed, all of them are still counted
+    threadProfiler->setHotSiteSampleInterval(16);
+    _profileHotSite(kInvocationCount);
+    {
+        List<FuncProfileSummary> summaries;
+        threadProfiler->getSummaries(summaries);
+        auto summary = _findSummary(summaries, funcName);
+        SLANG_CHECK(summary && summary->invocationCount == uint64_t(kInvocationCount));
+        if (summary)
+        {
+            SLANG_CHECK(summary->p50 <= summary->p95 && summary->p95 <= summary->p99);
+        }
+    }
+
+    threadProfiler->setHotSiteSampleInterval(1);
+    _profileHotSite(kInvocationCount);
+    {
+        List<FuncProfileSummary> summaries;
+        threadProfiler->getSummaries(summaries);
+        auto summary = _findSummary(summaries, funcName);
+        SLANG_CHECK(summary && summary->invocationCount == uint64_t(kInvocationCount * 2));
+    }
+
+    // The interval only applies to this thread, so another thread records nothing
+    {
+        PerformanceProfiler* otherProfiler = nullptr;
+        uint32_t otherSampleInterval = 0;
+        bool otherRecorded = false;
+        std::thread thread(
+            [&]()
+            {
+                otherProfiler = PerformanceProfiler::getProfiler();
+                otherProfiler->clear();
+                _profileHotSite(kInvocationCount);
+                otherSampleInterval = otherProfiler->getHotSiteSampleInterval();
+
+                List<FuncProfileSummary> summaries;
+                otherProfiler->getSummaries(summaries);
+                otherRecorded = _findSummary(summaries, funcName) != nullptr;
+            });
+        thread.join();
+        SLANG_CHECK(otherProfiler != threadProfiler);
+        SLANG_CHECK(otherSampleInterval == 0);
+        SLANG_CHECK(!otherRecorded);
+    }
+
+    threadProfiler->setHotSiteSampleInterval(prevSampleInterval);
+    threadProfiler->clear();
+}
@@ -7,6 +7,12 @@
 #include "../../source/core/slang-string-util.h"
 #include "unit-test/slang-unit-test.h"
 
+#include <thread>
+
+#if !SLANG_WINDOWS_FAMILY
+#include <sys/stat.h>
+#endif
+
 using namespace Slang;
 
 static SlangResult _createProcess(
@@ -197,3 +203,234 @@ SLANG_UNIT_TEST(CommandLineProcess)
     SLANG_CHECK(SLANG_SUCCEEDED(_reflectTest(unitTestContext)));
     SLANG_CHECK(SLANG_SUCCEEDED(_httpReflectTest(unitTestContext)));
 }
+
+// Reflects each packet received on the stream back, until the stream is closed
+static void _httpReflectServer(Stream* stream)
+{
+    RefPtr<HTTPPacketConnection> connection =
+        new HTTPPacketConnection(new BufferedReadStream(stream), stream);
+    while (connection->isActive())
+    {
+        if (SLANG_FAILED(connection->waitForResult()) || !connection->hasContent())
+        {
+            break;
+        }
+        auto content = connection->getContent();
+        connection->write(content.getBuffer(), size_t(content.getCount()));
+        connection->consumeContent();
+    }
+}
+
+static SlangResult _localListenerTest(const String& name)
+{
+    RefPtr<LocalListener> listener;
+    SLANG_RETURN_ON_FAIL(LocalListener::create(name, listener));
+
+#if !SLANG_WINDOWS_FAMILY
+    // Only the user that created the socket can connect to it
+    {
+        struct stat info;
+        SLANG_CHECK(::stat(name.getBuffer(), &info) == 0);
+        SLANG_CHECK((info.st_mode & (S_IRWXG | S_IRWXO)) == 0);
+    }
+#endif
+
+    // The server reflects each packet back to the client
+    SlangResult serverRes = SLANG_FAIL;
+    std::thread serverThread(
+        [&]()
+        {
+            RefPtr<Stream> stream;
+            serverRes = listener->accept(stream);
+            if (SLANG_FAILED(serverRes))
+            {
+                return;
+            }
+
+            _httpReflectServer(stream);
+        });
+
+    SlangResult clientRes = SLANG_OK;
+    {
+        RefPtr<Stream> stream;
+        clientRes = LocalListener::connect(name, stream);
+        if (SLANG_SUCCEEDED(clientRes))
+        {
+            RefPtr<HTTPPacketConnection> connection =
+                new HTTPPacketConnection(new BufferedReadStream(stream), stream);
+
+            for (Index i = 0; i < 10 && SLANG_SUCCEEDED(clientRes); ++i)
+            {
+                StringBuilder buf;
+                buf << "Hello " << i;
+
+                clientRes = connection->write(buf.getBuffer(), size_t(buf.getLength()));
+                if (SLANG_SUCCEEDED(clientRes))
+                {
+                    clientRes = connection->waitForResult();
+                }
+                if (SLANG_SUCCEEDED(clientRes) &&
+                    (!connection->hasContent() ||
+                     UnownedStringSlice(
+                         (const char*)connection->getContent().getBuffer(),
+                         connection->getContent().getCount()) != buf.getUnownedSlice()))
+                {
+                    clientRes = SLANG_FAIL;
+                }
+                if (connection->hasContent())
+                {
+                    connection->consumeContent();
+                }
+            }
+        }
+        // Closing the stream ends the server loop
+    }
+
+    serverThread.join();
+    SLANG_RETURN_ON_FAIL(serverRes);
+    SLANG_RETURN_ON_FAIL(clientRes);
+
+    // Writing to a peer that has gone away fails, rather than raising SIGPIPE and killing the
+    // writer
+    {
+        std::thread closingThread(
+            [&]()
+            {
+                RefPtr<Stream> stream;
+                serverRes = listener->accept(stream);
+            });
+
+        RefPtr<Stream> stream;
+        clientRes = LocalListener::connect(name, stream);
+        closingThread.join();
+        SLANG_RETURN_ON_FAIL(serverRes);
+        SLANG_RETURN_ON_FAIL(clientRes);
+
+        const char message[] = "Hello";
+        bool writeFailed = false;
+        for (Index i = 0; i < 4 && !writeFailed; ++i)
+        {
+            writeFailed = SLANG_FAILED(stream->write(message, sizeof(message)));
+        }
+        SLANG_CHECK(writeFailed);
+    }
+
+    // Only one process can listen on a name
+    {
+        RefPtr<LocalListener> otherListener;
+        SLANG_CHECK(SLANG_FAILED(LocalListener::create(name, otherListener)));
+    }
+
+    // Once the listener is gone, there is nothing to connect to
+    listener.setNull();
+    RefPtr<Stream> stream;
+    SLANG_CHECK(LocalListener::connect(name, stream) == SLANG_E_NOT_FOUND);
+    return SLANG_OK;
+}
+
+/// Runs `test` with a name for a local listener that no other process is using
+static void _runLocalListenerTest(SlangResult (*test)(const String& name))
+{
+#if SLANG_WINDOWS_FAMILY
+    // The name of a named pipe, which doesn't live in the file system
+    StringBuilder name;
+    name << "slang-unit-test-" << Process::getId();
+    SLANG_CHECK(SLANG_SUCCEEDED(test(name)));
+#else
+    // The name is the path of a unix domain socket. Make it in a directory of its own in the
+    // temporary directory, rather than in the working directory. The temporary file reserves a
+    // unique name for the directory.
+    String directory;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(File::generateTemporary(toSlice("slang-unit-test"), directory)));
+    File::remove(directory);
+    SLANG_CHECK_ABORT(Path::createDirectory(directory));
+
+    SLANG_CHECK(SLANG_SUCCEEDED(test(Path::combine(directory, "listener"))));
+
+    // The listener removes its socket, but remove anything a failed test left behind
+    Path::removeNonEmpty(directory);
+#endif
+}
+
+SLANG_UNIT_TEST(localListener)
+{
+    _runLocalListenerTest(&_localListenerTest);
+}
+
+static SlangResult _httpRoundTrip(HTTPPacketConnection* connection, const List<Byte>& packet)
+{
+    SLANG_RETURN_ON_FAIL(connection->write(packet.getBuffer(), size_t(packet.getCount())));
+    SLANG_RETURN_ON_FAIL(connection->waitForResult());
+    if (!connection->hasContent() || connection->getContent() != packet.getArrayView())
+    {
+        return SLANG_FAIL;
+    }
+    connection->consumeContent();
+    return SLANG_OK;
+}
+
+// Sends small and large packets there and back over a local connection, as used between
+// slangd/test-server and their clients.
+static SlangResult _httpRoundTripTest(const String& name)
+{
+    RefPtr<LocalListener> listener;
+    SLANG_RETURN_ON_FAIL(LocalListener::create(name, listener));
+
+    SlangResult serverRes = SLANG_FAIL;
+    std::thread serverThread(
+        [&]()
+        {
+            RefPtr<Stream> stream;
+            serverRes = listener->accept(stream);
+            if (SLANG_SUCCEEDED(serverRes))
+            {
+                _httpReflectServer(stream);
+            }
+        });
+
+    const Index smallCount = 100;
+    const Index largeCount = 4;
+    const Index largeSize = 256 * 1024;
+
+    SlangResult clientRes = SLANG_OK;
+    {
+        RefPtr<Stream> stream;
+        clientRes = LocalListener::connect(name, stream);
+        if (SLANG_SUCCEEDED(clientRes))
+        {
+            RefPtr<HTTPPacketConnection> connection =
+                new HTTPPacketConnection(new BufferedReadStream(stream), stream);
+            RefPtr<RandomGenerator> rand = RandomGenerator::create(10000);
+
+            List<Byte> packet;
+            packet.setCount(64);
+            rand->nextData(packet.getBuffer(), size_t(packet.getCount()));
+
+            for (Index i = 0; i < smallCount && SLANG_SUCCEEDED(clientRes); ++i)
+            {
+                clientRes = _httpRoundTrip(connection, packet);
+            }
+
+            // Larger than the pipe/socket buffers, so the packet is split over many reads
+            packet.setCount(largeSize);
+            rand->nextData(packet.getBuffer(), size_t(packet.getCount()));
+
+            for (Index i = 0; i < largeCount && SLANG_SUCCEEDED(clientRes); ++i)
+            {
+                clientRes = _httpRoundTrip(connection, packet);
+            }
+        }
+        // Closing the stream ends the server loop
+    }
+
+    serverThread.join();
+    SLANG_RETURN_ON_FAIL(serverRes);
+    SLANG_RETURN_ON_FAIL(clientRes);
+    return SLANG_OK;
+}
+
+SLANG_UNIT_TEST(httpRoundTrip)
+{
+    _runLocalListenerTest(&_httpRoundTripTest);
+}
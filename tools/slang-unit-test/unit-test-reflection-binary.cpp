@@ -0,0 +1,243 @@
+// unit-test-reflection-binary.cpp
+
+#include "../../source/compiler-core/slang-json-lexer.h"
+#include "../../source/compiler-core/slang-json-parser.h"
+#include "../../source/compiler-core/slang-json-value.h"
+#include "../../tools/platform/performance-counter.h"
+#include "slang-com-ptr.h"
+#include "slang-reflection-binary.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Check the binary reflection format matches the reflection API, and compare the time it takes to
+// query it against loading the JSON reflection.
+
+static SlangResult _parseJSON(
+    DiagnosticSink* sink,
+    const UnownedStringSlice& text,
+    JSONContainer* container,
+    JSONValue& outRoot)
+{
+    SourceManager* sourceManager = sink->getSourceManager();
+    SourceFile* sourceFile =
+        sourceManager->createSourceFileWithString(PathInfo::makeUnknown(), text);
+    SourceView* sourceView = sourceManager->createSourceView(sourceFile, nullptr, SourceLoc());
+
+    JSONLexer lexer;
+    lexer.init(sourceView, sink);
+
+    JSONBuilder builder(container);
+    JSONParser parser;
+    SLANG_RETURN_ON_FAIL(parser.parse(&lexer, sourceView, &builder, sink));
+    outRoot = builder.getRootValue();
+    return SLANG_OK;
+}
+
+/// Touch everything reachable in the view, so the comparison with JSON is fair
+static uint32_t _walk(const slang::BinaryReflectionView& view)
+{
+    uint32_t total = 0;
+    const auto& program = view.getProgram();
+    for (uint32_t i = 0; i < view.getCount(program.typeLayouts); ++i)
+    {
+        auto typeLayout = view.getElement(program.typeLayouts, i);
+        total += uint32_t(strlen(view.getString(typeLayout->name)));
+        total += view.getCount(typeLayout->fields) + view.getCount(typeLayout->bindingRanges);
+    }
+    for (uint32_t i = 0; i < view.getCount(program.parameters); ++i)
+    {
+        auto param = view.getElement(program.parameters, i);
+        total += uint32_t(strlen(view.getString(param->name)));
+        total += view.getCount(param->bindings);
+    }
+    return total;
+}
+
+SLANG_UNIT_TEST(reflectionBinary)
+{
+    const char* userSourceBody = R"(
+        struct Material
+        {
+            float4 color;
+            Texture2D albedo;
+            SamplerState sampler;
+        };
+
+        cbuffer PerFrame
+        {
+            float4x4 viewProj;
+            float time;
+        };
+
+        ConstantBuffer<Material> material;
+        RWStructuredBuffer<float4> output : register(u1);
+        Texture2D textures[4];
+
+        [shader("compute")]
+        [numthreads(8, 4, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID, uniform float scale)
+        {
+            output[tid.x] = material.color * time * scale +
+                material.albedo.SampleLevel(material.sampler, float2(0), 0) +
+                textures[tid.y].Load(int3(0)) + viewProj[0];
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK_ABORT(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    session->createCompositeComponentType(
+        components,
+        2,
+        compositeProgram.writeRef(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(compositeProgram != nullptr);
+
+    auto layout = compositeProgram->getLayout(0);
+    SLANG_CHECK_ABORT(layout != nullptr);
+
+    ComPtr<ISlangBlob> binaryBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(layout->toBinary(binaryBlob.writeRef())));
+    ComPtr<ISlangBlob> jsonBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(layout->toJson(jsonBlob.writeRef())));
+
+    slang::BinaryReflectionView view;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(view.init(binaryBlob->getBufferPointer(), binaryBlob->getBufferSize())));
+
+    const auto& program = view.getProgram();
+
+    // Global parameters match the reflection API
+    SLANG_CHECK(view.getCount(program.parameters) == layout->getParameterCount());
+    for (unsigned i = 0; i < layout->getParameterCount(); ++i)
+    {
+        auto param = layout->getParameterByIndex(i);
+        auto binaryParam = view.findParameter(param->getName());
+        SLANG_CHECK_ABORT(binaryParam != nullptr);
+
+        auto typeLayout = param->getTypeLayout();
+        for (unsigned j = 0; j < typeLayout->getCategoryCount(); ++j)
+        {
+            const auto category = SlangParameterCategory(typeLayout->getCategoryByIndex(j));
+            auto binding = view.findBinding(binaryParam, category);
+            SLANG_CHECK_ABORT(binding != nullptr);
+            SLANG_CHECK(binding->index == uint32_t(param->getOffset(category)));
+            SLANG_CHECK(binding->space == uint32_t(param->getBindingSpace(category)));
+        }
+
+        auto binaryTypeLayout = view.getTypeLayout(binaryParam->typeLayoutIndex);
+        SLANG_CHECK_ABORT(binaryTypeLayout != nullptr);
+        SLANG_CHECK(binaryTypeLayout->kind == uint32_t(typeLayout->getKind()));
+        SLANG_CHECK(
+            view.getCount(binaryTypeLayout->bindingRanges) ==
+            uint32_t(typeLayout->getBindingRangeCount()));
+    }
+
+    // The explicit register binding made it through
+    {
+        auto output = view.findParameter("output");
+        auto binding = view.findBinding(output, SLANG_PARAMETER_CATEGORY_UNORDERED_ACCESS);
+        SLANG_CHECK(binding && binding->index == 1);
+    }
+
+    // Fields can be found through the element type of a constant buffer
+    {
+        auto material = view.findParameter("material");
+        auto bufferTypeLayout = view.getTypeLayout(material ? material->typeLayoutIndex : ~0u);
+        SLANG_CHECK_ABORT(bufferTypeLayout != nullptr);
+        auto elementTypeLayout = view.getTypeLayout(bufferTypeLayout->elementTypeLayoutIndex);
+        SLANG_CHECK(view.findField(elementTypeLayout, "albedo") != nullptr);
+        SLANG_CHECK(view.findField(elementTypeLayout, "missing") == nullptr);
+    }
+
+    // Entry point
+    {
+        auto binaryEntryPoint = view.findEntryPoint("computeMain");
+        SLANG_CHECK_ABORT(binaryEntryPoint != nullptr);
+        SLANG_CHECK(binaryEntryPoint->stage == SLANG_STAGE_COMPUTE);
+        SLANG_CHECK(
+            binaryEntryPoint->threadGroupSize[0] == 8 &&
+            binaryEntryPoint->threadGroupSize[1] == 4 &&
+            binaryEntryPoint->threadGroupSize[2] == 1);
+        SLANG_CHECK(view.getCount(binaryEntryPoint->parameters) == 2);
+    }
+
+    // Corrupt data is rejected
+    {
+        List<uint8_t> data;
+        data.addRange(
+            (const uint8_t*)binaryBlob->getBufferPointer(),
+            Index(binaryBlob->getBufferSize()));
+
+        slang::BinaryReflectionView badView;
+        SLANG_CHECK(SLANG_FAILED(badView.init(data.getBuffer(), sizeof(uint32_t))));
+
+        ((slang::BinaryReflectionHeader*)data.getBuffer())->magic = 0;
+        SLANG_CHECK(SLANG_FAILED(badView.init(data.getBuffer(), size_t(data.getCount()))));
+    }
+
+    // Compare load times
+    {
+        const Index kIterationCount = 200;
+
+        SourceManager sourceManager;
+        sourceManager.initialize(nullptr, nullptr);
+        DiagnosticSink sink(&sourceManager, nullptr);
+
+        const UnownedStringSlice jsonText(
+            (const char*)jsonBlob->getBufferPointer(),
+            jsonBlob->getBufferSize());
+
+        auto start = platform::PerformanceCounter::now();
+        for (Index i = 0; i < kIterationCount; ++i)
+        {
+            RefPtr<JSONContainer> container = new JSONContainer(&sourceManager);
+            JSONValue root;
+            SLANG_CHECK(SLANG_SUCCEEDED(_parseJSON(&sink, jsonText, container, root)));
+        }
+        const auto jsonTime = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+
+        uint32_t total = 0;
+        start = platform::PerformanceCounter::now();
+        for (Index i = 0; i < kIterationCount; ++i)
+        {
+            slang::BinaryReflectionView loadedView;
+            SLANG_CHECK(SLANG_SUCCEEDED(
+                loadedView.init(binaryBlob->getBufferPointer(), binaryBlob->getBufferSize())));
+            total += _walk(loadedView);
+        }
+        const auto binaryTime = platform::PerformanceCounter::getElapsedTimeInSeconds(start);
+        SLANG_CHECK(total != 0);
+
+        StringBuilder buf;
+        buf << "reflection load x" << kIterationCount << ": json " << jsonBlob->getBufferSize()
+            << " bytes " << jsonTime * 1000.0 << "ms, binary " << binaryBlob->getBufferSize()
+            << " bytes " << binaryTime * 1000.0 << "ms\n";
+        getTestReporter()->message(TestMessageType::Info, buf.getBuffer());
+        getTestReporter()->addExecutionTime(jsonTime + binaryTime);
+    }
+}
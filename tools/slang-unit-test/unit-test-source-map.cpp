@@ -122,3 +122,54 @@ SLANG_UNIT_TEST(sourceMap)
 {
     SLANG_CHECK(SLANG_SUCCEEDED(_check()));
 }
+
+// The size of the chunks `SourceWriter` builds its output in
+static const Index kSourceWriterChunkSize = 256 * 1024;
+
+static bool _isSameLocation(const GeneratedLocationTracker& a, const GeneratedLocationTracker& b)
+{
+    return a.getLineIndex() == b.getLineIndex() && a.getColumnIndex() == b.getColumnIndex();
+}
+
+SLANG_UNIT_TEST(sourceMapGeneratedLocation)
+{
+    // Output where a CR/LF pair straddles the end of the first chunk
+    {
+        StringBuilder builder;
+        while (builder.getLength() < kSourceWriterChunkSize - 1)
+        {
+            builder << "int a;\n";
+        }
+        builder.reduceLength(kSourceWriterChunkSize - 1);
+        builder << "\r\nint b;";
+        const UnownedStringSlice text = builder.getUnownedSlice();
+
+        GeneratedLocationTracker whole;
+        whole.advance(text);
+
+        GeneratedLocationTracker chunked;
+        chunked.advance(text.head(kSourceWriterChunkSize));
+        chunked.advance(text.tail(kSourceWriterChunkSize));
+
+        SLANG_CHECK(_isSameLocation(whole, chunked));
+        SLANG_CHECK(chunked.getColumnIndex() == 6);
+    }
+
+    // Splitting anywhere gives the same location as seeing all of the text at once
+    {
+        const UnownedStringSlice text = UnownedStringSlice::fromLiteral("a\r\nb\n\rc\r\rd\n\nef");
+
+        GeneratedLocationTracker whole;
+        whole.advance(text);
+        SLANG_CHECK(whole.getLineIndex() == 6);
+        SLANG_CHECK(whole.getColumnIndex() == 2);
+
+        for (Index i = 0; i <= text.getLength(); ++i)
+        {
+            GeneratedLocationTracker split;
+            split.advance(text.head(i));
+            split.advance(text.tail(i));
+            SLANG_CHECK(_isSameLocation(whole, split));
+        }
+    }
+}
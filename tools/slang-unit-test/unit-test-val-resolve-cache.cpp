@@ -0,0 +1,147 @@
+// unit-test-val-resolve-cache.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Resolved vals are cached on the val, and reused in later epochs if they didn't depend on
+// anything that changes between epochs. Check that the same declarations resolve correctly when
+// checked by two linkages of one global session, and when new conformances (which change what
+// witness lookups find) are added after they were first resolved.
+
+static const char* kElementSource = R"(
+    public interface IElement
+    {
+        associatedtype Storage;
+    }
+
+    public struct IntElement : IElement
+    {
+        public typealias Storage = int;
+    }
+
+    public struct FloatElement : IElement
+    {
+        public typealias Storage = float;
+    }
+
+    public struct Holder<T : IElement>
+    {
+        public T.Storage value;
+        public vector<T.Storage, 2> pair;
+    }
+
+    public Holder<IntElement> intHolder;
+    public Holder<FloatElement> floatHolder;
+)";
+
+static const char* kExtraElementSource = R"(
+    import element;
+
+    public struct UIntElement : IElement
+    {
+        public typealias Storage = uint;
+    }
+
+    public Holder<UIntElement> uintHolder;
+    public Holder<IntElement> otherIntHolder;
+)";
+
+static ComPtr<slang::ISession> _createSession(slang::IGlobalSession* globalSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    globalSession->createSession(sessionDesc, session.writeRef());
+    return session;
+}
+
+/// True if the fields of the `Holder` type `typeName` in `module` have `scalarType` as their
+/// element type
+static bool _isHolderOf(
+    slang::IModule* module,
+    const char* typeName,
+    slang::TypeReflection::ScalarType scalarType)
+{
+    auto type = module->getLayout()->findTypeByName(typeName);
+    if (!type || type->getFieldCount() != 2)
+    {
+        return false;
+    }
+
+    auto valueType = type->getFieldByIndex(0)->getType();
+    auto pairType = type->getFieldByIndex(1)->getType();
+    return valueType->getKind() == slang::TypeReflection::Kind::Scalar &&
+           valueType->getScalarType() == scalarType &&
+           pairType->getKind() == slang::TypeReflection::Kind::Vector &&
+           pairType->getElementCount() == 2 &&
+           pairType->getElementType()->getScalarType() == scalarType;
+}
+
+SLANG_UNIT_TEST(valResolveCache)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    ComPtr<slang::IBlob> diagnostics;
+
+    // The same source in two linkages, both alive at the same time
+    ComPtr<slang::ISession> session0 = _createSession(globalSession);
+    ComPtr<slang::ISession> session1 = _createSession(globalSession);
+    SLANG_CHECK_ABORT(session0 && session1);
+
+    slang::IModule* module0 = session0->loadModuleFromSourceString(
+        "element",
+        "element.slang",
+        kElementSource,
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module0 != nullptr);
+    SLANG_CHECK(
+        _isHolderOf(module0, "Holder<IntElement>", slang::TypeReflection::ScalarType::Int32));
+
+    slang::IModule* module1 = session1->loadModuleFromSourceString(
+        "element",
+        "element.slang",
+        kElementSource,
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(module1 != nullptr);
+    SLANG_CHECK(
+        _isHolderOf(module1, "Holder<IntElement>", slang::TypeReflection::ScalarType::Int32));
+    SLANG_CHECK(
+        _isHolderOf(module1, "Holder<FloatElement>", slang::TypeReflection::ScalarType::Float32));
+
+    // Resolving again in the first linkage, after the second has resolved the same types
+    SLANG_CHECK(
+        _isHolderOf(module0, "Holder<FloatElement>", slang::TypeReflection::ScalarType::Float32));
+    SLANG_CHECK(
+        _isHolderOf(module0, "Holder<IntElement>", slang::TypeReflection::ScalarType::Int32));
+
+    // Destroying a linkage destroys the vals it owns, which the other must not use
+    module0 = nullptr;
+    session0.setNull();
+
+    // Checking a new conformance moves to a new epoch. Witness lookups made before it must be
+    // redone, whilst the types resolved earlier must still be correct.
+    slang::IModule* extraModule = session1->loadModuleFromSourceString(
+        "extra-element",
+        "extra-element.slang",
+        kExtraElementSource,
+        diagnostics.writeRef());
+    SLANG_CHECK_ABORT(extraModule != nullptr);
+    SLANG_CHECK(_isHolderOf(
+        extraModule,
+        "Holder<UIntElement>",
+        slang::TypeReflection::ScalarType::UInt32));
+    SLANG_CHECK(
+        _isHolderOf(extraModule, "Holder<IntElement>", slang::TypeReflection::ScalarType::Int32));
+    SLANG_CHECK(
+        _isHolderOf(module1, "Holder<IntElement>", slang::TypeReflection::ScalarType::Int32));
+    SLANG_CHECK(
+        _isHolderOf(module1, "Holder<FloatElement>", slang::TypeReflection::ScalarType::Float32));
+}